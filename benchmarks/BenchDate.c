@@ -0,0 +1,94 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "./../src/utils/date.h"
+#include "./../src/utils/validation.h"
+#include "./../src/utils/str.h"
+
+#define SAMPLES 4096
+#define ROUNDS 500
+
+/**
+ * Retorna o tempo atual em segundos
+ * 
+ * @return double
+ */
+double now(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * Conversão feita antes do parser de passagem única: a data é validada por isDate e depois recortada com strncpy e
+ * convertida campo a campo com parseInt
+ * 
+ * @param Datetime *datetime
+ * @param const char *date
+ * @param const char *time
+ * 
+ * @return bool
+ */
+bool legacyLoadDatetime(Datetime *datetime, const char *date, const char *time) {
+    char strYear[5] = "", strMonth[3] = "", strDay[3] = "", strHour[3] = "", strMinute[3] = "";
+    char dayStr[3], monthStr[3], yearStr[5];
+    int day, month, year;
+
+    if (strlen(date) != 10 || date[2] != '/' || date[5] != '/') return false;
+    strncpy(dayStr, date, 2);
+    dayStr[2] = '\0';
+    strncpy(monthStr, date + 3, 2);
+    monthStr[2] = '\0';
+    strncpy(yearStr, date + 6, 4);
+    yearStr[4] = '\0';
+    if (!parseInt(dayStr, &day) || !parseInt(monthStr, &month) || !parseInt(yearStr, &year)) return false;
+    if (!isDay(day, month, year) || !isMonth(month) || !isYear(year)) return false;
+
+    strncpy(strDay, date, 2);
+    strncpy(strMonth, date + 3, 2);
+    strncpy(strYear, date + 6, 4);
+    strncpy(strHour, time, 2);
+    strncpy(strMinute, time + 3, 2);
+
+    return parseInt(strYear, &datetime->year) && parseInt(strMonth, &datetime->month) && parseInt(strDay, &datetime->day)
+        && parseInt(strHour, &datetime->hour) && parseInt(strMinute, &datetime->minute);
+}
+
+/**
+ * Mede o custo de validar e converter datas e horários (dd/mm/aaaa e hh:mm) com o parser de passagem única,
+ * comparado à conversão anterior, que validava e convertia a data em duas passagens.
+ */
+int main(void) {
+    static char dates[SAMPLES][DATE_SIZE], times[SAMPLES][TIME_SIZE];
+    Datetime datetime;
+    long checksum = 0;
+
+    srand(42);
+    for (int i = 0; i < SAMPLES; i++) {
+        snprintf(dates[i], DATE_SIZE, "%02u/%02u/%04u", 1 + (unsigned) rand() % 28, 1 + (unsigned) rand() % 12, 1990 + (unsigned) rand() % 60);
+        snprintf(times[i], TIME_SIZE, "%02u:%02u", (unsigned) rand() % 24, (unsigned) rand() % 60);
+    }
+
+    double start = now();
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int i = 0; i < SAMPLES; i++) {
+            if (legacyLoadDatetime(&datetime, dates[i], times[i])) checksum += datetime.day + datetime.minute;
+        }
+    }
+    double legacy = now() - start;
+
+    start = now();
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int i = 0; i < SAMPLES; i++) {
+            if (loadDatetime(&datetime, dates[i], times[i])) checksum -= datetime.day + datetime.minute;
+        }
+    }
+    double singlePass = now() - start;
+
+    printf("---- Conversão de data e horário (%d conversões) ----\n", SAMPLES * ROUNDS);
+    printf("isDate + strncpy/parseInt: %.1f ns/conversão\n", legacy * 1e9 / (SAMPLES * ROUNDS));
+    printf("Passagem única:            %.1f ns/conversão\n", singlePass * 1e9 / (SAMPLES * ROUNDS));
+
+    return checksum == 0 ? 0 : 1;
+}
@@ -0,0 +1,95 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <time.h>
+#include "./../src/utils/storage.h"
+#include "./../src/utils/fuzzy.h"
+#include "./../src/modules/client/client.h"
+
+#define BENCH_FILE "bench_fuzzy.dat"
+#define PEOPLE 1000000
+#define REPETITIONS 10
+#define TARGET_MS 100
+
+/**
+ * Retorna o tempo atual em segundos
+ * 
+ * @return double
+ */
+double now(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void removeFiles(void) {
+    closeFiles();
+    remove(BENCH_FILE);
+    remove(BENCH_FILE STORAGE_FREE_LIST_SUFFIX);
+    remove(BENCH_FILE STORAGE_SLOT_INDEX_SUFFIX);
+}
+
+/**
+ * Mede a busca aproximada por nome em uma tabela de um milhão de pessoas, com uma thread e com todas as threads
+ * disponíveis. Cada consulta é repetida REPETITIONS vezes e o tempo médio é exibido, junto com se ele fica abaixo da
+ * meta de TARGET_MS ms por busca; a leitura dos nomes, feita uma única vez enquanto a tabela não muda, é medida à
+ * parte.
+ */
+int main(void) {
+    const char *firstNames[] = {
+        "João", "José", "Maria", "Ana", "Antônio", "Francisco", "Carlos", "Paulo", "Pedro", "Lucas", "Luíza", "Mariana",
+        "Gabriel", "Rafael", "Fernanda", "Patrícia", "Juliana", "Márcio", "Sérgio", "Cláudia", "Letícia", "Vitória"
+    };
+    const char *lastNames[] = {
+        "Silva", "Santos", "Oliveira", "Souza", "Rodrigues", "Ferreira", "Alves", "Pereira", "Lima", "Gomes", "Ribeiro",
+        "Carvalho", "Araújo", "Melo", "Barbosa", "Cardoso", "Conceição", "Rocha", "Dias", "Nascimento", "Andrade",
+        "Moreira", "Nunes", "Marques", "Machado", "Mendes", "Freitas", "Cavalcanti", "Monteiro", "Brandão", "Sebastião"
+    };
+    const char *queries[] = {"Sousa", "Joao", "Patricia Brandao", "Conseicao", "Fernanda Olivera Rocha", "xyz"};
+    int firstNumber = sizeof(firstNames) / sizeof(char*), lastNumber = sizeof(lastNames) / sizeof(char*);
+    int threadsNumbers[] = {1, getFuzzyThreadsNumber()}, configurationsNumber = threadsNumbers[1] > 1 ? 2 : 1;
+    FuzzyMatch matches[PERSON_SEARCH_MAX];
+
+    removeFiles();
+    setDurabilityMode(DURABILITY_NONE, 0, 0);
+
+    Client *clients = (Client*) calloc(PEOPLE, sizeof(Client));
+    if (clients == NULL) return 1;
+    for (int i = 0; i < PEOPLE; i++) {
+        clients[i].id = i + 1;
+        snprintf(clients[i].person.name, sizeof(clients[i].person.name), "%s %s %s", firstNames[i % firstNumber],
+            lastNames[(i / firstNumber) % lastNumber], lastNames[(i / 7) % lastNumber]);
+    }
+    bool status = saveFile(clients, sizeof(Client), PEOPLE, BENCH_FILE);
+    free(clients);
+    if (!status || !openFile(BENCH_FILE, sizeof(Client), offsetof(Client, id), offsetof(Client, isDeleted))) {
+        printf("Falha ao criar a tabela\n");
+        removeFiles();
+        return 1;
+    }
+
+    // A primeira busca normaliza os nomes da tabela, que ficam em memória para as buscas seguintes
+    double start = now();
+    searchFuzzy(BENCH_FILE, sizeof(Client), offsetof(Client, id), offsetof(Client, isDeleted), offsetof(Client, person.name),
+        queries[0], matches, PERSON_SEARCH_MAX, 1);
+    printf("---- Busca aproximada (%d pessoas) ----\n", PEOPLE);
+    printf("Leitura dos nomes: %.3f ms\n", (now() - start) * 1e3);
+    for (int t = 0; t < configurationsNumber; t++) {
+        printf("%d thread(s):\n", threadsNumbers[t]);
+        for (size_t q = 0; q < sizeof(queries) / sizeof(char*); q++) {
+            int found = 0;
+            start = now();
+            for (int repetition = 0; repetition < REPETITIONS; repetition++) {
+                found = searchFuzzy(BENCH_FILE, sizeof(Client), offsetof(Client, id), offsetof(Client, isDeleted),
+                    offsetof(Client, person.name), queries[q], matches, PERSON_SEARCH_MAX, threadsNumbers[t]);
+            }
+            double elapsed = (now() - start) * 1e3 / REPETITIONS;
+            printf("%-22s | %2d resultados (distância %d) | %.3f ms por busca | abaixo de %d ms: %s\n", queries[q], found,
+                found > 0 ? matches[0].distance : -1, elapsed, TARGET_MS, elapsed < TARGET_MS ? "sim" : "não");
+        }
+    }
+
+    removeFiles();
+    return 0;
+}
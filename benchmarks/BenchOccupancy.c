@@ -0,0 +1,63 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+#include "./../src/utils/occupancy.h"
+
+#define DAYS (3 * 365)
+#define FIRST_DAY 20000L
+#define REPETITIONS 20
+
+/**
+ * Retorna o tempo atual em segundos
+ * 
+ * @return double
+ */
+double now(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * Mede o custo de procurar um horário livre comum a um advogado, um cliente e um escritório em três anos de agenda.
+ * 
+ * Em todos os dias o advogado, o cliente e o escritório se alternam ocupando o expediente, de modo que nenhum horário
+ * de uma hora fica livre para os três e a busca precisa percorrer a janela inteira.
+ */
+int main(void) {
+    Occupancy lawyer = {NULL, 0, 0}, client = {NULL, 0, 0}, office = {NULL, 0, 0};
+    int starts[20], found = 0;
+
+    for (long day = FIRST_DAY; day < FIRST_DAY + DAYS; day++) {
+        long dayStart = day * 24 * 60;
+        for (int hour = 9; hour < 18; hour += 3) {
+            occupySlots(&lawyer, dayStart + hour * 60 + 30, dayStart + hour * 60 + 90);
+            occupySlots(&client, dayStart + hour * 60 + 90, dayStart + hour * 60 + 150);
+            occupySlots(&office, dayStart + hour * 60 + 150, dayStart + hour * 60 + 210);
+        }
+    }
+
+    double start = now();
+    for (int repetition = 0; repetition < REPETITIONS; repetition++) {
+        for (long day = FIRST_DAY; day < FIRST_DAY + DAYS; day++) {
+            uint64_t busy[OCCUPANCY_WORDS], full[OCCUPANCY_WORDS];
+
+            getFullSlots(&office, day, 1, busy);
+            getFullSlots(&lawyer, day, 1, full);
+            for (int i = 0; i < OCCUPANCY_WORDS; i++) busy[i] |= full[i];
+            getFullSlots(&client, day, 1, full);
+            for (int i = 0; i < OCCUPANCY_WORDS; i++) busy[i] |= full[i];
+
+            found += findFreeRuns(busy, 9 * 12, 18 * 12, 12, starts, 20);
+        }
+    }
+    double elapsed = (now() - start) / REPETITIONS;
+
+    printf("---- Busca de horário livre (%d dias, %d horários encontrados) ----\n", DAYS, found / REPETITIONS);
+    printf("%.3f ms por busca | %.3f us por dia\n", elapsed * 1e3, elapsed * 1e6 / DAYS);
+
+    freeOccupancy(&lawyer);
+    freeOccupancy(&client);
+    freeOccupancy(&office);
+    return 0;
+}
@@ -0,0 +1,61 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "./../src/utils/storage.h"
+#include "./../src/modules/client/client.h"
+
+#define BENCH_FILE "bench_clients.dat"
+#define BATCHES 10
+#define BATCH_SIZE 20000
+
+/**
+ * Retorna o tempo atual em segundos
+ * 
+ * @return double
+ */
+double now(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * Mede o custo médio de addElementToFile conforme a tabela cresce.
+ * 
+ * Cada lote insere BATCH_SIZE clientes e imprime o custo médio por inserção. Com a inserção em modo append,
+ * o custo deve permanecer constante entre o primeiro e o último lote.
+ */
+int main(void) {
+    Client client;
+    memset(&client, 0, sizeof(Client));
+    strcpy(client.person.name, "Cliente Benchmark");
+    strcpy(client.person.cpf, "12345678909");
+    strcpy(client.person.email, "cliente@bench.com");
+    strcpy(client.person.telephone, "84 91234-5678");
+
+    closeFiles();
+    remove(BENCH_FILE);
+
+    // O fsync por operação dominaria a medição; aqui interessa o custo de I/O conforme a tabela cresce
+    setDurabilityMode(DURABILITY_NONE, 0, 0);
+
+    printf("---- addElementToFile (%d inserções por lote) ----\n", BATCH_SIZE);
+    for (int batch = 0; batch < BATCHES; batch++) {
+        double start = now();
+        for (int i = 0; i < BATCH_SIZE; i++) {
+            if (!addElementToFile(&client, sizeof(Client), BENCH_FILE)) {
+                printf("Falha ao inserir registro\n");
+                closeFiles();
+                remove(BENCH_FILE);
+                return 1;
+            }
+        }
+        double elapsed = now() - start;
+        printf("Registros: %7d | %.3f us/inserção\n", (batch + 1) * BATCH_SIZE, elapsed * 1e6 / BATCH_SIZE);
+    }
+
+    closeFiles();
+    remove(BENCH_FILE);
+    return 0;
+}
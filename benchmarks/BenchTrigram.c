@@ -0,0 +1,102 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <time.h>
+#include "./../src/utils/storage.h"
+#include "./../src/utils/bptree.h"
+#include "./../src/utils/trigram.h"
+#include "./../src/modules/client/client.h"
+
+#define BENCH_FILE "bench_names.dat"
+#define BENCH_INDEX "bench_names.idx"
+#define PEOPLE 1000000
+#define REPETITIONS 20
+
+/**
+ * Retorna o tempo atual em segundos
+ * 
+ * @return double
+ */
+double now(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * Monta as chaves do nome de um cliente
+ */
+static int getNameKeys(const void *element, BPlusKey *keys) {
+    const Client *client = (const Client*) element;
+    return getTrigramKeys(client->person.name, client->id, keys);
+}
+
+static void removeFiles(void) {
+    closeFiles();
+    remove(BENCH_FILE);
+    remove(BENCH_FILE STORAGE_FREE_LIST_SUFFIX);
+    remove(BENCH_FILE STORAGE_SLOT_INDEX_SUFFIX);
+    remove(BENCH_INDEX);
+}
+
+/**
+ * Mede a busca por parte do nome em uma tabela de um milhão de pessoas.
+ * 
+ * Os nomes combinam listas de prenomes e sobrenomes comuns, de modo que trigramas frequentes (como os de "silva")
+ * aparecem em centenas de milhares de registros. Cada consulta é repetida REPETITIONS vezes e o tempo médio é exibido.
+ */
+int main(void) {
+    const char *firstNames[] = {
+        "João", "José", "Maria", "Ana", "Antônio", "Francisco", "Carlos", "Paulo", "Pedro", "Lucas", "Luíza", "Mariana",
+        "Gabriel", "Rafael", "Fernanda", "Patrícia", "Juliana", "Márcio", "Sérgio", "Cláudia", "Letícia", "Vitória"
+    };
+    const char *lastNames[] = {
+        "Silva", "Santos", "Oliveira", "Souza", "Rodrigues", "Ferreira", "Alves", "Pereira", "Lima", "Gomes", "Ribeiro",
+        "Carvalho", "Araújo", "Melo", "Barbosa", "Cardoso", "Conceição", "Rocha", "Dias", "Nascimento", "Andrade",
+        "Moreira", "Nunes", "Marques", "Machado", "Mendes", "Freitas", "Cavalcanti", "Monteiro", "Brandão", "Sebastião"
+    };
+    const char *queries[] = {"silva", "mari", "jo", "conceicao", "patricia brandao", "ana melo rocha", "xyz"};
+    int firstNumber = sizeof(firstNames) / sizeof(char*), lastNumber = sizeof(lastNames) / sizeof(char*), ids[10];
+
+    removeFiles();
+    setDurabilityMode(DURABILITY_NONE, 0, 0);
+
+    Client *clients = (Client*) calloc(PEOPLE, sizeof(Client));
+    if (clients == NULL) return 1;
+    for (int i = 0; i < PEOPLE; i++) {
+        clients[i].id = i + 1;
+        snprintf(clients[i].person.name, sizeof(clients[i].person.name), "%s %s %s %d", firstNames[i % firstNumber],
+            lastNames[(i / firstNumber) % lastNumber], lastNames[(i / 7) % lastNumber], i);
+    }
+    bool status = saveFile(clients, sizeof(Client), PEOPLE, BENCH_FILE);
+    free(clients);
+    if (!status || !openFile(BENCH_FILE, sizeof(Client), offsetof(Client, id), offsetof(Client, isDeleted))) {
+        printf("Falha ao criar a tabela\n");
+        removeFiles();
+        return 1;
+    }
+
+    double start = now();
+    if (!openMultiKeyBPlusTree(BENCH_INDEX, BENCH_FILE, sizeof(Client), getNameKeys, TRIGRAM_MAX_KEYS)) {
+        printf("Falha ao criar o índice\n");
+        removeFiles();
+        return 1;
+    }
+    printf("---- Índice de trigramas (%d pessoas) ----\n", PEOPLE);
+    printf("Criação do índice: %.3f s\n", now() - start);
+
+    for (size_t q = 0; q < sizeof(queries) / sizeof(char*); q++) {
+        int found = 0;
+        bool isTruncated = false;
+        start = now();
+        for (int repetition = 0; repetition < REPETITIONS; repetition++) {
+            found = searchTrigramIndex(BENCH_INDEX, BENCH_FILE, sizeof(Client), offsetof(Client, person.name), queries[q], ids, 10, &isTruncated);
+        }
+        printf("%-18s | %2d resultados%s | %.3f ms por busca\n", queries[q], found, isTruncated ? " (truncada)" : "",
+            (now() - start) * 1e3 / REPETITIONS);
+    }
+
+    removeFiles();
+    return 0;
+}
@@ -2,11 +2,17 @@
 #include <stdbool.h>
 #include <string.h>
 #include <stdlib.h>
+#include <stddef.h>
+#include <limits.h>
 #include "./../../utils/interfaces.h"
 #include "./../../utils/validation.h"
 #include "./../../utils/storage.h"
 #include "./../../utils/date.h"
+#include "./../../utils/calendar.h"
 #include "./../../utils/str.h"
+#include "./../../utils/intervaltree.h"
+#include "./../../utils/occupancy.h"
+#include "./../../utils/bptree.h"
 #include "./appointment.h"
 #include "./../client/client.h"
 #include "./../lawyer/lawyer.h"
@@ -20,6 +26,619 @@
 
 #endif
 
+/**
+ * Layout dos agendamentos até a versão em que as datas passaram a ser armazenadas em minutos, com cada data repetida
+ * em três textos. Usado apenas para converter arquivos antigos.
+ */
+typedef struct LegacyDatetime {
+    int day;
+    int month;
+    int year;
+    int hour;
+    int minute;
+    char date[18];
+    char onlyDate[11];
+    char time[6];
+} LegacyDatetime;
+
+typedef struct LegacyAppointment {
+    int id;
+    int clientId;
+    int lawyerId;
+    int officeId;
+    LegacyDatetime startDate;
+    LegacyDatetime endDate;
+    bool isDeleted;
+} LegacyAppointment;
+
+/**
+ * Alterações feitas nos agendamentos e nas séries de um cadastro durante a sua exclusão: os originais e, em uma
+ * transferência, os agendamentos com o novo cadastro e quantos deles (e das séries) já estão nas agendas em memória
+ */
+typedef struct ReferenceChanges {
+    bool isReassignment;
+    Appointment *appointments;
+    Appointment *moved;
+    int appointmentsNumber;
+    int appointmentsMoved;
+    AppointmentSeries *series;
+    int seriesNumber;
+    int seriesMoved;
+} ReferenceChanges;
+
+/**
+ * Agendas dos advogados, indexadas pelo código do advogado. Cada agenda é uma árvore de intervalos com os horários dos
+ * agendamentos ativos, montada ao abrir a tabela e atualizada a cada cadastro, edição ou exclusão.
+ */
+static IntervalTree *lawyerSchedules = NULL;
+static int lawyerSchedulesNumber = 0;
+
+/**
+ * Ocupação das salas de cada escritório, indexada pelo código do escritório, e número de salas por escritório
+ */
+static Occupancy *officeOccupancies = NULL;
+static int officeOccupanciesNumber = 0;
+static int roomCapacity = OFFICE_ROOM_CAPACITY;
+
+/**
+ * Ocupação de cada advogado e de cada cliente, em faixas de horário, usada na busca por horários livres
+ */
+static Occupancy *lawyerOccupancies = NULL;
+static int lawyerOccupanciesNumber = 0;
+static Occupancy *clientOccupancies = NULL;
+static int clientOccupanciesNumber = 0;
+
+/**
+ * Séries de agendamentos ativas, carregadas ao abrir a tabela. Apenas as regras ficam em memória: as sessões de cada
+ * série são calculadas para o período consultado.
+ */
+static AppointmentSeries *seriesList = NULL;
+static int seriesNumber = 0;
+static int seriesCapacity = 0;
+
+/**
+ * Indica que uma gravação já confirmada não pôde ser aplicada às agendas, às ocupações ou às séries em memória, que
+ * então são remontadas a partir das tabelas antes da próxima consulta
+ */
+static bool isScheduleStale = false;
+
+/**
+ * Retorna a agenda de um advogado, aumentando o vetor de agendas se necessário
+ * 
+ * @param int lawyerId
+ * 
+ * @return IntervalTree*|NULL: Agenda do advogado | NULL, se não houver memória disponível
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static IntervalTree* getLawyerSchedule(int lawyerId) {
+    if (lawyerId < 0) return NULL;
+
+    if (lawyerId >= lawyerSchedulesNumber) {
+        int schedulesNumber = lawyerSchedulesNumber > 0 ? lawyerSchedulesNumber : 16;
+        while (schedulesNumber <= lawyerId) schedulesNumber *= 2;
+
+        IntervalTree *schedules = (IntervalTree*) realloc(lawyerSchedules, schedulesNumber * sizeof(IntervalTree));
+        if (schedules == NULL) return NULL;
+
+        memset(schedules + lawyerSchedulesNumber, 0, (schedulesNumber - lawyerSchedulesNumber) * sizeof(IntervalTree));
+        lawyerSchedules = schedules;
+        lawyerSchedulesNumber = schedulesNumber;
+    }
+
+    return &lawyerSchedules[lawyerId];
+}
+
+/**
+ * Retorna a ocupação de um advogado, cliente ou escritório, aumentando o vetor de ocupações se necessário
+ * 
+ * @param Occupancy **occupancies: Vetor de ocupações, indexado pelo código
+ * @param int *occupanciesNumber: Tamanho do vetor
+ * @param int id: Código do advogado, cliente ou escritório
+ * 
+ * @return Occupancy*|NULL: Ocupação correspondente ao código | NULL, se não houver memória disponível
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static Occupancy* getOccupancy(Occupancy **occupancies, int *occupanciesNumber, int id) {
+    if (id < 0) return NULL;
+
+    if (id >= *occupanciesNumber) {
+        int newNumber = *occupanciesNumber > 0 ? *occupanciesNumber : 16;
+        while (newNumber <= id) newNumber *= 2;
+
+        Occupancy *newOccupancies = (Occupancy*) realloc(*occupancies, newNumber * sizeof(Occupancy));
+        if (newOccupancies == NULL) return NULL;
+
+        memset(newOccupancies + *occupanciesNumber, 0, (newNumber - *occupanciesNumber) * sizeof(Occupancy));
+        *occupancies = newOccupancies;
+        *occupanciesNumber = newNumber;
+    }
+
+    return &(*occupancies)[id];
+}
+
+/**
+ * Libera um vetor de ocupações
+ * 
+ * @param Occupancy **occupancies
+ * @param int *occupanciesNumber
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static void freeOccupancies(Occupancy **occupancies, int *occupanciesNumber) {
+    for (int i = 0; i < *occupanciesNumber; i++) freeOccupancy(&(*occupancies)[i]);
+    free(*occupancies);
+    *occupancies = NULL;
+    *occupanciesNumber = 0;
+}
+
+/**
+ * Retira o horário de um agendamento da agenda do seu advogado e da ocupação do advogado, do cliente e do escritório
+ * 
+ * @param int id: ID do agendamento
+ * @param const Appointment *appointment
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static void unscheduleAppointment(int id, const Appointment *appointment) {
+    long start = appointment->startDate, end = appointment->endDate;
+
+    if (appointment->lawyerId >= 0 && appointment->lawyerId < lawyerSchedulesNumber) {
+        removeInterval(&lawyerSchedules[appointment->lawyerId], start, id);
+    }
+    if (appointment->officeId >= 0 && appointment->officeId < officeOccupanciesNumber) {
+        releaseSlots(&officeOccupancies[appointment->officeId], start, end);
+    }
+    if (appointment->lawyerId >= 0 && appointment->lawyerId < lawyerOccupanciesNumber) {
+        releaseSlots(&lawyerOccupancies[appointment->lawyerId], start, end);
+    }
+    if (appointment->clientId >= 0 && appointment->clientId < clientOccupanciesNumber) {
+        releaseSlots(&clientOccupancies[appointment->clientId], start, end);
+    }
+}
+
+/**
+ * Coloca o horário de um agendamento na agenda do seu advogado e na ocupação do advogado, do cliente e do escritório
+ * 
+ * @param int id: ID do agendamento
+ * @param const Appointment *appointment
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static bool scheduleAppointment(int id, const Appointment *appointment) {
+    IntervalTree *schedule = getLawyerSchedule(appointment->lawyerId);
+    Occupancy *office = getOccupancy(&officeOccupancies, &officeOccupanciesNumber, appointment->officeId),
+        *lawyer = getOccupancy(&lawyerOccupancies, &lawyerOccupanciesNumber, appointment->lawyerId),
+        *client = getOccupancy(&clientOccupancies, &clientOccupanciesNumber, appointment->clientId);
+    if (schedule == NULL || office == NULL || lawyer == NULL || client == NULL) return false;
+
+    long start = appointment->startDate, end = appointment->endDate;
+    if (!insertInterval(schedule, start, end, id)) return false;
+    if (occupySlots(office, start, end)) {
+        if (occupySlots(lawyer, start, end)) {
+            if (occupySlots(client, start, end)) return true;
+            releaseSlots(lawyer, start, end);
+        }
+        releaseSlots(office, start, end);
+    }
+    removeInterval(schedule, start, id);
+
+    return false;
+}
+
+/**
+ * Monta a chave de um agendamento no índice de agenda dos clientes: o código do cliente, o início e o ID
+ * 
+ * @param const void *element: Appointment
+ * @param BPlusKey *key
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static void getClientAgendaKey(const void *element, BPlusKey *key) {
+    const Appointment *appointment = (const Appointment*) element;
+    key->group = appointment->clientId;
+    key->value = appointment->startDate;
+    key->id = appointment->id;
+}
+
+/**
+ * Monta a chave de um agendamento no índice de agenda dos advogados: o código do advogado, o início e o ID
+ * 
+ * @param const void *element: Appointment
+ * @param BPlusKey *key
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static void getLawyerAgendaKey(const void *element, BPlusKey *key) {
+    const Appointment *appointment = (const Appointment*) element;
+    key->group = appointment->lawyerId;
+    key->value = appointment->startDate;
+    key->id = appointment->id;
+}
+
+/**
+ * Monta a chave de um agendamento no índice de referências dos escritórios: o código do escritório, o início e o ID
+ * 
+ * @param const void *element: Appointment
+ * @param BPlusKey *key
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static void getOfficeAgendaKey(const void *element, BPlusKey *key) {
+    const Appointment *appointment = (const Appointment*) element;
+    key->group = appointment->officeId;
+    key->value = appointment->startDate;
+    key->id = appointment->id;
+}
+
+/**
+ * Monta a chave de um agendamento no índice de início, que ordena todos os agendamentos pelo início
+ * 
+ * @param const void *element: Appointment
+ * @param BPlusKey *key
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static void getStartKey(const void *element, BPlusKey *key) {
+    const Appointment *appointment = (const Appointment*) element;
+    key->group = 0;
+    key->value = appointment->startDate;
+    key->id = appointment->id;
+}
+
+/**
+ * Índice de agendamentos em árvore B+, com a função que monta a chave de cada agendamento
+ */
+typedef struct AppointmentIndex {
+    const char *filename;
+    void (*getKey)(const void*, BPlusKey*);
+} AppointmentIndex;
+
+static const AppointmentIndex APPOINTMENT_INDEXES[] = {
+    {APPOINTMENT_CLIENT_INDEX, getClientAgendaKey},
+    {APPOINTMENT_LAWYER_INDEX, getLawyerAgendaKey},
+    {APPOINTMENT_OFFICE_INDEX, getOfficeAgendaKey},
+    {APPOINTMENT_START_INDEX, getStartKey}
+};
+
+#define APPOINTMENT_INDEXES_NUMBER (int) (sizeof(APPOINTMENT_INDEXES) / sizeof(AppointmentIndex))
+
+/**
+ * Insere ou remove um agendamento de todos os índices de agendamentos. Deve ser chamada dentro da transação que grava o
+ * agendamento.
+ * 
+ * @param int id: ID do agendamento
+ * @param const Appointment *appointment
+ * @param bool isInsert: true para inserir e false para remover
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static bool indexAppointment(int id, const Appointment *appointment, bool isInsert) {
+    Appointment indexed = *appointment;
+    BPlusKey key;
+    bool status = true;
+
+    indexed.id = id;
+    for (int i = 0; status && i < APPOINTMENT_INDEXES_NUMBER; i++) {
+        APPOINTMENT_INDEXES[i].getKey(&indexed, &key);
+        status = isInsert ? insertIntoBPlusTree(APPOINTMENT_INDEXES[i].filename, &key) : removeFromBPlusTree(APPOINTMENT_INDEXES[i].filename, &key);
+    }
+
+    return status;
+}
+
+/**
+ * Coloca ou retira uma sessão de uma série da ocupação do advogado, do cliente e do escritório
+ * 
+ * @param const AppointmentSeries *series
+ * @param long start: Início da sessão, em minutos desde 01/01/1970
+ * @param bool occupy: true para ocupar e false para liberar os horários
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static bool applyOccurrence(const AppointmentSeries *series, long start, bool occupy) {
+    Occupancy *office = getOccupancy(&officeOccupancies, &officeOccupanciesNumber, series->officeId),
+        *lawyer = getOccupancy(&lawyerOccupancies, &lawyerOccupanciesNumber, series->lawyerId),
+        *client = getOccupancy(&clientOccupancies, &clientOccupanciesNumber, series->clientId);
+    long end = start + series->recurrence.duration;
+    if (office == NULL || lawyer == NULL || client == NULL) return false;
+
+    if (!occupy) {
+        releaseSlots(office, start, end);
+        releaseSlots(lawyer, start, end);
+        releaseSlots(client, start, end);
+        return true;
+    }
+
+    if (occupySlots(office, start, end)) {
+        if (occupySlots(lawyer, start, end)) {
+            if (occupySlots(client, start, end)) return true;
+            releaseSlots(lawyer, start, end);
+        }
+        releaseSlots(office, start, end);
+    }
+
+    return false;
+}
+
+/**
+ * Coloca ou retira das ocupações as sessões de todas as séries que se sobrepõem ao intervalo [from, to). As sessões
+ * são ocupadas apenas durante uma consulta e liberadas em seguida, na mesma ordem.
+ * 
+ * @param long from: Minutos desde 01/01/1970
+ * @param long to
+ * @param bool occupy: true para ocupar e false para liberar os horários
+ * @param int limit: Número máximo de sessões (-1 para todas)
+ * 
+ * @return int: Número de sessões ocupadas ou liberadas | -1, se alguma não puder ser ocupada (as anteriores são
+ * liberadas)
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static int applySeriesWindow(long from, long to, bool occupy, int limit) {
+    long starts[SERIES_OCCURRENCES_CHUNK];
+    int applied = 0, startsNumber;
+
+    for (int i = 0; i < seriesNumber; i++) {
+        const AppointmentSeries *series = &seriesList[i];
+        long windowStart = from;
+
+        do {
+            startsNumber = expandRecurrence(&series->recurrence, windowStart, to, starts, SERIES_OCCURRENCES_CHUNK);
+            for (int j = 0; j < startsNumber; j++) {
+                if (applied == limit) return applied;
+                if (!applyOccurrence(series, starts[j], occupy)) {
+                    applySeriesWindow(from, to, false, applied);
+                    return -1;
+                }
+                applied++;
+            }
+            // As sessões de uma série não se sobrepõem, então a próxima começa depois do fim da última encontrada
+            if (startsNumber > 0) windowStart = starts[startsNumber - 1] + series->recurrence.duration;
+        } while (startsNumber == SERIES_OCCURRENCES_CHUNK);
+    }
+
+    return applied;
+}
+
+/**
+ * Guarda uma série ativa no vetor de séries em memória, substituindo a de mesmo código
+ * 
+ * @param const AppointmentSeries *series
+ * 
+ * @return bool: Retorna false se não houver memória disponível
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static bool storeSeries(const AppointmentSeries *series) {
+    for (int i = 0; i < seriesNumber; i++) {
+        if (seriesList[i].id == series->id) {
+            seriesList[i] = *series;
+            return true;
+        }
+    }
+
+    if (seriesNumber == seriesCapacity) {
+        int capacity = seriesCapacity > 0 ? seriesCapacity * 2 : 16;
+        AppointmentSeries *list = (AppointmentSeries*) realloc(seriesList, capacity * sizeof(AppointmentSeries));
+        if (list == NULL) return false;
+
+        seriesList = list;
+        seriesCapacity = capacity;
+    }
+
+    seriesList[seriesNumber++] = *series;
+    return true;
+}
+
+/**
+ * Retira uma série do vetor de séries em memória
+ * 
+ * @param int id: Código da série
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static void forgetSeries(int id) {
+    for (int i = 0; i < seriesNumber; i++) {
+        if (seriesList[i].id == id) {
+            seriesList[i] = seriesList[--seriesNumber];
+            return;
+        }
+    }
+}
+
+/**
+ * Descarta as agendas, as ocupações e as séries em memória e as monta novamente com os agendamentos e as séries ativos
+ * das tabelas
+ * 
+ * @return bool: Retorna false se não houver memória disponível
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static bool loadSchedules(void) {
+    Cursor cursor;
+    const Appointment *appointment;
+    const AppointmentSeries *series;
+    bool status = true;
+
+    closeAppointmentTable();
+    if (openCursor(&cursor, "appointments.dat", sizeof(Appointment), true)) {
+        while (status && (appointment = nextElement(&cursor)) != NULL) status = scheduleAppointment(appointment->id, appointment);
+        closeCursor(&cursor);
+    }
+    if (status && openCursor(&cursor, "series.dat", sizeof(AppointmentSeries), true)) {
+        while (status && (series = nextElement(&cursor)) != NULL) status = storeSeries(series);
+        closeCursor(&cursor);
+    }
+
+    return status;
+}
+
+/**
+ * Remonta as agendas em memória se alguma gravação confirmada não pôde ser aplicada a elas
+ * 
+ * @return bool: Retorna false se as agendas continuarem desatualizadas
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static bool refreshSchedules(void) {
+    if (isScheduleStale && loadSchedules()) isScheduleStale = false;
+    return !isScheduleStale;
+}
+
+/**
+ * Marca as agendas em memória como desatualizadas depois de uma gravação confirmada que não pôde ser aplicada a elas,
+ * tentando remontá-las em seguida
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static void invalidateSchedules(void) {
+    isScheduleStale = true;
+    refreshSchedules();
+}
+
+/**
+ * Verifica se o horário de um agendamento é válido, livre na agenda do advogado e se ainda há sala livre no escritório,
+ * exibindo o motivo caso não seja
+ * 
+ * @param const Appointment *appointment
+ * @param const Appointment *current: Agendamento antes da edição, cujo horário é desconsiderado (NULL em um cadastro)
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static bool checkAppointmentTime(const Appointment *appointment, const Appointment *current) {
+    int ignoredId = current != NULL ? current->id : 0;
+
+    if (!refreshSchedules()) {
+        printf("Não foi possível carregar as agendas para verificar o horário!\n");
+        return false;
+    }
+
+    if (appointment->endDate <= appointment->startDate) {
+        printf("O término da consulta deve ser posterior ao início!\n");
+        return false;
+    }
+
+    int conflictId = findLawyerConflict(appointment->lawyerId, appointment->startDate, appointment->endDate, ignoredId);
+    if (conflictId != 0) {
+        printf("O advogado já possui um agendamento nesse horário (Código: %d)!\n", conflictId);
+        return false;
+    }
+
+    int seriesId = findSeriesConflict(appointment->lawyerId, appointment->startDate, appointment->endDate, 0);
+    if (seriesId != 0) {
+        printf("O advogado possui uma sessão recorrente nesse horário (Série: %d)!\n", seriesId);
+        return false;
+    }
+
+    // Na edição, as salas ocupadas pelo próprio agendamento são devolvidas durante a consulta
+    if (current != NULL && current->officeId >= 0 && current->officeId < officeOccupanciesNumber) {
+        releaseSlots(&officeOccupancies[current->officeId], current->startDate, current->endDate);
+    }
+    int freeRooms = getOfficeFreeRooms(appointment->officeId, appointment->startDate, appointment->endDate);
+    if (current != NULL && current->officeId >= 0 && current->officeId < officeOccupanciesNumber) {
+        occupySlots(&officeOccupancies[current->officeId], current->startDate, current->endDate);
+    }
+    if (freeRooms <= 0) {
+        printf("O escritório não possui sala livre nesse horário!\n");
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Verifica, sessão por sessão, se o horário de uma nova série está livre na agenda do advogado e se há sala livre no
+ * escritório, exibindo a primeira sessão em conflito
+ * 
+ * @param const AppointmentSeries *series
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static bool checkSeriesTime(const AppointmentSeries *series) {
+    long starts[SERIES_OCCURRENCES_CHUNK], from = series->recurrence.start,
+        to = (long) series->recurrence.until + series->recurrence.duration;
+    int startsNumber;
+    char date[DATETIME_SIZE];
+
+    if (!refreshSchedules()) {
+        printf("Não foi possível carregar as agendas para verificar o horário!\n");
+        return false;
+    }
+
+    do {
+        startsNumber = expandRecurrence(&series->recurrence, from, to, starts, SERIES_OCCURRENCES_CHUNK);
+        for (int i = 0; i < startsNumber; i++) {
+            long start = starts[i], end = start + series->recurrence.duration;
+            int conflictId = findLawyerConflict(series->lawyerId, start, end, 0),
+                seriesId = findSeriesConflict(series->lawyerId, start, end, 0);
+
+            formatDatetime(start, date);
+            if (conflictId != 0) {
+                printf("Sessão de %s: o advogado já possui um agendamento nesse horário (Código: %d)!\n", date, conflictId);
+                return false;
+            }
+            if (seriesId != 0) {
+                printf("Sessão de %s: o advogado possui uma sessão recorrente nesse horário (Série: %d)!\n", date, seriesId);
+                return false;
+            }
+            if (getOfficeFreeRooms(series->officeId, start, end) <= 0) {
+                printf("Sessão de %s: o escritório não possui sala livre nesse horário!\n", date);
+                return false;
+            }
+        }
+        if (startsNumber > 0) from = starts[startsNumber - 1] + series->recurrence.duration;
+    } while (startsNumber == SERIES_OCCURRENCES_CHUNK);
+
+    return true;
+}
+
 /**
  * Formulário para cadastrar um agendamento
  * 
@@ -28,384 +647,1722 @@
  * Authors:
  *  - https://github.com/akemi-adam
  */
-void createAppointment() {
-    Appointment appointment;
-    int tempId;
-    char date[11], startTime[6], endTime[6], clientId[6], lawyerId[6], officeId[6];
+void createAppointment() {
+    Appointment appointment;
+    int tempId;
+    char date[11], endDate[11], startTime[6], endTime[6], clientId[6], lawyerId[6], officeId[6];
+
+    Validation idRules[3] = {validateRequired, validateNumber, validatePositive},
+        dateRules[2] = {validateRequired, validateDate},
+        hourRules[2] = {validateRequired, validateHour};
+        
+    printf("---- Cadastrar Agendamento ----\n");
+    readStrField(clientId, "Código do Cliente", 6, idRules, 3);
+    parseInt(clientId, &tempId);
+    Client *client = findClient(tempId);
+    if (client == NULL) {
+        free(client);
+        printf("Cliente não encontrado!\n");
+        proceed();
+        return;
+    }
+    free(client);
+
+    readStrField(lawyerId, "Código do Advogado", 6, idRules, 3);
+    parseInt(lawyerId, &tempId);
+    Lawyer *lawyer = findLawyer(tempId);
+    if (lawyer == NULL) {
+        free(lawyer);
+        printf("Advogado não encontrado!\n");
+        proceed();
+        return;
+    }
+    free(lawyer);
+
+    readStrField(officeId, "Código do Escritório", 6, idRules, 3);
+    parseInt(officeId, &tempId);
+    Office *office = findOffice(tempId);
+    if (office == NULL) {
+        free(office);
+        printf("Escritório não encontrado!\n");
+        proceed();
+        return;
+    }
+    free(office);
+
+    readStrField(date, "Data do início (dd/mm/aaaa)", 11, dateRules, 2);
+    readStrField(startTime, "Horário do início da consulta (hh:mm)", 6, hourRules, 2);
+    // A data do término vem preenchida com a do início, e só precisa ser alterada se a consulta passar da meia-noite
+    strcpy(endDate, date);
+    readStrField(endDate, "Data do término (dd/mm/aaaa)", 11, dateRules, 2);
+    readStrField(endTime, "Horário do término da consulta (hh:mm)", 6, hourRules, 2);
+    parseDatetime(date, startTime, &appointment.startDate);
+    parseDatetime(endDate, endTime, &appointment.endDate);
+
+    parseInt(clientId, &appointment.clientId);
+    parseInt(lawyerId, &appointment.lawyerId);
+    parseInt(officeId, &appointment.officeId);
+    appointment.isDeleted = false;
+
+    if (!checkAppointmentTime(&appointment, NULL)) {
+        proceed();
+        return;
+    }
+    
+    int id = addAppointment(&appointment);
+
+    if (id > 0) {
+        printf("\nAgendamento cadastrado com sucesso! Código: %d\nPressione <Enter> para prosseguir...\n", id);
+    } else {
+        printf("\nHouve um erro ao cadastrar o agendamento!\n");
+    }
+    proceed();
+}
+
+/**
+ * Lista todos os agendamentos do sistema
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+void listAppointments() {
+    Cursor cursor;
+    const Appointment *appointment;
+    char startDate[DATETIME_SIZE], endDate[DATETIME_SIZE];
+    
+    printf("---- Listar Agendamentos ----\n");
+    printf("------------------------------------------------------------------\n");
+    if (openCursor(&cursor, "appointments.dat", sizeof(Appointment), true)) {
+        while ((appointment = nextElement(&cursor)) != NULL) {
+            formatDatetime(appointment->startDate, startDate);
+            formatDatetime(appointment->endDate, endDate);
+            printf("ID: %d\nCódigo Cliente: %d\nCódigo Advogado: %d\nCódigo Escritório: %d\nData início: %s\nData término: %s\n", appointment->id, appointment->clientId, appointment->lawyerId, appointment->officeId, startDate, endDate);
+            printf("------------------------------------------------------------------\n");
+        }
+        closeCursor(&cursor);
+    }
+
+    printf("Pressione <Enter> para prosseguir...\n");
+    proceed();
+}
+
+/**
+ * Exibe os dados de um agendamento específico
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+void readAppointment() {
+    int intId;
+    char id[6];
+    Validation idRules[3] = {validateRequired, validateNumber, validatePositive};
+    printf("---- Buscar Agendamento ----\n");
+    readStrField(id, "Código do Agendamento", 6, idRules, 3);
+    parseInt(id, &intId);
+    Appointment *appointment = findAppointment(intId);
+
+    if (appointment != NULL) {
+        char startDate[DATETIME_SIZE], endDate[DATETIME_SIZE];
+        formatDatetime(appointment->startDate, startDate);
+        formatDatetime(appointment->endDate, endDate);
+        printf("------------------------------------------------------------------\n");
+        printf("ID: %s\nCódigo Cliente: %d\nCódigo Advogado: %d\nCódigo Escritório: %d\nData início: %s\nData término: %s\n", id, appointment->clientId, appointment->lawyerId, appointment->officeId, startDate, endDate);
+        printf("------------------------------------------------------------------\n");
+        free(appointment);
+    } else {
+        printf("O código informado não corresponde a nenhum agendamento\n");
+    }
+    printf("Pressione <Enter> para prosseguir...\n");
+    proceed();
+}
+
+/**
+ * Formulário para atualizar os dados de um agendamento específico
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ * 
+ * Obs.: Algumas melhorias podem ser feitas nessa função, como fazer uma função genérica para a verificação da foreign key. Outra melhoria é a atribuição das datas e sua atualização.
+ */
+void updateAppointment() {
+    int tempId, intId;
+    char date[11], endDate[11], startTime[6], endTime[6], appointmentId[6], clientId[6], lawyerId[6], officeId[6];
+
+    Validation idRules[3] = {validateRequired, validateNumber, validatePositive},
+        fkRules[2] = {validateNumber, validatePositive},
+        dateRules[1] = {validateDate},
+        hourRules[1] = {validateHour};
+    
+    printf("---- Atualizar Agendamento ----\n");
+    readStrField(appointmentId, "Código do Agendamento", 6, idRules, 3);
+    parseInt(appointmentId, &intId);
+    Appointment *appointment = findAppointment(intId);
+
+    if (appointment != NULL) {
+        Appointment current = *appointment;
+
+        sprintf(clientId, "%d", appointment->clientId);
+        readStrField(clientId, "Código do Cliente", 6, fkRules, 2);
+        if (parseInt(clientId, &tempId)) {
+            Client *client = findClient(tempId);
+            if (client == NULL) {
+                free(client);
+                printf("Cliente não encontrado!\n");
+                proceed();
+                return;
+            }
+            free(client);
+        }
+
+        sprintf(lawyerId, "%d", appointment->lawyerId);
+        readStrField(lawyerId, "Código do Advogado", 6, fkRules, 2);
+        if (parseInt(lawyerId, &tempId)) {
+            Lawyer *lawyer = findLawyer(tempId);
+            if (lawyer == NULL) {
+                free(lawyer);
+                printf("Advogado não encontrado!\n");
+                proceed();
+                return;
+            }
+            free(lawyer);
+        }
+
+        sprintf(officeId, "%d", appointment->officeId);
+        readStrField(officeId, "Código do Escritório", 6, fkRules, 2);
+        if (parseInt(officeId, &tempId)) {
+            Office *office = findOffice(tempId);
+            if (office == NULL) {
+                free(office);
+                printf("Escritório não encontrado!\n");
+                proceed();
+                return;
+            }
+            free(office);
+        }
+
+        formatDate(appointment->startDate, date);
+        readStrField(date, "Data do início (dd/mm/aaaa)", 11, dateRules, 1);
+
+        formatTime(appointment->startDate, startTime);
+        readStrField(startTime, "Horário do início da consulta (hh:mm)", 6, hourRules, 1);
+
+        formatDate(appointment->endDate, endDate);
+        readStrField(endDate, "Data do término (dd/mm/aaaa)", 11, dateRules, 1);
+
+        formatTime(appointment->endDate, endTime);
+        readStrField(endTime, "Horário do término da consulta (hh:mm)", 6, hourRules, 1);
+
+        parseDatetime(date, startTime, &appointment->startDate);
+        parseDatetime(endDate, endTime, &appointment->endDate);
+
+        parseInt(clientId, &appointment->clientId);
+        parseInt(lawyerId, &appointment->lawyerId);
+        parseInt(officeId, &appointment->officeId);
+
+        if (!checkAppointmentTime(appointment, &current)) {
+            printf("O agendamento não foi editado\n");
+        } else if (editAppointments(intId, appointment)) {
+            printf("Agendamento editado com sucesso!\n");
+        } else {
+            printf("Houve um erro ao editar o agendamento!\n");
+        }
+        free(appointment);
+    } else {
+        printf("O código informado não corresponde a nenhum agendamento\n");
+    }
+
+    printf("\nPressione <Enter> para prosseguir...\n");
+    proceed();
+}
+
+/**
+ * Formulário para procurar os próximos horários em que um cliente, um advogado e um escritório estão livres
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+void searchFreeSlots() {
+    int clientId, lawyerId, officeId, duration, maxSlots;
+    char strClientId[6], strLawyerId[6], strOfficeId[6], strDuration[5], strMaxSlots[3],
+        firstDate[11], lastDate[11], opening[6], closing[6];
+    int from, to;
+    long slots[FREE_SLOTS_MAX];
+
+    Validation idRules[3] = {validateRequired, validateNumber, validatePositive},
+        dateRules[2] = {validateRequired, validateDate},
+        hourRules[2] = {validateRequired, validateHour};
+
+    printf("---- Procurar Horário Livre ----\n");
+    readStrField(strClientId, "Código do Cliente", 6, idRules, 3);
+    readStrField(strLawyerId, "Código do Advogado", 6, idRules, 3);
+    readStrField(strOfficeId, "Código do Escritório", 6, idRules, 3);
+    parseInt(strClientId, &clientId);
+    parseInt(strLawyerId, &lawyerId);
+    parseInt(strOfficeId, &officeId);
+
+    Client *client = findClient(clientId);
+    Lawyer *lawyer = findLawyer(lawyerId);
+    Office *office = findOffice(officeId);
+    bool isFound = client != NULL && lawyer != NULL && office != NULL;
+    free(client);
+    free(lawyer);
+    free(office);
+    if (!isFound) {
+        printf("Cliente, advogado ou escritório não encontrado!\n");
+        proceed();
+        return;
+    }
+
+    readStrField(strDuration, "Duração da consulta (minutos)", 5, idRules, 3);
+    readStrField(firstDate, "Data inicial (dd/mm/aaaa)", 11, dateRules, 2);
+    readStrField(lastDate, "Data final (dd/mm/aaaa)", 11, dateRules, 2);
+    readStrField(opening, "Início do expediente (hh:mm)", 6, hourRules, 2);
+    readStrField(closing, "Término do expediente (hh:mm)", 6, hourRules, 2);
+    readStrField(strMaxSlots, "Quantidade de horários", 3, idRules, 3);
+    parseInt(strDuration, &duration);
+    parseInt(strMaxSlots, &maxSlots);
+    if (maxSlots > FREE_SLOTS_MAX) maxSlots = FREE_SLOTS_MAX;
+
+    parseDatetime(firstDate, opening, &from);
+    parseDatetime(lastDate, closing, &to);
+    if (to < from || getMinuteOfDay(to) <= getMinuteOfDay(from)) {
+        printf("A data final e o término do expediente devem ser posteriores à data inicial e ao início do expediente!\n");
+        proceed();
+        return;
+    }
+
+    int slotsNumber = findAvailableSlots(clientId, lawyerId, officeId, duration, from, to, slots, maxSlots);
+
+    printf("------------------------------------------------------------------\n");
+    for (int i = 0; i < slotsNumber; i++) {
+        char start[DATETIME_SIZE], end[TIME_SIZE];
+        formatDatetime(slots[i], start);
+        formatTime(slots[i] + duration, end);
+        printf("%d. %s até %s\n", i + 1, start, end);
+    }
+    if (slotsNumber == 0) printf("Nenhum horário livre encontrado no período informado\n");
+    printf("------------------------------------------------------------------\n");
+
+    printf("Pressione <Enter> para prosseguir...\n");
+    proceed();
+}
+
+/**
+ * Formulário para cadastrar uma série de agendamentos recorrentes, semanais ou mensais
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+void createSeries() {
+    AppointmentSeries series;
+    int frequency, interval, endDate;
+    char clientId[6], lawyerId[6], officeId[6], firstDate[11], lastDate[11], startTime[6], endTime[6], strFrequency[2], strInterval[3];
+
+    Validation idRules[3] = {validateRequired, validateNumber, validatePositive},
+        dateRules[2] = {validateRequired, validateDate},
+        hourRules[2] = {validateRequired, validateHour};
+
+    printf("---- Cadastrar Agendamento Recorrente ----\n");
+    readStrField(clientId, "Código do Cliente", 6, idRules, 3);
+    readStrField(lawyerId, "Código do Advogado", 6, idRules, 3);
+    readStrField(officeId, "Código do Escritório", 6, idRules, 3);
+    parseInt(clientId, &series.clientId);
+    parseInt(lawyerId, &series.lawyerId);
+    parseInt(officeId, &series.officeId);
+
+    Client *client = findClient(series.clientId);
+    Lawyer *lawyer = findLawyer(series.lawyerId);
+    Office *office = findOffice(series.officeId);
+    bool isFound = client != NULL && lawyer != NULL && office != NULL;
+    free(client);
+    free(lawyer);
+    free(office);
+    if (!isFound) {
+        printf("Cliente, advogado ou escritório não encontrado!\n");
+        proceed();
+        return;
+    }
+
+    readStrField(firstDate, "Data da primeira sessão (dd/mm/aaaa)", 11, dateRules, 2);
+    readStrField(startTime, "Horário do início da sessão (hh:mm)", 6, hourRules, 2);
+    readStrField(endTime, "Horário do término da sessão (hh:mm)", 6, hourRules, 2);
+    readStrField(strFrequency, "Repetição (1 - semanal, 2 - mensal)", 2, idRules, 3);
+    readStrField(strInterval, "Repetir a cada quantas semanas ou meses", 3, idRules, 3);
+    readStrField(lastDate, "Data da última sessão (dd/mm/aaaa)", 11, dateRules, 2);
+    parseInt(strFrequency, &frequency);
+    parseInt(strInterval, &interval);
+
+    series.recurrence.frequency = frequency;
+    series.recurrence.interval = interval;
+    series.recurrence.exceptionsNumber = 0;
+    parseDatetime(firstDate, startTime, &series.recurrence.start);
+    parseDatetime(firstDate, endTime, &endDate);
+    parseDatetime(lastDate, startTime, &series.recurrence.until);
+    // Um término anterior ao início indica uma sessão que passa da meia-noite
+    series.recurrence.duration = endDate > series.recurrence.start ? endDate - series.recurrence.start : endDate + MINUTES_PER_DAY - series.recurrence.start;
+    series.isDeleted = false;
+
+    if (!isValidRecurrence(&series.recurrence)) {
+        printf("Repetição inválida! Informe 1 ou 2 e uma data da última sessão posterior à da primeira.\n");
+        proceed();
+        return;
+    }
+    if (!checkSeriesTime(&series)) {
+        proceed();
+        return;
+    }
+
+    int id = addSeries(&series);
+
+    if (id > 0) {
+        printf("\nAgendamento recorrente cadastrado com sucesso! Código da série: %d\nPressione <Enter> para prosseguir...\n", id);
+    } else {
+        printf("\nHouve um erro ao cadastrar o agendamento recorrente!\n");
+    }
+    proceed();
+}
+
+/**
+ * Sessão de uma série, usada para ordenar as sessões exibidas
+ */
+typedef struct SeriesOccurrence {
+    long start;
+    const AppointmentSeries *series;
+} SeriesOccurrence;
+
+/**
+ * Compara duas sessões pelo início, para o qsort
+ * 
+ * @param const void *a
+ * @param const void *b
+ * 
+ * @return int
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static int compareOccurrences(const void *a, const void *b) {
+    long startA = ((const SeriesOccurrence*) a)->start, startB = ((const SeriesOccurrence*) b)->start;
+    return (startA > startB) - (startA < startB);
+}
+
+/**
+ * Calcula, em ordem, as sessões das séries em um período, apenas para as sessões do período
+ * 
+ * @param long from: Minutos desde 01/01/1970
+ * @param long to
+ * @param int clientId: Considera apenas as séries do cliente (0 para todos)
+ * @param int lawyerId: Considera apenas as séries do advogado (0 para todos)
+ * @param int *occurrencesNumber: Destino do número de sessões
+ * 
+ * @return SeriesOccurrence*|NULL: Vetor de sessões, que deve ser liberado | NULL, se não houver sessões ou memória
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static SeriesOccurrence* getSeriesOccurrences(long from, long to, int clientId, int lawyerId, int *occurrencesNumber) {
+    long starts[SERIES_OCCURRENCES_CHUNK];
+    int occurrencesCapacity = 0, startsNumber;
+    SeriesOccurrence *occurrences = NULL;
+
+    *occurrencesNumber = 0;
+    for (int i = 0; i < seriesNumber; i++) {
+        long windowStart = from;
+        if ((clientId != 0 && seriesList[i].clientId != clientId) || (lawyerId != 0 && seriesList[i].lawyerId != lawyerId)) continue;
+
+        do {
+            startsNumber = expandRecurrence(&seriesList[i].recurrence, windowStart, to, starts, SERIES_OCCURRENCES_CHUNK);
+            if (*occurrencesNumber + startsNumber > occurrencesCapacity) {
+                int capacity = occurrencesCapacity > 0 ? occurrencesCapacity : 64;
+                while (capacity < *occurrencesNumber + startsNumber) capacity *= 2;
+
+                SeriesOccurrence *list = (SeriesOccurrence*) realloc(occurrences, capacity * sizeof(SeriesOccurrence));
+                if (list == NULL) break;
+                occurrences = list;
+                occurrencesCapacity = capacity;
+            }
+            for (int j = 0; j < startsNumber; j++) {
+                occurrences[*occurrencesNumber].start = starts[j];
+                occurrences[(*occurrencesNumber)++].series = &seriesList[i];
+            }
+            if (startsNumber > 0) windowStart = starts[startsNumber - 1] + seriesList[i].recurrence.duration;
+        } while (startsNumber == SERIES_OCCURRENCES_CHUNK);
+    }
+    if (*occurrencesNumber > 1) qsort(occurrences, *occurrencesNumber, sizeof(SeriesOccurrence), compareOccurrences);
+
+    return occurrences;
+}
+
+/**
+ * Exibe uma lista de sessões recorrentes
+ * 
+ * @param const SeriesOccurrence *occurrences
+ * @param int occurrencesNumber
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static void showSeriesOccurrences(const SeriesOccurrence *occurrences, int occurrencesNumber) {
+    for (int i = 0; i < occurrencesNumber; i++) {
+        const AppointmentSeries *series = occurrences[i].series;
+        char start[DATETIME_SIZE], end[DATETIME_SIZE];
+
+        formatDatetime(occurrences[i].start, start);
+        formatDatetime(occurrences[i].start + series->recurrence.duration, end);
+        printf("Série: %d\nCódigo Cliente: %d\nCódigo Advogado: %d\nCódigo Escritório: %d\nData início: %s (%s)\nData término: %s\n", series->id, series->clientId, series->lawyerId, series->officeId, start, getWeekdayName(getWeekday(minutesToDays(occurrences[i].start))), end);
+        printf("------------------------------------------------------------------\n");
+    }
+}
+
+/**
+ * Exibe os agendamentos e as sessões recorrentes de um período
+ * 
+ * @param const Appointment *appointments
+ * @param int appointmentsNumber
+ * @param const SeriesOccurrence *occurrences
+ * @param int occurrencesNumber
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static void showPeriodAppointments(const Appointment *appointments, int appointmentsNumber, const SeriesOccurrence *occurrences, int occurrencesNumber) {
+    printf("------------------------------------------------------------------\n");
+    for (int i = 0; i < appointmentsNumber; i++) {
+        char startDate[DATETIME_SIZE], endDate[DATETIME_SIZE];
+        formatDatetime(appointments[i].startDate, startDate);
+        formatDatetime(appointments[i].endDate, endDate);
+        printf("ID: %d\nCódigo Cliente: %d\nCódigo Advogado: %d\nCódigo Escritório: %d\nData início: %s\nData término: %s\n", appointments[i].id, appointments[i].clientId, appointments[i].lawyerId, appointments[i].officeId, startDate, endDate);
+        printf("------------------------------------------------------------------\n");
+    }
+    showSeriesOccurrences(occurrences, occurrencesNumber);
+    if (appointmentsNumber == 0 && occurrencesNumber == 0) printf("Nenhum agendamento no período informado\n");
+}
+
+/**
+ * Exibe, em ordem, as sessões de todas as séries em um período. Apenas as sessões do período são calculadas.
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+void listSeriesOccurrences() {
+    char firstDate[11], lastDate[11];
+    int from, to, occurrencesNumber;
+    Validation dateRules[2] = {validateRequired, validateDate};
+
+    printf("---- Mostrar Sessões Recorrentes ----\n");
+    readStrField(firstDate, "Data inicial (dd/mm/aaaa)", 11, dateRules, 2);
+    readStrField(lastDate, "Data final (dd/mm/aaaa)", 11, dateRules, 2);
+    parseDatetime(firstDate, "00:00", &from);
+    parseDatetime(lastDate, "00:00", &to);
+    to += MINUTES_PER_DAY;
+
+    SeriesOccurrence *occurrences = getSeriesOccurrences(from, to, 0, 0, &occurrencesNumber);
+
+    printf("------------------------------------------------------------------\n");
+    showSeriesOccurrences(occurrences, occurrencesNumber);
+    if (occurrencesNumber == 0) printf("Nenhuma sessão recorrente no período informado\n");
+    free(occurrences);
+
+    printf("Pressione <Enter> para prosseguir...\n");
+    proceed();
+}
+
+/**
+ * Exibe a agenda de um cliente ou de um advogado em um período: os agendamentos, lidos do índice do cliente ou do
+ * advogado em ordem de início, e as sessões das suas séries no período
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+void showAgenda() {
+    int personType, personId, from, to, appointmentsNumber, occurrencesNumber;
+    char strPersonType[2], strPersonId[6], firstDate[11], lastDate[11];
+    Validation idRules[3] = {validateRequired, validateNumber, validatePositive},
+        dateRules[2] = {validateRequired, validateDate};
+
+    printf("---- Consultar Agenda ----\n");
+    readStrField(strPersonType, "Agenda de (1 - cliente, 2 - advogado)", 2, idRules, 3);
+    parseInt(strPersonType, &personType);
+    if (personType != 1 && personType != 2) {
+        printf("Opção inválida! Informe 1 ou 2.\n");
+        proceed();
+        return;
+    }
+
+    readStrField(strPersonId, personType == 1 ? "Código do Cliente" : "Código do Advogado", 6, idRules, 3);
+    parseInt(strPersonId, &personId);
+    void *person = personType == 1 ? (void*) findClient(personId) : (void*) findLawyer(personId);
+    if (person == NULL) {
+        printf("%s não encontrado!\n", personType == 1 ? "Cliente" : "Advogado");
+        proceed();
+        return;
+    }
+    free(person);
+
+    readStrField(firstDate, "Data inicial (dd/mm/aaaa)", 11, dateRules, 2);
+    readStrField(lastDate, "Data final (dd/mm/aaaa)", 11, dateRules, 2);
+    parseDatetime(firstDate, "00:00", &from);
+    parseDatetime(lastDate, "00:00", &to);
+    to += MINUTES_PER_DAY;
+
+    const char *index = personType == 1 ? APPOINTMENT_CLIENT_INDEX : APPOINTMENT_LAWYER_INDEX;
+    Appointment *appointments = getAgenda(index, personId, from, to, &appointmentsNumber);
+    SeriesOccurrence *occurrences = getSeriesOccurrences(from, to, personType == 1 ? personId : 0, personType == 2 ? personId : 0, &occurrencesNumber);
+
+    showPeriodAppointments(appointments, appointmentsNumber, occurrences, occurrencesNumber);
+    free(appointments);
+    free(occurrences);
+
+    printf("Pressione <Enter> para prosseguir...\n");
+    proceed();
+}
+
+/**
+ * Exibe os agendamentos de um dia, de uma semana (de domingo a sábado), de um mês ou de um período, junto com as
+ * sessões recorrentes no período. Os agendamentos são lidos do índice de início, sem percorrer todo o arquivo.
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+void listAppointmentsInRange() {
+    int view, appointmentsNumber, occurrencesNumber;
+    long from, to;
+    char strView[2], firstDate[11], lastDate[11];
+    Datetime datetime;
+    Validation idRules[3] = {validateRequired, validateNumber, validatePositive},
+        dateRules[2] = {validateRequired, validateDate};
+
+    printf("---- Listar Agendamentos por Período ----\n");
+    readStrField(strView, "Visualizar (1 - dia, 2 - semana, 3 - mês, 4 - período)", 2, idRules, 3);
+    parseInt(strView, &view);
+    if (view < 1 || view > 4) {
+        printf("Opção inválida! Informe um número de 1 a 4.\n");
+        proceed();
+        return;
+    }
+
+    readStrField(firstDate, view == 4 ? "Data inicial (dd/mm/aaaa)" : "Data (dd/mm/aaaa)", 11, dateRules, 2);
+    parseDate(firstDate, &datetime);
+    long day = daysFromCivil(datetime.year, datetime.month, datetime.day), lastDay = day;
+
+    if (view == 2) {
+        day -= getWeekday(day);
+        lastDay = day + DAYS_PER_WEEK - 1;
+    } else if (view == 3) {
+        day -= datetime.day - 1;
+        lastDay = day + getDaysInMonth(datetime.month, datetime.year) - 1;
+    } else if (view == 4) {
+        readStrField(lastDate, "Data final (dd/mm/aaaa)", 11, dateRules, 2);
+        parseDate(lastDate, &datetime);
+        lastDay = daysFromCivil(datetime.year, datetime.month, datetime.day);
+    }
+    from = day * MINUTES_PER_DAY;
+    to = (lastDay + 1) * MINUTES_PER_DAY;
+
+    Appointment *appointments = getAppointmentsInRange(from, to, &appointmentsNumber);
+    SeriesOccurrence *occurrences = getSeriesOccurrences(from, to, 0, 0, &occurrencesNumber);
+    char start[DATE_SIZE], end[DATE_SIZE];
+
+    formatDate(from, start);
+    formatDate(to - 1, end);
+    printf("Período: %s a %s\n", start, end);
+    showPeriodAppointments(appointments, appointmentsNumber, occurrences, occurrencesNumber);
+    free(appointments);
+    free(occurrences);
+
+    printf("Pressione <Enter> para prosseguir...\n");
+    proceed();
+}
+
+/**
+ * Formulário para cancelar uma única sessão de uma série, mantendo as demais
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+void cancelSeriesOccurrence() {
+    int intId, start;
+    char id[6], date[11], time[TIME_SIZE];
+    Validation idRules[3] = {validateRequired, validateNumber, validatePositive},
+        dateRules[2] = {validateRequired, validateDate};
+
+    printf("---- Cancelar Sessão Recorrente ----\n");
+    readStrField(id, "Código da Série", 6, idRules, 3);
+    parseInt(id, &intId);
+    AppointmentSeries *series = findSeries(intId);
+
+    if (series != NULL) {
+        readStrField(date, "Data da sessão (dd/mm/aaaa)", 11, dateRules, 2);
+        formatTime(series->recurrence.start, time);
+        parseDatetime(date, time, &start);
+
+        if (!addRecurrenceException(&series->recurrence, start)) {
+            printf("A série não possui sessão nessa data ou não permite mais cancelamentos!\n");
+        } else if (editSeries(intId, series)) {
+            printf("Sessão cancelada com sucesso!\n");
+        } else {
+            printf("Houve um erro ao cancelar a sessão!\n");
+        }
+        free(series);
+    } else {
+        printf("O código informado não corresponde a nenhuma série\n");
+    }
+
+    printf("Pressione <Enter> para prosseguir...\n");
+    proceed();
+}
+
+/**
+ * Deleta uma série de agendamentos, com todas as suas sessões
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+void deleteSeries() {
+    int intId;
+    char id[6];
+    Validation idRules[3] = {validateRequired, validateNumber, validatePositive};
+
+    printf("---- Deletar Agendamento Recorrente ----\n");
+    readStrField(id, "Código da Série", 6, idRules, 3);
+    parseInt(id, &intId);
+    AppointmentSeries *series = findSeries(intId);
+
+    if (series != NULL) {
+        series->isDeleted = true;
+        if (editSeries(intId, series)) {
+            printf("Série deletada com sucesso!\n");
+        } else {
+            printf("Houve um erro ao deletar a série!\n");
+        }
+        free(series);
+    } else {
+        printf("O código informado não corresponde a nenhuma série\n");
+    }
+
+    printf("Pressione <Enter> para prosseguir...\n");
+    proceed();
+}
+
+/**
+ * Deleta um agendamento
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+void deleteAppointment() {
+    int intId;
+    char id[6];
+    Validation idRules[3] = {validateRequired, validateNumber, validatePositive};
+
+    printf("---- Deletar Agendamento ----\n");
+    readStrField(id, "Código do Agendamento", 6, idRules, 3);
+    parseInt(id, &intId);
+    Appointment *appointment = findAppointment(intId);
+
+    if (appointment != NULL) {
+        appointment->isDeleted = true;
+        if (editAppointments(intId, appointment)) {
+            printf("Agendamento deletado com sucesso!\n");
+        } else {
+            printf("Houve um erro ao deletar o agendamento!\n");
+        }
+        free(appointment);
+    } else {
+        printf("O código informado não corresponde a nenhum agendamento\n");
+    }
+
+    printf("Pressione <Enter> para prosseguir...\n");
+    proceed();
+}
+
+/**
+ * Formulário usado na exclusão de um cliente, advogado ou escritório com agendamentos ou séries ativos. O usuário
+ * escolhe entre cancelar a exclusão, excluir os agendamentos ou transferi-los para outro cadastro. A escolha é
+ * aplicada por deleteReferencedRecord, na mesma transação da exclusão.
+ * 
+ * @param AppointmentReference reference
+ * @param int id: Código do cadastro a ser excluído
+ * @param ReferenceAction *action: Destino da escolha (REFERENCE_BLOCK, se o cadastro não tiver agendamentos)
+ * @param int *newId: Destino do código do cadastro que recebe os agendamentos, em REFERENCE_REASSIGN
+ * 
+ * @return bool: Retorna false se a exclusão for cancelada
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool readReferenceAction(AppointmentReference reference, int id, ReferenceAction *action, int *newId) {
+    int references = countAppointmentReferences(reference, id), option;
+    *action = REFERENCE_BLOCK;
+    *newId = 0;
+    if (references == 0) return true;
+
+    char strAction[2], strNewId[6], names[3][12] = {"cliente", "advogado", "escritório"};
+    const char *name = names[reference - REFERENCE_CLIENT];
+    Validation idRules[3] = {validateRequired, validateNumber, validatePositive};
+
+    printf("O %s possui %d agendamento(s) e série(s) ativos.\n", name, references);
+    readStrField(strAction, "Ação (1 - cancelar a exclusão, 2 - excluir os agendamentos, 3 - transferir os agendamentos)", 2, idRules, 3);
+    parseInt(strAction, &option);
+
+    if (option == REFERENCE_CASCADE) {
+        *action = REFERENCE_CASCADE;
+        return true;
+    }
+    if (option != REFERENCE_REASSIGN) return false;
+
+    readStrField(strNewId, "Código do novo responsável", 6, idRules, 3);
+    parseInt(strNewId, newId);
+    void *target = reference == REFERENCE_CLIENT ? (void*) findClient(*newId)
+        : reference == REFERENCE_LAWYER ? (void*) findLawyer(*newId) : (void*) findOffice(*newId);
+    if (target == NULL || *newId == id) {
+        free(target);
+        printf("O código informado não corresponde a outro %s\n", name);
+        return false;
+    }
+    free(target);
+
+    *action = REFERENCE_REASSIGN;
+    return true;
+}
+
+/**
+ * Exibe o menu do módulo agendamento e que pede para o usuário selecionar uma opção
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+void showAppointmentMenu() {
+    #ifdef __unix__
+        struct termios originalTerminal;
+        tcgetattr(STDIN_FILENO, &originalTerminal);
+    #endif
+    int option = 0, size = 10;
+    bool isSelected = false, loop = true;
+    char optionsStyles[size][11];
+    char options[10][30] = {
+        "1. Cadastrar Agendamento", "2. Mostrar Agendamentos", "3. Achar Agendamento",
+        "4. Editar Agendamento", "5. Excluir Agendamento", "6. Procurar Horário Livre",
+        "7. Agendamentos Recorrentes", "8. Consultar Agenda", "9. Listar por Período", "10. Voltar"
+    };
+    void (*actions[])() = {
+        createAppointment, listAppointments, readAppointment, updateAppointment, deleteAppointment, searchFreeSlots,
+        showSeriesMenu, showAgenda, listAppointmentsInRange
+    };
+    setOptionsStyle(optionsStyles, size);
+    while (loop) {
+        #ifdef __unix__
+            system("clear");
+            enableRawMode();
+        #else
+            system("cls");
+        #endif
+        if (!isSelected) {
+            showOptions("Menu Agendamento", options, optionsStyles, size);
+            strcpy(optionsStyles[option], RESET_STYLE);
+            selectOption(&option, size - 1, &isSelected);
+            strcpy(optionsStyles[option], CYAN_STYLE);
+        } else {
+           #ifdef __unix__
+                disableRawMode(&originalTerminal);
+            #endif
+            isSelected = false;
+            if (option >= 0 && option <= (size - 2)) {
+                actions[option]();
+            } else {
+                loop = false;
+            }
+        }
+    }
+}
+
+/**
+ * Exibe o menu dos agendamentos recorrentes e pede para o usuário selecionar uma opção
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+void showSeriesMenu() {
+    #ifdef __unix__
+        struct termios originalTerminal;
+        tcgetattr(STDIN_FILENO, &originalTerminal);
+    #endif
+    int option = 0, size = 5;
+    bool isSelected = false, loop = true;
+    char optionsStyles[size][11];
+    char options[5][30] = {
+        "1. Cadastrar Recorrente", "2. Mostrar Sessões", "3. Cancelar Sessão", "4. Excluir Recorrente", "5. Voltar"
+    };
+    void (*actions[])() = {
+        createSeries, listSeriesOccurrences, cancelSeriesOccurrence, deleteSeries
+    };
+    setOptionsStyle(optionsStyles, size);
+    while (loop) {
+        #ifdef __unix__
+            system("clear");
+            enableRawMode();
+        #else
+            system("cls");
+        #endif
+        if (!isSelected) {
+            showOptions("Menu Recorrentes", options, optionsStyles, size);
+            strcpy(optionsStyles[option], RESET_STYLE);
+            selectOption(&option, size - 1, &isSelected);
+            strcpy(optionsStyles[option], CYAN_STYLE);
+        } else {
+           #ifdef __unix__
+                disableRawMode(&originalTerminal);
+            #endif
+            isSelected = false;
+            if (option >= 0 && option <= (size - 2)) {
+                actions[option]();
+            } else {
+                loop = false;
+            }
+        }
+    }
+}
 
-    Validation idRules[3] = {validateRequired, validateNumber, validatePositive},
-        dateRules[2] = {validateRequired, validateDate},
-        hourRules[2] = {validateRequired, validateHour};
-        
-    printf("---- Cadastrar Agendamento ----\n");
-    readStrField(clientId, "Código do Cliente", 6, idRules, 3);
-    parseInt(clientId, &tempId);
-    Client *client = findClient(tempId);
-    if (client == NULL) {
-        free(client);
-        printf("Cliente não encontrado!\n");
-        proceed();
-        return;
+/**
+ * Retorna um agendamento específico a partir de seu ID
+ * 
+ * @param const char *id: ID a ser procurado
+ * 
+ * @return Appointment*|NULL: Agendamento correspondente ao ID | NULL, caso não encontre
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+Appointment* findAppointment(int id) {
+    Appointment* appointment = (Appointment*) malloc(sizeof(Appointment));
+    if (appointment == NULL) return NULL;
+
+    if (!readElementById(appointment, sizeof(Appointment), id, "appointments.dat") || appointment->isDeleted) {
+        free(appointment);
+        return NULL;
     }
-    free(client);
 
-    readStrField(lawyerId, "Código do Advogado", 6, idRules, 3);
-    parseInt(lawyerId, &tempId);
-    Lawyer *lawyer = findLawyer(tempId);
-    if (lawyer == NULL) {
-        free(lawyer);
-        printf("Advogado não encontrado!\n");
-        proceed();
-        return;
+    return appointment;
+}
+
+
+/**
+ * Cadastra um agendamento no arquivo e nos índices de agendamentos, em uma única transação, e coloca o seu horário na
+ * agenda do advogado. Se o horário não puder ser colocado nas agendas em memória depois da gravação, elas são
+ * remontadas a partir das tabelas.
+ * 
+ * @param Appointment *appointment: Agendamento, que recebe o ID gerado
+ * 
+ * @return int: ID do agendamento | 0, se houver alguma falha
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+int addAppointment(Appointment *appointment) {
+    beginTransaction();
+    int id = addElementToFile(appointment, sizeof(Appointment), "appointments.dat");
+    if (id == 0 || (!appointment->isDeleted && !indexAppointment(id, appointment, true)) || !commitTransaction()) {
+        rollbackTransaction();
+        return 0;
     }
-    free(lawyer);
 
-    readStrField(officeId, "Código do Escritório", 6, idRules, 3);
-    parseInt(officeId, &tempId);
-    Office *office = findOffice(tempId);
-    if (office == NULL) {
-        free(office);
-        printf("Escritório não encontrado!\n");
-        proceed();
-        return;
+    appointment->id = id;
+    if (!appointment->isDeleted && !scheduleAppointment(id, appointment)) invalidateSchedules();
+
+    return id;
+}
+
+/**
+ * Sobrescreve o registro de um agendamento e, caso o cliente, o advogado, o escritório ou o início tenham mudado,
+ * atualiza os índices de agendamentos, sem alterar as agendas em memória. Deve ser chamada dentro de uma transação.
+ * 
+ * @param int id: ID do agendamento
+ * @param const Appointment *current: Agendamento gravado atualmente
+ * @param const Appointment *appointment: Novo conteúdo
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static bool writeAppointment(int id, const Appointment *current, const Appointment *appointment) {
+    bool isKeyChanged = current->isDeleted != appointment->isDeleted || current->clientId != appointment->clientId
+        || current->lawyerId != appointment->lawyerId || current->officeId != appointment->officeId
+        || current->startDate != appointment->startDate;
+
+    bool status = updateElementById(appointment, sizeof(Appointment), id, "appointments.dat");
+    if (status && isKeyChanged && !current->isDeleted) status = indexAppointment(id, current, false);
+    if (status && isKeyChanged && !appointment->isDeleted) status = indexAppointment(id, appointment, true);
+
+    return status;
+}
+
+/**
+ * Edita/atualiza um agendamento no arquivo, sobrescrevendo apenas o seu registro, e atualiza os índices de agendamentos
+ * na mesma transação caso o cliente, o advogado, o escritório ou o início tenham mudado. A agenda do advogado é
+ * atualizada trocando apenas o intervalo do agendamento, sem reler a tabela, a menos que o novo horário não possa ser
+ * colocado nela.
+ * 
+ * @param int id: ID do agendamento
+ * @param Appointment *appointment: Agendamento
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool editAppointments(int id, Appointment *appointment) {
+    Appointment current;
+    if (!readElementById(&current, sizeof(Appointment), id, "appointments.dat")) return false;
+
+    beginTransaction();
+    bool status = writeAppointment(id, &current, appointment);
+    if (status) status = commitTransaction();
+    else rollbackTransaction();
+    if (!status) return false;
+
+    if (!current.isDeleted) unscheduleAppointment(id, &current);
+    if (!appointment->isDeleted && !scheduleAppointment(id, appointment)) invalidateSchedules();
+
+    return true;
+}
+
+/**
+ * Procura, em O(log n), um agendamento do advogado cujo horário se sobreponha ao intervalo [start, end)
+ * 
+ * @param int lawyerId
+ * @param long start: Início, em minutos desde 01/01/1970
+ * @param long end
+ * @param int ignoredId: ID de um agendamento a ser desconsiderado (0 para nenhum)
+ * 
+ * @return int: ID do agendamento conflitante | 0, caso o horário esteja livre | -1, se as agendas em memória não puderem ser
+ * remontadas
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+int findLawyerConflict(int lawyerId, long start, long end, int ignoredId) {
+    if (!refreshSchedules()) return -1;
+    if (lawyerId < 0 || lawyerId >= lawyerSchedulesNumber) return 0;
+
+    return findOverlap(&lawyerSchedules[lawyerId], start, end, ignoredId);
+}
+
+/**
+ * Retorna, em ordem de início, os agendamentos de um cliente ou de um advogado que começam no intervalo [from, to). A
+ * busca desce o índice de agenda até o primeiro agendamento do intervalo e percorre apenas os agendamentos retornados,
+ * em O(log n + k).
+ * 
+ * @param const char *index: APPOINTMENT_CLIENT_INDEX ou APPOINTMENT_LAWYER_INDEX (ou APPOINTMENT_START_INDEX)
+ * @param int personId: Código do cliente ou do advogado (0 no índice de início)
+ * @param long from: Minutos desde 01/01/1970
+ * @param long to
+ * @param int *appointmentsNumber: Destino do número de agendamentos
+ * 
+ * @return Appointment*|NULL: Vetor de agendamentos, que deve ser liberado | NULL, se não houver agendamentos ou memória
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+Appointment* getAgenda(const char *index, int personId, long from, long to, int *appointmentsNumber) {
+    // As datas dos registros cabem em um int; um intervalo além desse limite é cortado, e não truncado
+    from = from < INT_MIN ? INT_MIN : from > INT_MAX ? INT_MAX : from;
+    to = to < INT_MIN ? INT_MIN : to > INT_MAX ? INT_MAX : to;
+    BPlusKey first = {personId, (int) from, 0}, last = {personId, (int) to, 0};
+    BPlusCursor cursor;
+    const BPlusKey *key;
+    Appointment *appointments = NULL;
+    int capacity = 0;
+
+    *appointmentsNumber = 0;
+    if (!seekBPlusTree(&cursor, index, &first, &last)) return NULL;
+
+    while ((key = nextBPlusKey(&cursor)) != NULL) {
+        if (*appointmentsNumber == capacity) {
+            int newCapacity = capacity > 0 ? capacity * 2 : 16;
+            Appointment *list = (Appointment*) realloc(appointments, newCapacity * sizeof(Appointment));
+            if (list == NULL) break;
+            appointments = list;
+            capacity = newCapacity;
+        }
+        if (readElementById(&appointments[*appointmentsNumber], sizeof(Appointment), key->id, "appointments.dat")) {
+            (*appointmentsNumber)++;
+        }
     }
-    free(office);
 
-    readStrField(date, "Data (dd/mm/aaaa)", 11, dateRules, 2);
-    readStrField(startTime, "Horário do início da consulta (hh:mm)", 6, hourRules, 2);
-    readStrField(endTime, "Horário do término da consulta (hh:mm)", 6, hourRules, 2);
-    loadDatetime(&appointment.startDate, date, startTime);
-    loadDatetime(&appointment.endDate, date, endTime);
+    return appointments;
+}
+
+/**
+ * Retorna, em ordem de início, todos os agendamentos que começam no intervalo [from, to), percorrendo apenas o trecho
+ * correspondente do índice de início, em O(log n + k)
+ * 
+ * @param long from: Minutos desde 01/01/1970
+ * @param long to
+ * @param int *appointmentsNumber: Destino do número de agendamentos
+ * 
+ * @return Appointment*|NULL: Vetor de agendamentos, que deve ser liberado | NULL, se não houver agendamentos ou memória
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+Appointment* getAppointmentsInRange(long from, long to, int *appointmentsNumber) {
+    return getAgenda(APPOINTMENT_START_INDEX, 0, from, to, appointmentsNumber);
+}
+
+/**
+ * Retorna uma série de agendamentos específica a partir de seu ID
+ * 
+ * @param int id: ID a ser procurado
+ * 
+ * @return AppointmentSeries*|NULL: Série correspondente ao ID | NULL, caso não encontre
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+AppointmentSeries* findSeries(int id) {
+    AppointmentSeries *series = (AppointmentSeries*) malloc(sizeof(AppointmentSeries));
+    if (series == NULL) return NULL;
+
+    if (!readElementById(series, sizeof(AppointmentSeries), id, "series.dat") || series->isDeleted) {
+        free(series);
+        return NULL;
+    }
+
+    return series;
+}
+
+/**
+ * Cadastra uma série de agendamentos no arquivo, como um único registro, e a guarda entre as séries ativas
+ * 
+ * @param AppointmentSeries *series: Série, que recebe o ID gerado
+ * 
+ * @return int: ID da série | 0, se houver alguma falha
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+int addSeries(AppointmentSeries *series) {
+    int id = addElementToFile(series, sizeof(AppointmentSeries), "series.dat");
+    if (id == 0) return 0;
+
+    series->id = id;
+    if (!series->isDeleted && !storeSeries(series)) invalidateSchedules();
+
+    return id;
+}
+
+/**
+ * Edita/atualiza uma série de agendamentos no arquivo (por exemplo, ao cancelar uma sessão ou excluir a série)
+ * 
+ * @param int id: ID da série
+ * @param AppointmentSeries *series
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool editSeries(int id, AppointmentSeries *series) {
+    if (!updateElementById(series, sizeof(AppointmentSeries), id, "series.dat")) return false;
+
+    if (series->isDeleted) forgetSeries(id);
+    else if (!storeSeries(series)) invalidateSchedules();
+
+    return true;
+}
+
+/**
+ * Procura uma série do advogado com alguma sessão que se sobreponha ao intervalo [start, end). Apenas as sessões do
+ * intervalo são calculadas.
+ * 
+ * @param int lawyerId
+ * @param long start: Início, em minutos desde 01/01/1970
+ * @param long end
+ * @param int ignoredId: ID de uma série a ser desconsiderada (0 para nenhuma)
+ * 
+ * @return int: ID da série conflitante | 0, caso o horário esteja livre | -1, se as séries em memória não puderem ser
+ * remontadas
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+int findSeriesConflict(int lawyerId, long start, long end, int ignoredId) {
+    long occurrence;
+    if (!refreshSchedules()) return -1;
+
+    for (int i = 0; i < seriesNumber; i++) {
+        const AppointmentSeries *series = &seriesList[i];
+        if (series->lawyerId != lawyerId || series->id == ignoredId) continue;
+        if (expandRecurrence(&series->recurrence, start, end, &occurrence, 1) > 0) return series->id;
+    }
+
+    return 0;
+}
+
+/**
+ * Retorna o índice de agendamentos agrupado pelo cadastro referenciado
+ * 
+ * @param AppointmentReference reference
+ * 
+ * @return const char*
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static const char* getReferenceIndex(AppointmentReference reference) {
+    if (reference == REFERENCE_CLIENT) return APPOINTMENT_CLIENT_INDEX;
+    if (reference == REFERENCE_LAWYER) return APPOINTMENT_LAWYER_INDEX;
+    return APPOINTMENT_OFFICE_INDEX;
+}
+
+/**
+ * Retorna o campo de um agendamento que guarda o código do cadastro referenciado
+ * 
+ * @param Appointment *appointment
+ * @param AppointmentReference reference
+ * 
+ * @return int*
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static int* getAppointmentReference(Appointment *appointment, AppointmentReference reference) {
+    if (reference == REFERENCE_CLIENT) return &appointment->clientId;
+    if (reference == REFERENCE_LAWYER) return &appointment->lawyerId;
+    return &appointment->officeId;
+}
+
+/**
+ * Retorna o campo de uma série que guarda o código do cadastro referenciado
+ * 
+ * @param AppointmentSeries *series
+ * @param AppointmentReference reference
+ * 
+ * @return int*
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static int* getSeriesReference(AppointmentSeries *series, AppointmentReference reference) {
+    if (reference == REFERENCE_CLIENT) return &series->clientId;
+    if (reference == REFERENCE_LAWYER) return &series->lawyerId;
+    return &series->officeId;
+}
+
+/**
+ * Lê os agendamentos ativos que referenciam um cadastro, percorrendo apenas o trecho do cadastro no seu índice, em
+ * O(log n + k)
+ * 
+ * @param AppointmentReference reference
+ * @param int id: Código do cadastro
+ * @param Appointment **appointments: Destino do vetor de agendamentos, que deve ser liberado
+ * @param int *appointmentsNumber: Destino do número de agendamentos
+ * 
+ * @return bool: Retorna false se não houver memória disponível ou se houver falha na leitura
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static bool getReferencingAppointments(AppointmentReference reference, int id, Appointment **appointments, int *appointmentsNumber) {
+    BPlusKey first = {id, INT_MIN, INT_MIN}, last = {id, INT_MAX, INT_MAX};
+    BPlusCursor cursor;
+    const BPlusKey *key;
+    int capacity = 0;
+
+    *appointments = NULL;
+    *appointmentsNumber = 0;
+    if (!seekBPlusTree(&cursor, getReferenceIndex(reference), &first, &last)) return true;
 
-    parseInt(clientId, &appointment.clientId);
-    parseInt(lawyerId, &appointment.lawyerId);
-    parseInt(officeId, &appointment.officeId);
-    appointment.isDeleted = false;
-    
-    bool status = addElementToFile(&appointment, sizeof(Appointment), "appointments.dat");
+    while ((key = nextBPlusKey(&cursor)) != NULL) {
+        if (*appointmentsNumber == capacity) {
+            int newCapacity = capacity > 0 ? capacity * 2 : 16;
+            Appointment *list = (Appointment*) realloc(*appointments, newCapacity * sizeof(Appointment));
+            if (list == NULL) return false;
+            *appointments = list;
+            capacity = newCapacity;
+        }
+        if (!readElementById(&(*appointments)[*appointmentsNumber], sizeof(Appointment), key->id, "appointments.dat")) return false;
+        (*appointmentsNumber)++;
+    }
 
-    printf("\n%s\n", status ? "Agendamento cadastrado com sucesso!\nPressione <Enter> para prosseguir..." : "Houve um erro ao cadastrar o agendamento!");
-    proceed();
+    return true;
 }
 
 /**
- * Lista todos os agendamentos do sistema
+ * Copia as séries ativas que referenciam um cadastro
  * 
- * @return void
+ * @param AppointmentReference reference
+ * @param int id: Código do cadastro
+ * @param AppointmentSeries **series: Destino do vetor de séries, que deve ser liberado
+ * @param int *referencesNumber: Destino do número de séries
+ * 
+ * @return bool: Retorna false se não houver memória disponível
  * 
  * Authors:
  *  - https://github.com/akemi-adam
  */
-void listAppointments() {
-    int count;
-    Appointment *appointments = getAppointments(&count);
-    
-    printf("---- Listar Agendamentos ----\n");
-    printf("------------------------------------------------------------------\n");
-    for (int i = 0; i < count; i++) {
-        if (!appointments[i].isDeleted) {
-            printf("ID: %d\nCódigo Cliente: %d\nCódigo Advogado: %d\nCódigo Escritório: %d\nData início: %s\nData término: %s\n", i + 1, appointments[i].clientId, appointments[i].lawyerId, appointments[i].officeId, appointments[i].startDate.date, appointments[i].endDate.date);
-            printf("------------------------------------------------------------------\n");
+static bool getReferencingSeries(AppointmentReference reference, int id, AppointmentSeries **series, int *referencesNumber) {
+    *series = NULL;
+    *referencesNumber = 0;
+
+    for (int i = 0; i < seriesNumber; i++) {
+        if (*getSeriesReference(&seriesList[i], reference) != id) continue;
+        if (*series == NULL) {
+            *series = (AppointmentSeries*) malloc(seriesNumber * sizeof(AppointmentSeries));
+            if (*series == NULL) return false;
         }
+        (*series)[(*referencesNumber)++] = seriesList[i];
     }
 
-    free(appointments);
-    
-    printf("Pressione <Enter> para prosseguir...\n");
-    proceed();
+    return true;
 }
 
 /**
- * Exibe os dados de um agendamento específico
+ * Conta os agendamentos e as séries ativos que referenciam um cliente, um advogado ou um escritório. Apenas as chaves
+ * do cadastro no índice são percorridas, sem ler os agendamentos.
  * 
- * @return void
+ * @param AppointmentReference reference
+ * @param int id: Código do cadastro
+ * 
+ * @return int
  * 
  * Authors:
  *  - https://github.com/akemi-adam
  */
-void readAppointment() {
-    int intId;
-    char id[6];
-    Validation idRules[3] = {validateRequired, validateNumber, validatePositive};
-    printf("---- Buscar Agendamento ----\n");
-    readStrField(id, "Código do Agendamento", 6, idRules, 3);
-    parseInt(id, &intId);
-    Appointment *appointment = findAppointment(intId);
+int countAppointmentReferences(AppointmentReference reference, int id) {
+    BPlusKey first = {id, INT_MIN, INT_MIN}, last = {id, INT_MAX, INT_MAX};
+    BPlusCursor cursor;
+    int references = 0;
 
-    if (appointment != NULL) {
-        printf("------------------------------------------------------------------\n");
-        printf("ID: %s\nCódigo Cliente: %d\nCódigo Advogado: %d\nCódigo Escritório: %d\nData início: %s\nData término: %s\n", id, appointment->clientId, appointment->lawyerId, appointment->officeId, appointment->startDate.date, appointment->endDate.date);
-        printf("------------------------------------------------------------------\n");
-        free(appointment);
-    } else {
-        printf("O código informado não corresponde a nenhum agendamento\n");
+    if (seekBPlusTree(&cursor, getReferenceIndex(reference), &first, &last)) {
+        while (nextBPlusKey(&cursor) != NULL) references++;
     }
-    printf("Pressione <Enter> para prosseguir...\n");
-    proceed();
+    for (int i = 0; i < seriesNumber; i++) {
+        if (*getSeriesReference(&seriesList[i], reference) == id) references++;
+    }
+
+    return references;
 }
 
 /**
- * Formulário para atualizar os dados de um agendamento específico
+ * Exclui os agendamentos e as séries ativos que referenciam um cliente, um advogado ou um escritório, em O(k) para os
+ * k agendamentos do cadastro. Deve ser chamada dentro de uma transação: as agendas em memória só são atualizadas por
+ * finishReferenceChanges, depois que ela for confirmada.
  * 
- * @return void
+ * @param AppointmentReference reference
+ * @param int id: Código do cadastro
+ * @param ReferenceChanges *changes: Destino dos agendamentos e das séries excluídos
+ * 
+ * @return bool: Retorna false se algum agendamento ou série não puder ser excluído
  * 
  * Authors:
  *  - https://github.com/akemi-adam
- * 
- * Obs.: Algumas melhorias podem ser feitas nessa função, como fazer uma função genérica para a verificação da foreign key. Outra melhoria é a atribuição das datas e sua atualização.
  */
-void updateAppointment() {
-    int tempId, intId;
-    char *date = (char*) malloc(sizeof(char)),
-        *startTime = (char*) malloc(sizeof(char)),
-        *endTime = (char*) malloc(sizeof(char));
+static bool cascadeAppointmentReferences(AppointmentReference reference, int id, ReferenceChanges *changes) {
+    bool status = getReferencingAppointments(reference, id, &changes->appointments, &changes->appointmentsNumber)
+        && getReferencingSeries(reference, id, &changes->series, &changes->seriesNumber);
 
-    char appointmentId[6], clientId[6], lawyerId[6], officeId[6];
+    for (int i = 0; status && i < changes->appointmentsNumber; i++) {
+        Appointment deleted = changes->appointments[i];
+        deleted.isDeleted = true;
+        status = writeAppointment(deleted.id, &changes->appointments[i], &deleted);
+    }
+    for (int i = 0; status && i < changes->seriesNumber; i++) {
+        AppointmentSeries deleted = changes->series[i];
+        deleted.isDeleted = true;
+        status = updateElementById(&deleted, sizeof(AppointmentSeries), deleted.id, "series.dat");
+    }
 
-    Validation idRules[3] = {validateRequired, validateNumber, validatePositive},
-        fkRules[2] = {validateNumber, validatePositive},
-        dateRules[1] = {validateDate},
-        hourRules[1] = {validateHour};
-    
-    printf("---- Atualizar Agendamento ----\n");
-    readStrField(appointmentId, "Código do Agendamento", 6, idRules, 3);
-    parseInt(appointmentId, &intId);
-    Appointment *appointment = findAppointment(intId);
+    return status;
+}
 
-    if (appointment != NULL) {
+/**
+ * Transfere para outro cadastro os agendamentos e as séries ativos que referenciam um cliente, um advogado ou um
+ * escritório. Cada horário aprovado já é ocupado no novo cadastro, para que os seguintes sejam verificados também
+ * contra os que estão sendo transferidos, e as gravações são feitas na transação de quem chama. Se a transação não
+ * for confirmada, finishReferenceChanges devolve as agendas ao estado anterior.
+ * 
+ * @param AppointmentReference reference
+ * @param int id: Código do cadastro
+ * @param int newId: Código do cadastro que recebe os agendamentos
+ * @param ReferenceChanges *changes: Destino dos agendamentos e das séries transferidos
+ * 
+ * @return bool: Retorna false se algum horário estiver ocupado ou se houver falha na gravação
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static bool reassignAppointmentReferences(AppointmentReference reference, int id, int newId, ReferenceChanges *changes) {
+    changes->isReassignment = true;
+    bool status = getReferencingAppointments(reference, id, &changes->appointments, &changes->appointmentsNumber)
+        && getReferencingSeries(reference, id, &changes->series, &changes->seriesNumber);
 
-        sprintf(clientId, "%d", appointment->clientId);
-        readStrField(clientId, "Código do Cliente", 6, fkRules, 2);
-        if (parseInt(clientId, &tempId)) {
-            Client *client = findClient(tempId);
-            if (client == NULL) {
-                free(client);
-                free(date);
-                free(startTime);
-                free(endTime);
-                printf("Cliente não encontrado!\n");
-                proceed();
-                return;
-            }
-            free(client);
-        }
+    if (status && changes->appointmentsNumber > 0) {
+        changes->moved = (Appointment*) malloc(changes->appointmentsNumber * sizeof(Appointment));
+        status = changes->moved != NULL;
+    }
 
-        sprintf(lawyerId, "%d", appointment->lawyerId);
-        readStrField(lawyerId, "Código do Advogado", 6, fkRules, 2);
-        if (parseInt(lawyerId, &tempId)) {
-            Lawyer *lawyer = findLawyer(tempId);
-            if (lawyer == NULL) {
-                free(lawyer);
-                free(date);
-                free(startTime);
-                free(endTime);
-                printf("Advogado não encontrado!\n");
-                proceed();
-                return;
-            }
-            free(lawyer);
+    for (int i = 0; status && i < changes->appointmentsNumber; i++) {
+        Appointment *appointment = &changes->appointments[i], *moved = &changes->moved[i];
+        *moved = *appointment;
+        *getAppointmentReference(moved, reference) = newId;
+        if (!checkAppointmentTime(moved, appointment)) {
+            printf("O agendamento %d não pode ser transferido\n", appointment->id);
+            status = false;
+            break;
         }
 
-        sprintf(officeId, "%d", appointment->officeId);
-        readStrField(officeId, "Código do Escritório", 6, fkRules, 2);
-        if (parseInt(officeId, &tempId)) {
-            Office *office = findOffice(tempId);
-            if (office == NULL) {
-                free(office);
-                free(date);
-                free(startTime);
-                free(endTime);
-                printf("Escritório não encontrado!\n");
-                proceed();
-                return;
-            }
-            free(office);
+        unscheduleAppointment(appointment->id, appointment);
+        if (!scheduleAppointment(moved->id, moved)) {
+            scheduleAppointment(appointment->id, appointment);
+            status = false;
+            break;
         }
+        changes->appointmentsMoved++;
+    }
+    // A série sai da memória durante a verificação, para que as suas próprias sessões não sejam contadas como conflito,
+    // e volta já no novo cadastro
+    for (int i = 0; status && i < changes->seriesNumber; i++) {
+        AppointmentSeries target = changes->series[i];
+        *getSeriesReference(&target, reference) = newId;
+        forgetSeries(target.id);
+        if (!checkSeriesTime(&target)) {
+            printf("A série %d não pode ser transferida\n", target.id);
+            storeSeries(&changes->series[i]);
+            status = false;
+            break;
+        }
+        storeSeries(&target);
+        changes->seriesMoved++;
+    }
 
-        printf("apenas data: %s\n", appointment->startDate.onlyDate);
-        readStrField(appointment->startDate.onlyDate, "Data (dd/mm/aaaa)", 11, dateRules, 1);
-        strcpy(date, appointment->startDate.onlyDate);
+    for (int i = 0; status && i < changes->appointmentsNumber; i++) {
+        status = writeAppointment(changes->moved[i].id, &changes->appointments[i], &changes->moved[i]);
+    }
+    for (int i = 0; status && i < changes->seriesNumber; i++) {
+        AppointmentSeries target = changes->series[i];
+        *getSeriesReference(&target, reference) = newId;
+        status = updateElementById(&target, sizeof(AppointmentSeries), target.id, "series.dat");
+    }
 
-        readStrField(appointment->startDate.time, "Horário do início da consulta (hh:mm)", 6, hourRules, 1);
-        strcpy(startTime, appointment->startDate.time);
+    return status;
+}
 
-        readStrField(appointment->endDate.time, "Horário do término da consulta (hh:mm)", 6, hourRules, 1);
-        strcpy(endTime, appointment->endDate.time);
+/**
+ * Conclui, nas agendas em memória, as alterações feitas nos agendamentos e nas séries de um cadastro excluído. Se a
+ * transação foi confirmada, os agendamentos e as séries excluídos saem das agendas; se não foi, os transferidos voltam
+ * ao cadastro original. Em seguida, libera os vetores das alterações.
+ * 
+ * @param ReferenceChanges *changes
+ * @param bool isCommitted: Indica se a transação da exclusão foi confirmada
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static void finishReferenceChanges(ReferenceChanges *changes, bool isCommitted) {
+    if (changes->isReassignment && !isCommitted) {
+        bool isRestored = true;
+        for (int i = 0; i < changes->appointmentsMoved; i++) {
+            unscheduleAppointment(changes->moved[i].id, &changes->moved[i]);
+            isRestored = scheduleAppointment(changes->appointments[i].id, &changes->appointments[i]) && isRestored;
+        }
+        for (int i = 0; i < changes->seriesMoved; i++) isRestored = storeSeries(&changes->series[i]) && isRestored;
+        if (!isRestored) invalidateSchedules();
+    } else if (!changes->isReassignment && isCommitted) {
+        for (int i = 0; i < changes->appointmentsNumber; i++) unscheduleAppointment(changes->appointments[i].id, &changes->appointments[i]);
+        for (int i = 0; i < changes->seriesNumber; i++) forgetSeries(changes->series[i].id);
+    }
 
-        printf("Data: %s, start: %s, end: %s", date, startTime, endTime);
+    free(changes->appointments);
+    free(changes->moved);
+    free(changes->series);
+}
 
-        loadDatetime(&appointment->startDate, date, startTime);
-        loadDatetime(&appointment->endDate, date, endTime);
+/**
+ * Exclui um cliente, um advogado ou um escritório junto com os seus agendamentos e séries ativos, em uma única
+ * transação: os agendamentos são excluídos ou transferidos e o cadastro é marcado como excluído, ou nada é alterado.
+ * As agendas em memória só são atualizadas depois que a transação termina.
+ * 
+ * @param AppointmentReference reference
+ * @param int id: Código do cadastro
+ * @param ReferenceAction action: REFERENCE_BLOCK exclui o cadastro apenas se ele não tiver agendamentos ativos;
+ * REFERENCE_CASCADE exclui os agendamentos; REFERENCE_REASSIGN os transfere para newId
+ * @param int newId: Código do cadastro que recebe os agendamentos, em REFERENCE_REASSIGN
+ * @param bool (*deleteRecord)(int): Marca o cadastro como excluído, dentro da transação
+ * 
+ * @return bool: Retorna false se o cadastro não puder ser excluído ou se houver falha na gravação
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool deleteReferencedRecord(AppointmentReference reference, int id, ReferenceAction action, int newId, bool (*deleteRecord)(int)) {
+    ReferenceChanges changes;
+    memset(&changes, 0, sizeof(ReferenceChanges));
 
-        parseInt(clientId, &appointment->clientId);
-        parseInt(lawyerId, &appointment->lawyerId);
-        parseInt(officeId, &appointment->officeId);
+    beginTransaction();
+    bool status = action == REFERENCE_CASCADE ? cascadeAppointmentReferences(reference, id, &changes)
+        : action == REFERENCE_REASSIGN ? reassignAppointmentReferences(reference, id, newId, &changes)
+        : countAppointmentReferences(reference, id) == 0;
+    status = status && deleteRecord(id) && commitTransaction();
+    if (!status) rollbackTransaction();
 
-        editAppointments(intId, appointment);
-        free(appointment);
+    finishReferenceChanges(&changes, status);
+    return status;
+}
 
-        printf("Agendamento editado com sucesso!\n");
-    } else {
-        printf("O código informado não corresponde a nenhum agendamento\n");
-    }
+/**
+ * Retorna quantas salas do escritório continuam livres durante todo o intervalo [start, end), contando as sessões
+ * das séries de agendamentos no intervalo
+ * 
+ * @param int officeId
+ * @param long start: Início, em minutos desde 01/01/1970
+ * @param long end
+ * 
+ * @return int
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+int getOfficeFreeRooms(int officeId, long start, long end) {
+    if (!refreshSchedules() || applySeriesWindow(start, end, true, -1) < 0) return 0;
 
-    free(date);
-    free(startTime);
-    free(endTime);
+    int freeRooms = officeId >= 0 && officeId < officeOccupanciesNumber
+        ? getFreeCapacity(&officeOccupancies[officeId], start, end, roomCapacity)
+        : roomCapacity;
 
-    printf("\nPressione <Enter> para prosseguir...\n");
-    proceed();
+    applySeriesWindow(start, end, false, -1);
+    return freeRooms;
 }
 
 /**
- * Deleta um agendamento
+ * Procura os primeiros horários, sem sobreposição entre si, em que o advogado, o cliente e uma sala do escritório estão
+ * livres ao mesmo tempo. As sessões das séries de agendamentos na janela são ocupadas durante a busca. Em cada dia da
+ * janela, os mapas de faixas ocupadas dos três são combinados com um OU bit a bit e as sequências de faixas livres são
+ * procuradas dentro do expediente.
  * 
- * @return void
+ * @param int clientId
+ * @param int lawyerId
+ * @param int officeId
+ * @param int duration: Duração do agendamento, em minutos
+ * @param long from: Primeiro dia da janela e horário de início do expediente, em minutos desde 01/01/1970
+ * @param long to: Último dia da janela e horário de término do expediente
+ * @param long *slots: Destino do início de cada horário, em minutos desde 01/01/1970
+ * @param int maxSlots: Número máximo de horários
+ * 
+ * @return int: Número de horários encontrados
  * 
  * Authors:
  *  - https://github.com/akemi-adam
  */
-void deleteAppointment() {
-    int intId;
-    char id[6];
-    Validation idRules[3] = {validateRequired, validateNumber, validatePositive};
+int findAvailableSlots(int clientId, int lawyerId, int officeId, int duration, long from, long to, long *slots, int maxSlots) {
+    long firstDay = minutesToDays(from), lastDay = minutesToDays(to);
+    long windowStart = firstDay * MINUTES_PER_DAY, windowEnd = (lastDay + 1) * MINUTES_PER_DAY;
+    if (!refreshSchedules() || applySeriesWindow(windowStart, windowEnd, true, -1) < 0) return 0;
 
-    printf("---- Deletar Agendamento ----\n");
-    readStrField(id, "Código do Agendamento", 6, idRules, 3);
-    parseInt(id, &intId);
-    Appointment *appointment = findAppointment(intId);
+    const Occupancy empty = {NULL, 0, 0};
+    const Occupancy *office = officeId >= 0 && officeId < officeOccupanciesNumber ? &officeOccupancies[officeId] : &empty,
+        *lawyer = lawyerId >= 0 && lawyerId < lawyerOccupanciesNumber ? &lawyerOccupancies[lawyerId] : &empty,
+        *client = clientId >= 0 && clientId < clientOccupanciesNumber ? &clientOccupancies[clientId] : &empty;
 
-    if (appointment != NULL) {
-        appointment->isDeleted = true;
-        editAppointments(intId, appointment);
-        free(appointment);
-        printf("Agendamento deletado com sucesso!\n");
-    } else {
-        printf("O código informado não corresponde a nenhum agendamento\n");
+    int firstSlot = (getMinuteOfDay(from) + OCCUPANCY_SLOT_MINUTES - 1) / OCCUPANCY_SLOT_MINUTES,
+        lastSlot = getMinuteOfDay(to) / OCCUPANCY_SLOT_MINUTES,
+        length = (duration + OCCUPANCY_SLOT_MINUTES - 1) / OCCUPANCY_SLOT_MINUTES,
+        starts[OCCUPANCY_DAY_SLOTS], slotsNumber = 0;
+
+    for (long day = firstDay; day <= lastDay && slotsNumber < maxSlots; day++) {
+        uint64_t busy[OCCUPANCY_WORDS], full[OCCUPANCY_WORDS];
+
+        getFullSlots(office, day, roomCapacity, busy);
+        getFullSlots(lawyer, day, 1, full);
+        for (int i = 0; i < OCCUPANCY_WORDS; i++) busy[i] |= full[i];
+        getFullSlots(client, day, 1, full);
+        for (int i = 0; i < OCCUPANCY_WORDS; i++) busy[i] |= full[i];
+
+        int startsNumber = findFreeRuns(busy, firstSlot, lastSlot, length, starts, maxSlots - slotsNumber);
+        for (int i = 0; i < startsNumber; i++) slots[slotsNumber++] = day * MINUTES_PER_DAY + (long) starts[i] * OCCUPANCY_SLOT_MINUTES;
     }
 
-    printf("Pressione <Enter> para prosseguir...\n");
-    proceed();
+    applySeriesWindow(windowStart, windowEnd, false, -1);
+    return slotsNumber;
 }
 
 /**
- * Exibe o menu do módulo agendamento e que pede para o usuário selecionar uma opção
+ * Configura o número de salas de cada escritório a partir de um texto (como a variável SIGLAW_ROOM_CAPACITY). Um texto
+ * vazio mantém o valor padrão, OFFICE_ROOM_CAPACITY.
  * 
- * @return void
+ * @param const char *config: Número de salas, de 1 a OCCUPANCY_MAX_CAPACITY
+ * 
+ * @return bool: Retorna false se o texto não for um número de salas válido
  * 
  * Authors:
  *  - https://github.com/akemi-adam
  */
-void showAppointmentMenu() {
-    #ifdef __unix__
-        struct termios originalTerminal;
-        tcgetattr(STDIN_FILENO, &originalTerminal);
-    #endif
-    int option = 0, size = 6;
-    bool isSelected = false, loop = true;
-    char optionsStyles[size][11];
-    char options[6][30] = {
-        "1. Cadastrar Agendamento", "2. Mostrar Agendamentos", "3. Achar Agendamento",
-        "4. Editar Agendamento", "5. Excluir Agendamento", "6. Voltar"
-    };
-    void (*actions[])() = {
-        createAppointment, listAppointments, readAppointment, updateAppointment, deleteAppointment
-    };
-    setOptionsStyle(optionsStyles, size);
-    while (loop) {
-        #ifdef __unix__
-            system("clear");
-            enableRawMode();
-        #else
-            system("cls");
-        #endif
-        if (!isSelected) {
-            showOptions("Menu Agendamento", options, optionsStyles, size);
-            strcpy(optionsStyles[option], RESET_STYLE);
-            selectOption(&option, size - 1, &isSelected);
-            strcpy(optionsStyles[option], CYAN_STYLE);
-        } else {
-           #ifdef __unix__
-                disableRawMode(&originalTerminal);
-            #endif
-            isSelected = false;
-            if (option >= 0 && option <= (size - 2)) {
-                actions[option]();
-            } else {
-                loop = false;
-            }
-        }
-    }
+bool configureRoomCapacity(const char *config) {
+    int capacity;
+    if (config == NULL || *config == '\0') return true;
+    if (!parseInt(config, &capacity) || capacity < 1 || capacity > OCCUPANCY_MAX_CAPACITY) return false;
+
+    roomCapacity = capacity;
+    return true;
 }
 
 /**
- * Retorna uma lista contendo todos os agendamentos
+ * Converte uma data do layout antigo para minutos desde 01/01/1970. Os textos são usados quando válidos, já que os
+ * campos numéricos podiam ser gravados com lixo por versões antigas de loadDatetime.
  * 
- * @param int *officesNumber: Número de agendamentos cadastrados
+ * @param const LegacyDatetime *legacy
+ * @param int *minutes: Destino da conversão
  * 
- * @return Office*: endereço da lista de agendamentos
+ * @return bool: Retorna false se nem os textos nem os campos numéricos formarem uma data que caiba no registro
  * 
  * Authors:
  *  - https://github.com/akemi-adam
  */
-Appointment* getAppointments(int *officesNumber) {
-    const size_t structSize = sizeof(Appointment);
-    *officesNumber = getNumberOfElements("appointments.dat", structSize);
-    Appointment *appointments = (Appointment*) malloc(structSize * (*officesNumber));
-    readFile(appointments, structSize, *officesNumber, "appointments.dat");
+static bool convertLegacyDatetime(const LegacyDatetime *legacy, int *minutes) {
+    char date[DATE_SIZE], time[TIME_SIZE];
+    Datetime datetime = {legacy->day, legacy->month, legacy->year, legacy->hour, legacy->minute};
 
-    return appointments;
+    memcpy(date, legacy->onlyDate, DATE_SIZE);
+    memcpy(time, legacy->time, TIME_SIZE);
+    date[DATE_SIZE - 1] = '\0';
+    time[TIME_SIZE - 1] = '\0';
+    if (strlen(date) == DATE_SIZE - 1 && strlen(time) == TIME_SIZE - 1 && parseDatetime(date, time, minutes)) return true;
+
+    return datetimeToStoredMinutes(&datetime, minutes);
 }
 
 /**
- * Retorna um agendamento específico a partir de seu ID
+ * Converte um agendamento do layout antigo para o atual
  * 
- * @param const char *id: ID a ser procurado
+ * @param const void *oldElement: LegacyAppointment
+ * @param void *newElement: Appointment
  * 
- * @return Appointment*|NULL: Agendamento correspondente ao ID | NULL, caso não encontre
+ * @return void
  * 
  * Authors:
  *  - https://github.com/akemi-adam
  */
-Appointment* findAppointment(int id) {
-    int count;
-    id--;
+static void convertLegacyAppointment(const void *oldElement, void *newElement) {
+    const LegacyAppointment *legacy = (const LegacyAppointment*) oldElement;
+    Appointment *appointment = (Appointment*) newElement;
 
-    Appointment* appointments = getAppointments(&count);
-    if (!appointments || id < 0 || id >= count) {
-        free(appointments);
-        return NULL;
+    appointment->id = legacy->id;
+    appointment->clientId = legacy->clientId;
+    appointment->lawyerId = legacy->lawyerId;
+    appointment->officeId = legacy->officeId;
+    // Um agendamento sem datas aproveitáveis fica em 01/01/1970, sem duração, para ser corrigido ou excluído
+    if (!convertLegacyDatetime(&legacy->startDate, &appointment->startDate) || !convertLegacyDatetime(&legacy->endDate, &appointment->endDate)) {
+        appointment->startDate = 0;
+        appointment->endDate = 0;
     }
+    appointment->isDeleted = legacy->isDeleted;
+}
 
-    if (appointments[id].isDeleted) {
-        free(appointments);
-        return NULL;
+/**
+ * Abre e mapeia os arquivos de agendamentos e de séries de agendamentos em memória para o restante da sessão, junto
+ * com os índices de agendamentos, monta as agendas e as ocupações dos advogados, clientes e escritórios e carrega as
+ * séries ativas. Arquivos gravados no layout antigo, com as datas em texto, são convertidos antes.
+ * 
+ * @return bool: Retorna false se o arquivo tiver um layout incompatível ou se houver alguma falha ao mapeá-lo
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool openAppointmentTable() {
+    if (!migrateFile("appointments.dat", sizeof(LegacyAppointment), sizeof(Appointment), convertLegacyAppointment)) return false;
+    if (!openFile("appointments.dat", sizeof(Appointment), offsetof(Appointment, id), offsetof(Appointment, isDeleted))) {
+        return false;
     }
 
-    Appointment* appointment = (Appointment*) malloc(sizeof(Appointment));
-
-    *appointment = appointments[id];
-    free(appointments);
+    for (int i = 0; i < APPOINTMENT_INDEXES_NUMBER; i++) {
+        if (!openBPlusTree(APPOINTMENT_INDEXES[i].filename, "appointments.dat", sizeof(Appointment), APPOINTMENT_INDEXES[i].getKey)) {
+            return false;
+        }
+    }
+    if (!openFile("series.dat", sizeof(AppointmentSeries), offsetof(AppointmentSeries, id), offsetof(AppointmentSeries, isDeleted))) {
+        return false;
+    }
 
-    return appointment;
+    isScheduleStale = !loadSchedules();
+    return !isScheduleStale;
 }
 
-
 /**
- * Edita/atualiza a lista de agendamentos no arquivo
- * 
- * @param int id: ID do agendamento
- * @param Appointment *appointment: Agendamento
+ * Libera as agendas dos advogados, as ocupações dos advogados, clientes e escritórios e as séries em memória
  * 
  * @return void
  * 
  * Authors:
  *  - https://github.com/akemi-adam
  */
-void editAppointments(int id, Appointment *appointment) {
-    int count;
-    Appointment *appointments = getAppointments(&count);
-    appointments[id - 1] = *appointment;
-    saveFile(appointments, sizeof(Appointment), count, "appointments.dat");
-    free(appointments);
+void closeAppointmentTable() {
+    for (int i = 0; i < lawyerSchedulesNumber; i++) freeIntervalTree(&lawyerSchedules[i]);
+    free(lawyerSchedules);
+    lawyerSchedules = NULL;
+    lawyerSchedulesNumber = 0;
+
+    freeOccupancies(&officeOccupancies, &officeOccupanciesNumber);
+    freeOccupancies(&lawyerOccupancies, &lawyerOccupanciesNumber);
+    freeOccupancies(&clientOccupancies, &clientOccupanciesNumber);
+
+    free(seriesList);
+    seriesList = NULL;
+    seriesNumber = 0;
+    seriesCapacity = 0;
+}
+
+/**
+ * Compacta os arquivos de agendamentos e de séries, removendo os registros excluídos sem alterar os códigos dos demais,
+ * e recria os índices de agendamentos sem as folhas esvaziadas pelas exclusões e remarcações
+ * 
+ * @return int: Número de agendamentos e séries removidos | -1, se houver alguma falha
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+int compactAppointmentTable() {
+    int appointments = compactFile("appointments.dat", sizeof(Appointment)),
+        series = compactFile("series.dat", sizeof(AppointmentSeries));
+    if (appointments < 0 || series < 0) return -1;
+
+    for (int i = 0; i < APPOINTMENT_INDEXES_NUMBER; i++) {
+        if (!compactBPlusTree(APPOINTMENT_INDEXES[i].filename, "appointments.dat", sizeof(Appointment), APPOINTMENT_INDEXES[i].getKey)) {
+            return -1;
+        }
+    }
+
+    return appointments + series;
 }
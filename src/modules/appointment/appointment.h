@@ -3,17 +3,63 @@
 
 #include <stdbool.h>
 #include "./../../utils/date.h"
+#include "./../../utils/recurrence.h"
 
+#define OFFICE_ROOM_CAPACITY 1
+#define FREE_SLOTS_MAX 20
+#define SERIES_OCCURRENCES_CHUNK 64
+#define APPOINTMENT_CLIENT_INDEX "appointments.client.idx"
+#define APPOINTMENT_LAWYER_INDEX "appointments.lawyer.idx"
+#define APPOINTMENT_OFFICE_INDEX "appointments.office.idx"
+#define APPOINTMENT_START_INDEX "appointments.start.idx"
+
+/**
+ * Agendamento. As datas de início e de término são armazenadas em minutos desde 01/01/1970 00:00 e só são convertidas
+ * em texto para exibição.
+ */
 typedef struct Appointment {
     int id;
     int clientId;
     int lawyerId;
     int officeId;
-    Datetime startDate;
-    Datetime endDate;
+    int startDate;
+    int endDate;
     bool isDeleted;
 } Appointment;
 
+/**
+ * Cadastro referenciado pelos agendamentos e pelas séries
+ */
+typedef enum AppointmentReference {
+    REFERENCE_CLIENT = 1,
+    REFERENCE_LAWYER,
+    REFERENCE_OFFICE
+} AppointmentReference;
+
+/**
+ * O que fazer com os agendamentos e as séries de um cadastro excluído, na ordem das opções do formulário de exclusão:
+ * impedir a exclusão enquanto houver agendamentos ativos, excluí-los ou transferi-los para outro cadastro
+ */
+typedef enum ReferenceAction {
+    REFERENCE_BLOCK = 1,
+    REFERENCE_CASCADE,
+    REFERENCE_REASSIGN
+} ReferenceAction;
+
+/**
+ * Série de agendamentos recorrentes (como uma consulta semanal), armazenada como um único registro com a regra de
+ * repetição e as sessões canceladas. As sessões não são gravadas em appointments.dat: elas são calculadas apenas para o
+ * período exibido ou verificado.
+ */
+typedef struct AppointmentSeries {
+    int id;
+    int clientId;
+    int lawyerId;
+    int officeId;
+    Recurrence recurrence;
+    bool isDeleted;
+} AppointmentSeries;
+
 void showAppointmentMenu(void);
 
 void createAppointment(void);
@@ -26,10 +72,58 @@ void updateAppointment(void);
 
 void deleteAppointment(void);
 
-Appointment* getAppointments(int*);
+void searchFreeSlots(void);
+
+void showSeriesMenu(void);
+
+void createSeries(void);
+
+void listSeriesOccurrences(void);
+
+void cancelSeriesOccurrence(void);
+
+void deleteSeries(void);
+
+void showAgenda(void);
+
+void listAppointmentsInRange(void);
 
 Appointment* findAppointment(int);
 
-void editAppointments(int, Appointment*);
+int addAppointment(Appointment*);
+
+bool editAppointments(int, Appointment*);
+
+int findLawyerConflict(int, long, long, int);
+
+Appointment* getAgenda(const char*, int, long, long, int*);
+
+Appointment* getAppointmentsInRange(long, long, int*);
+
+int countAppointmentReferences(AppointmentReference, int);
+
+bool deleteReferencedRecord(AppointmentReference, int, ReferenceAction, int, bool (*)(int));
+
+bool readReferenceAction(AppointmentReference, int, ReferenceAction*, int*);
+
+AppointmentSeries* findSeries(int);
+
+int addSeries(AppointmentSeries*);
+
+bool editSeries(int, AppointmentSeries*);
+
+int findSeriesConflict(int, long, long, int);
+
+int getOfficeFreeRooms(int, long, long);
+
+int findAvailableSlots(int, int, int, int, long, long, long*, int);
+
+bool configureRoomCapacity(const char*);
+
+bool openAppointmentTable(void);
+
+void closeAppointmentTable(void);
+
+int compactAppointmentTable(void);
 
 #endif
\ No newline at end of file
@@ -2,11 +2,16 @@
 #include <stdbool.h>
 #include <string.h>
 #include <stdlib.h>
+#include <stddef.h>
 #include "./../../utils/interfaces.h"
 #include "./../../utils/validation.h"
 #include "./../../utils/storage.h"
 #include "./../../utils/str.h"
+#include "./../../utils/hashindex.h"
+#include "./../../utils/trigram.h"
+#include "./../../utils/fuzzy.h"
 #include "./../person/person.h"
+#include "./../appointment/appointment.h"
 #include "client.h"
 
 #ifdef __unix__
@@ -35,13 +40,22 @@ void createClient() {
     printf("---- Cadastrar Cliente ----\n");
     readStrField(client.person.name, "Nome", 55, nameRules, 2);
     readStrField(client.person.cpf, "CPF", 12, cpfRules, 2);
+    if (isClientCpfTaken(client.person.cpf, 0)) {
+        printf("\nJá existe um cliente cadastrado com este CPF!\nPressione <Enter> para prosseguir...\n");
+        proceed();
+        return;
+    }
     readStrField(client.person.email, "E-mail", 55, emailRules, 2);
     readStrField(client.person.telephone, "Telefone", 14, telephoneRules, 2);
     client.isDeleted = false;
 
-    bool status = addElementToFile(&client, sizeof(Client), "clients.dat");
+    int id = addClient(&client);
 
-    printf("\n%s\n", status ? "Cliente cadastrado com sucesso!\nPressione <Enter> para prosseguir..." : "Houve um erro ao cadastrar o cliente!");
+    if (id > 0) {
+        printf("\nCliente cadastrado com sucesso! Código: %d\nPressione <Enter> para prosseguir...\n", id);
+    } else {
+        printf("\nHouve um erro ao cadastrar o cliente!\n");
+    }
     proceed();
 }
 
@@ -54,19 +68,19 @@ void createClient() {
  *  - https://github.com/zfelip
  */
 void listClients() {
-    int count;
-    Client *clients = getClients(&count);
+    Cursor cursor;
+    const Client *client;
 
     printf("---- Listar Clientes ----\n");
     printf("------------------------------------------------------------------\n");
-    for (int i = 0; i < count; i++) {
-        if (!clients[i].isDeleted) {
-            printf("ID: %d\nNome: %s\nCPF: %s\nE-mail: %s\nTelefone: %s\n", i + 1, clients[i].person.name, clients[i].person.cpf, clients[i].person.email, clients[i].person.telephone);
+    if (openCursor(&cursor, "clients.dat", sizeof(Client), true)) {
+        while ((client = nextElement(&cursor)) != NULL) {
+            printf("ID: %d\nNome: %s\nCPF: %s\nE-mail: %s\nTelefone: %s\n", client->id, client->person.name, client->person.cpf, client->person.email, client->person.telephone);
             printf("------------------------------------------------------------------\n");
         }
+        closeCursor(&cursor);
     }
 
-    free(clients);
     printf("Pressione <Enter> para prosseguir...\n");
     proceed();
 }
@@ -101,6 +115,78 @@ void readClient() {
     proceed();
 }
 
+/**
+ * Exibe os dados de um cliente a partir do seu CPF, consultando o índice de CPF
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+void readClientByCpf() {
+    char cpf[12] = "";
+    Validation cpfRules[2] = {validateRequired, validateCpf};
+    printf("---- Buscar Cliente por CPF ----\n");
+    readStrField(cpf, "CPF", 12, cpfRules, 2);
+    Client *client = findClientByCpf(cpf);
+
+    if (client != NULL) {
+        printf("------------------------------------------------------------------\n");
+        printf("ID: %d\nNome: %s\nCPF: %s\nE-mail: %s\nTelefone: %s\n", client->id, client->person.name, client->person.cpf, client->person.email, client->person.telephone);
+        printf("------------------------------------------------------------------\n");
+        free(client);
+    } else {
+        printf("O CPF informado não corresponde a nenhum cliente\n");
+    }
+
+    printf("Pressione <Enter> para prosseguir...\n");
+    proceed();
+}
+
+/**
+ * Formulário para buscar clientes por parte do nome, sem diferenciar acentos nem maiúsculas. Se nenhum nome contiver o
+ * texto informado, exibe os clientes com os nomes mais parecidos
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+void readClientByName() {
+    char name[55] = "";
+    int ids[PERSON_SEARCH_MAX];
+    bool isTruncated = false;
+    Validation nameRules[1] = {validateRequired};
+    printf("---- Buscar Cliente por Nome ----\n");
+    readStrField(name, "Nome (ou parte do nome)", 55, nameRules, 1);
+    int idsNumber = findClientsByName(name, ids, PERSON_SEARCH_MAX, &isTruncated);
+    if (idsNumber == 0) {
+        // Sem nomes que contenham o texto informado, procura nomes parecidos, como os digitados com erros
+        idsNumber = findClientsBySimilarName(name, ids, PERSON_SEARCH_MAX);
+        if (idsNumber > 0) printf("Nenhum cliente tem exatamente este nome. Nomes parecidos:\n");
+        else idsNumber = 0;
+    }
+
+    if (idsNumber < 0) {
+        printf("Informe ao menos %d letras do nome\n", TRIGRAM_MIN_QUERY);
+    } else if (idsNumber == 0) {
+        printf("O nome informado não corresponde a nenhum cliente\n");
+    } else {
+        printf("------------------------------------------------------------------\n");
+        for (int i = 0; i < idsNumber; i++) {
+            Client *client = findClient(ids[i]);
+            if (client == NULL) continue;
+            printf("ID: %d\nNome: %s\nCPF: %s\nE-mail: %s\nTelefone: %s\n", client->id, client->person.name, client->person.cpf, client->person.email, client->person.telephone);
+            printf("------------------------------------------------------------------\n");
+            free(client);
+        }
+        if (isTruncated) printf("Há muitos clientes com este nome e nem todos foram conferidos; informe mais letras para refinar a busca\n");
+    }
+
+    printf("Pressione <Enter> para prosseguir...\n");
+    proceed();
+}
+
 /**
  * Formulário para atualizar os dados de um cliente específico
  * 
@@ -129,10 +215,14 @@ void updateClient() {
         readStrField(client->person.email, "E-mail", 55, emailRules, 1);
         readStrField(client->person.telephone, "Telefone", 14, telephoneRules, 1);
 
-        editClients(intId, client);
+        if (isClientCpfTaken(client->person.cpf, intId)) {
+            printf("\nJá existe um cliente cadastrado com este CPF!\n");
+        } else if (editClients(intId, client)) {
+            printf("\nCliente editado com sucesso!\n");
+        } else {
+            printf("\nHouve um erro ao editar o cliente!\n");
+        }
         free(client);
-
-        printf("\nCliente editado com sucesso!\n");
     } else {
         printf("O código informado não corresponde a nenhum cliente\n");
     }
@@ -141,6 +231,26 @@ void updateClient() {
     proceed();
 }
 
+/**
+ * Marca um cliente como excluído, dentro da transação em que os seus agendamentos são resolvidos
+ * 
+ * @param int id: Código do cliente
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static bool markClientDeleted(int id) {
+    Client *client = findClient(id);
+    if (client == NULL) return false;
+
+    client->isDeleted = true;
+    bool status = editClients(id, client);
+    free(client);
+    return status;
+}
+
 /**
  * Deleta um cliente do sistema
  * 
@@ -160,10 +270,14 @@ void deleteClient() {
     Client *client = findClient(intId);
 
     if (client != NULL) {
-        client->isDeleted = true;
-        editClients(intId, client);
+        ReferenceAction action;
+        int newId;
+        if (readReferenceAction(REFERENCE_CLIENT, intId, &action, &newId)) {
+            printf("%s\n", deleteReferencedRecord(REFERENCE_CLIENT, intId, action, newId, markClientDeleted) ? "Cliente deletado com sucesso!" : "Houve um erro ao deletar o cliente!");
+        } else {
+            printf("O cliente não foi deletado\n");
+        }
         free(client);
-        printf("Cliente deletado com sucesso!\n");
     } else {
         printf("O código informado não corresponde a nenhum cliente\n");
     }
@@ -185,15 +299,15 @@ void showClientMenu() {
         struct termios originalTerminal;
         tcgetattr(STDIN_FILENO, &originalTerminal);
     #endif
-    int option = 0, size = 6;
+    int option = 0, size = 8;
     bool isSelected = false, loop = true;
     char optionsStyles[size][11];
-    char options[6][30] = {
-        "1. Cadastrar Cliente", "2. Mostrar Clientes", "3. Achar Cliente",
-        "4. Editar Cliente", "5. Excluir Cliente", "6. Voltar"
+    char options[8][30] = {
+        "1. Cadastrar Cliente", "2. Mostrar Clientes", "3. Achar Cliente", "4. Achar Cliente por CPF",
+        "5. Achar Cliente por Nome", "6. Editar Cliente", "7. Excluir Cliente", "8. Voltar"
     };
     void (*actions[])() = {
-        createClient, listClients, readClient, updateClient, deleteClient
+        createClient, listClients, readClient, readClientByCpf, readClientByName, updateClient, deleteClient
     };
     setOptionsStyle(optionsStyles, size);
     while (loop) {
@@ -223,73 +337,197 @@ void showClientMenu() {
 }
 
 /**
- * Retorna uma lista contendo todos os clientes
+ * Retorna um cliente específico a partir de seu ID
  * 
- * @param int *officesNumber: Número de clientes cadastrados
+ * @param const char *id: ID a ser procurado
  * 
- * @return Office*: endereço da lista de clientes
+ * @return Client*|NULL: Cliente correspondente ao ID | NULL, caso não encontre
  * 
  * Authors:
  *  - https://github.com/akemi-adam
  */
-Client* getClients(int *officesNumber) {
-    const size_t structSize = sizeof(Client);
-    *officesNumber = getNumberOfElements("clients.dat", structSize);
-    Client *clients = (Client*) malloc(structSize * (*officesNumber));
-    readFile(clients, structSize, *officesNumber, "clients.dat");
+Client* findClient(int id) {
+    Client* client = (Client*) malloc(sizeof(Client));
+    if (client == NULL) return NULL;
+
+    if (!readElementById(client, sizeof(Client), id, "clients.dat") || client->isDeleted) {
+        free(client);
+        return NULL;
+    }
 
-    return clients;
+    return client;
 }
 
+
 /**
- * Retorna um cliente específico a partir de seu ID
+ * Cadastra um novo cliente no arquivo, o seu CPF no índice de CPF e o seu nome no índice de nomes, em uma única
+ * transação
  * 
- * @param const char *id: ID a ser procurado
+ * @param Client *client: Cliente
  * 
- * @return Client*|NULL: Cliente correspondente ao ID | NULL, caso não encontre
+ * @return int: Código atribuído ao cliente | 0, se houver alguma falha
  * 
  * Authors:
  *  - https://github.com/akemi-adam
  */
-Client* findClient(int id) {
-    int count;
-    id--;
-
-    Client* clients = getClients(&count);
-    if (!clients || id < 0 || id >= count) {
-        free(clients);
-        return NULL;
+int addClient(Client *client) {
+    if (!reserveHashIndex(CLIENT_CPF_INDEX, 1)) return 0;
+
+    beginTransaction();
+    int id = addElementToFile(client, sizeof(Client), "clients.dat");
+    if (id == 0 || !insertIntoHashIndex(CLIENT_CPF_INDEX, client->person.cpf, id) || !insertTrigrams(CLIENT_NAME_INDEX, client->person.name, id)
+        || !commitTransaction()) {
+        rollbackTransaction();
+        return 0;
     }
 
-    if (clients[id].isDeleted) {
-        free(clients);
-        return NULL;
+    return id;
+}
+
+/**
+ * Edita/atualiza um cliente no arquivo, sobrescrevendo apenas o seu registro, e atualiza os índices de CPF e de nomes
+ * na mesma transação caso o CPF ou o nome tenham mudado ou o cliente tenha sido excluído
+ * 
+ * @param int id: ID do cliente
+ * @param Client *client: Cliente
+ * 
+ * @return bool: Retorna false se o cliente não existir ou se houver alguma falha
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool editClients(int id, Client *client) {
+    Client *current = findClient(id);
+    if (current == NULL) return false;
+
+    bool isCpfChanged = !client->isDeleted && strcmp(current->person.cpf, client->person.cpf) != 0;
+    bool status = !isCpfChanged || reserveHashIndex(CLIENT_CPF_INDEX, 1);
+
+    if (status) {
+        beginTransaction();
+        status = updateElementById(client, sizeof(Client), id, "clients.dat");
+        if (status) status = replaceInHashIndex(CLIENT_CPF_INDEX, current->person.cpf, client->person.cpf, id, client->isDeleted);
+        if (status) status = replaceTrigrams(CLIENT_NAME_INDEX, current->person.name, client->person.name, id, client->isDeleted);
+        if (status) status = commitTransaction();
+        else rollbackTransaction();
     }
 
-    Client* client = (Client*) malloc(sizeof(Client));
+    free(current);
+    return status;
+}
 
-    *client = clients[id];
-    free(clients);
+/**
+ * Retorna um cliente específico a partir de seu CPF, consultando o índice de CPF
+ * 
+ * @param const char *cpf
+ * 
+ * @return Client*|NULL: Cliente com o CPF | NULL, caso não encontre
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+Client* findClientByCpf(const char *cpf) {
+    int id = findInHashIndex(CLIENT_CPF_INDEX, cpf);
+    return id > 0 ? findClient(id) : NULL;
+}
 
-    return client;
+/**
+ * Procura os clientes cujo nome contém o texto informado, consultando o índice de nomes
+ * 
+ * @param const char *name: Nome ou parte do nome
+ * @param int *ids: Destino dos códigos encontrados, do mais ao menos relevante
+ * @param int maxIds: Número máximo de códigos
+ * @param bool *isTruncated: Indica se a busca parou antes de conferir todos os nomes candidatos (opcional)
+ * 
+ * @return int: Número de clientes encontrados | -1, se o nome tiver menos de TRIGRAM_MIN_QUERY letras
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+int findClientsByName(const char *name, int *ids, int maxIds, bool *isTruncated) {
+    return searchTrigramIndex(CLIENT_NAME_INDEX, "clients.dat", sizeof(Client), offsetof(Client, person.name), name, ids, maxIds, isTruncated);
 }
 
+/**
+ * Procura os clientes com os nomes mais parecidos com o texto informado, tolerando erros de digitação, acentos e
+ * maiúsculas
+ * 
+ * @param const char *name: Nome ou parte do nome
+ * @param int *ids: Destino dos códigos encontrados, do mais ao menos parecido
+ * @param int maxIds: Número máximo de códigos, até FUZZY_MAX_MATCHES
+ * 
+ * @return int: Número de clientes encontrados | -1, se o nome não tiver letras ou números
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+int findClientsBySimilarName(const char *name, int *ids, int maxIds) {
+    FuzzyMatch matches[FUZZY_MAX_MATCHES];
+    int matchesNumber = searchFuzzy("clients.dat", sizeof(Client), offsetof(Client, id), offsetof(Client, isDeleted), offsetof(Client, person.name), name, matches, maxIds, 0);
+
+    for (int i = 0; i < matchesNumber; i++) ids[i] = matches[i].id;
+    return matchesNumber;
+}
 
 /**
- * Edita/atualiza a lista de clientes no arquivo
+ * Verifica se um CPF já pertence a outro cliente
  * 
- * @param int id: ID do cliente
- * @param Client *client: Cliente
+ * @param const char *cpf
+ * @param int id: ID do cliente que está sendo editado, ou 0 em um cadastro
  * 
- * @return void
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool isClientCpfTaken(const char *cpf, int id) {
+    int ownerId = findInHashIndex(CLIENT_CPF_INDEX, cpf);
+    return ownerId > 0 && ownerId != id;
+}
+
+
+/**
+ * Monta as chaves do nome de um cliente no índice de nomes
+ * 
+ * @param const void *element: Client
+ * @param BPlusKey *keys
+ * 
+ * @return int: Número de chaves
  * 
  * Authors:
  *  - https://github.com/akemi-adam
  */
-void editClients(int id, Client *client) {
-    int count;
-    Client *clients = getClients(&count);
-    clients[id - 1] = *client;
-    saveFile(clients, sizeof(Client), count, "clients.dat");
-    free(clients);
-}
\ No newline at end of file
+static int getClientNameKeys(const void *element, BPlusKey *keys) {
+    const Client *client = (const Client*) element;
+    return getTrigramKeys(client->person.name, client->id, keys);
+}
+
+/**
+ * Abre e mapeia o arquivo de clientes em memória para o restante da sessão, junto com os índices de CPF e de nomes
+ * 
+ * @return bool: Retorna false se o arquivo tiver um layout incompatível ou se houver alguma falha ao mapeá-lo
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool openClientTable() {
+    return openFile("clients.dat", sizeof(Client), offsetof(Client, id), offsetof(Client, isDeleted))
+        && openHashIndex(CLIENT_CPF_INDEX, "clients.dat", sizeof(Client), offsetof(Client, id), offsetof(Client, person.cpf))
+        && openMultiKeyBPlusTree(CLIENT_NAME_INDEX, "clients.dat", sizeof(Client), getClientNameKeys, TRIGRAM_MAX_KEYS);
+}
+
+/**
+ * Compacta o arquivo de clientes, removendo os clientes excluídos sem alterar os códigos dos demais, e recria o índice
+ * de nomes sem as folhas esvaziadas pelas exclusões e edições
+ * 
+ * @return int: Número de clientes removidos | -1, se houver alguma falha
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+int compactClientTable() {
+    int removed = compactFile("clients.dat", sizeof(Client));
+    if (removed < 0 || !compactMultiKeyBPlusTree(CLIENT_NAME_INDEX, "clients.dat", sizeof(Client), getClientNameKeys, TRIGRAM_MAX_KEYS)) return -1;
+
+    return removed;
+}
@@ -1,5 +1,7 @@
 #ifndef CLIENT
 #define CLIENT
+#define CLIENT_CPF_INDEX "clients.cpf.idx"
+#define CLIENT_NAME_INDEX "clients.name.idx"
 
 #include <stdbool.h>
 #include "./../person/person.h"
@@ -16,16 +18,32 @@ void createClient(void);
 
 void readClient(void);
 
+void readClientByCpf(void);
+
+void readClientByName(void);
+
 void listClients(void);
 
 void updateClient(void);
 
 void deleteClient(void);
 
-Client* getClients(int*);
-
 Client* findClient(int);
 
-void editClients(int, Client*);
+bool editClients(int, Client*);
+
+int addClient(Client*);
+
+Client* findClientByCpf(const char*);
+
+int findClientsByName(const char*, int*, int, bool*);
+
+int findClientsBySimilarName(const char*, int*, int);
+
+bool isClientCpfTaken(const char*, int);
+
+bool openClientTable(void);
+
+int compactClientTable(void);
 
 #endif
@@ -2,12 +2,17 @@
 #include <stdbool.h>
 #include <string.h>
 #include <stdlib.h>
+#include <stddef.h>
 #include "./../../utils/interfaces.h"
 #include "./../../utils/validation.h"
 #include "./../../utils/storage.h"
 #include "./../../utils/str.h"
+#include "./../../utils/hashindex.h"
+#include "./../../utils/trigram.h"
+#include "./../../utils/fuzzy.h"
 #include "./../../utils/storage.h"
 #include "./../person/person.h"
+#include "./../appointment/appointment.h"
 #include "lawyer.h"
 
 #ifdef __unix__
@@ -37,15 +42,29 @@ void createLawyer() {
     printf("---- Cadastrar Advogado ----\n");
     readStrField(lawyer.person.name, "Nome", 55, nameRules, 2);
     readStrField(lawyer.person.cpf, "CPF", 12, cpfRules, 2);
+    if (isLawyerCpfTaken(lawyer.person.cpf, 0)) {
+        printf("\nJá existe um advogado cadastrado com este CPF!\nPressione <Enter> para prosseguir...\n");
+        proceed();
+        return;
+    }
     readStrField(lawyer.cna, "CNA", 13, cnaRules, 2);
+    if (isLawyerCnaTaken(lawyer.cna, 0)) {
+        printf("\nJá existe um advogado cadastrado com esta CNA!\nPressione <Enter> para prosseguir...\n");
+        proceed();
+        return;
+    }
     readStrField(lawyer.person.email, "E-mail", 55, emailRules, 2);
     readStrField(lawyer.person.telephone, "Telefone", 14, telephoneRules, 2);
 
     lawyer.isDeleted = false;
 
-    bool status = addElementToFile(&lawyer, sizeof(Lawyer), "lawyers.dat");
+    int id = addLawyer(&lawyer);
 
-    printf("\n%s\n", status ? "Advogado cadastrado com sucesso!\nPressione <Enter> para prosseguir..." : "Houve um erro ao cadastrar o advogado!");
+    if (id > 0) {
+        printf("\nAdvogado cadastrado com sucesso! Código: %d\nPressione <Enter> para prosseguir...\n", id);
+    } else {
+        printf("\nHouve um erro ao cadastrar o advogado!\n");
+    }
     proceed();
 }
 
@@ -58,19 +77,19 @@ void createLawyer() {
  *  - https://github.com/akemi-adam
  */
 void listLawyers() {
-    int count;
-    Lawyer *lawyers = getLawyers(&count);
+    Cursor cursor;
+    const Lawyer *lawyer;
     
     printf("---- Listar Advogados ----\n");
     printf("------------------------------------------------------------------\n");
-    for (int i = 0; i < count; i++) {
-        if (!lawyers[i].isDeleted) {
-            printf("ID: %d\nNome: %s\nCPF: %s\nCNA: %s\nE-mail: %s\nTelefone: %s\n", i + 1, lawyers[i].person.name, lawyers[i].person.cpf, lawyers[i].cna, lawyers[i].person.email, lawyers[i].person.telephone);
+    if (openCursor(&cursor, "lawyers.dat", sizeof(Lawyer), true)) {
+        while ((lawyer = nextElement(&cursor)) != NULL) {
+            printf("ID: %d\nNome: %s\nCPF: %s\nCNA: %s\nE-mail: %s\nTelefone: %s\n", lawyer->id, lawyer->person.name, lawyer->person.cpf, lawyer->cna, lawyer->person.email, lawyer->person.telephone);
         }
+        closeCursor(&cursor);
     }
     printf("------------------------------------------------------------------\n");
 
-    free(lawyers);
     printf("Pressione <Enter> para prosseguir...\n");
     proceed();
 }
@@ -107,6 +126,106 @@ void readLawyer() {
     proceed();
 }
 
+/**
+ * Exibe os dados de um advogado a partir do seu CPF, consultando o índice de CPF
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+void readLawyerByCpf() {
+    char cpf[12] = "";
+    Validation cpfRules[2] = {validateRequired, validateCpf};
+    printf("---- Buscar Advogado por CPF ----\n");
+    readStrField(cpf, "CPF", 12, cpfRules, 2);
+    Lawyer *lawyer = findLawyerByCpf(cpf);
+
+    if (lawyer != NULL) {
+        printf("------------------------------------------------------------------\n");
+        printf("ID: %d\nNome: %s\nCPF: %s\nCNA: %s\nE-mail: %s\nTelefone: %s\n", lawyer->id, lawyer->person.name, lawyer->person.cpf, lawyer->cna, lawyer->person.email, lawyer->person.telephone);
+        printf("------------------------------------------------------------------\n");
+        free(lawyer);
+    } else {
+        printf("O CPF informado não corresponde a nenhum advogado\n");
+    }
+
+    printf("Pressione <Enter> para prosseguir...\n");
+    proceed();
+}
+
+/**
+ * Exibe os dados de um advogado a partir da sua CNA, consultando o índice de CNA
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+void readLawyerByCna() {
+    char cna[13] = "";
+    Validation cnaRules[2] = {validateRequired, validateCna};
+    printf("---- Buscar Advogado por CNA ----\n");
+    readStrField(cna, "CNA", 13, cnaRules, 2);
+    Lawyer *lawyer = findLawyerByCna(cna);
+
+    if (lawyer != NULL) {
+        printf("------------------------------------------------------------------\n");
+        printf("ID: %d\nNome: %s\nCPF: %s\nCNA: %s\nE-mail: %s\nTelefone: %s\n", lawyer->id, lawyer->person.name, lawyer->person.cpf, lawyer->cna, lawyer->person.email, lawyer->person.telephone);
+        printf("------------------------------------------------------------------\n");
+        free(lawyer);
+    } else {
+        printf("A CNA informada não corresponde a nenhum advogado\n");
+    }
+
+    printf("Pressione <Enter> para prosseguir...\n");
+    proceed();
+}
+
+/**
+ * Formulário para buscar advogados por parte do nome, sem diferenciar acentos nem maiúsculas. Se nenhum nome contiver
+ * o texto informado, exibe os advogados com os nomes mais parecidos
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+void readLawyerByName() {
+    char name[55] = "";
+    int ids[PERSON_SEARCH_MAX];
+    bool isTruncated = false;
+    Validation nameRules[1] = {validateRequired};
+    printf("---- Buscar Advogado por Nome ----\n");
+    readStrField(name, "Nome (ou parte do nome)", 55, nameRules, 1);
+    int idsNumber = findLawyersByName(name, ids, PERSON_SEARCH_MAX, &isTruncated);
+    if (idsNumber == 0) {
+        // Sem nomes que contenham o texto informado, procura nomes parecidos, como os digitados com erros
+        idsNumber = findLawyersBySimilarName(name, ids, PERSON_SEARCH_MAX);
+        if (idsNumber > 0) printf("Nenhum advogado tem exatamente este nome. Nomes parecidos:\n");
+        else idsNumber = 0;
+    }
+
+    if (idsNumber < 0) {
+        printf("Informe ao menos %d letras do nome\n", TRIGRAM_MIN_QUERY);
+    } else if (idsNumber == 0) {
+        printf("O nome informado não corresponde a nenhum advogado\n");
+    } else {
+        printf("------------------------------------------------------------------\n");
+        for (int i = 0; i < idsNumber; i++) {
+            Lawyer *lawyer = findLawyer(ids[i]);
+            if (lawyer == NULL) continue;
+            printf("ID: %d\nNome: %s\nCPF: %s\nCNA: %s\nE-mail: %s\nTelefone: %s\n", lawyer->id, lawyer->person.name, lawyer->person.cpf, lawyer->cna, lawyer->person.email, lawyer->person.telephone);
+            printf("------------------------------------------------------------------\n");
+            free(lawyer);
+        }
+        if (isTruncated) printf("Há muitos advogados com este nome e nem todos foram conferidos; informe mais letras para refinar a busca\n");
+    }
+
+    printf("Pressione <Enter> para prosseguir...\n");
+    proceed();
+}
+
 /**
  * Formulário para atualizar os dados de um advogado específico
  * 
@@ -138,10 +257,16 @@ void updateLawyer() {
         readStrField(lawyer->person.email, "E-mail", 55, emailRules, 1);
         readStrField(lawyer->person.telephone, "Telefone", 14, telephoneRules, 1);
 
-        editLawyers(intId, lawyer);
+        if (isLawyerCpfTaken(lawyer->person.cpf, intId)) {
+            printf("\nJá existe um advogado cadastrado com este CPF!\n");
+        } else if (isLawyerCnaTaken(lawyer->cna, intId)) {
+            printf("\nJá existe um advogado cadastrado com esta CNA!\n");
+        } else if (editLawyers(intId, lawyer)) {
+            printf("\nAdvogado editado com sucesso!\n");
+        } else {
+            printf("\nHouve um erro ao editar o advogado!\n");
+        }
         free(lawyer);
-
-        printf("\nAdvogado editado com sucesso!\n");
     } else {
         printf("O código informado não corresponde a nenhum advogado\n");
     }
@@ -150,6 +275,26 @@ void updateLawyer() {
     proceed();
 }
 
+/**
+ * Marca um advogado como excluído, dentro da transação em que os seus agendamentos são resolvidos
+ * 
+ * @param int id: Código do advogado
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static bool markLawyerDeleted(int id) {
+    Lawyer *lawyer = findLawyer(id);
+    if (lawyer == NULL) return false;
+
+    lawyer->isDeleted = true;
+    bool status = editLawyers(id, lawyer);
+    free(lawyer);
+    return status;
+}
+
 /**
  * Deleta um advogado do sistema
  * 
@@ -169,10 +314,14 @@ void deleteLawyer() {
     Lawyer *lawyer = findLawyer(intId);
 
     if (lawyer != NULL) {
-        lawyer->isDeleted = true;
-        editLawyers(intId, lawyer);
+        ReferenceAction action;
+        int newId;
+        if (readReferenceAction(REFERENCE_LAWYER, intId, &action, &newId)) {
+            printf("%s\n", deleteReferencedRecord(REFERENCE_LAWYER, intId, action, newId, markLawyerDeleted) ? "Advogado deletado com sucesso!" : "Houve um erro ao deletar o advogado!");
+        } else {
+            printf("O advogado não foi deletado\n");
+        }
         free(lawyer);
-        printf("Advogado deletado com sucesso!\n");
     } else {
         printf("O código informado não corresponde a nenhum advogado\n");
     }
@@ -194,15 +343,15 @@ void showLawyerMenu() {
         struct termios originalTerminal;
         tcgetattr(STDIN_FILENO, &originalTerminal);
     #endif
-    int option = 0, size = 6;
+    int option = 0, size = 9;
     bool isSelected = false, loop = true;
     char optionsStyles[size][11];
-    char options[6][30] = {
-        "1. Cadastrar Advogado", "2. Mostrar Advogados", "3. Achar advogado",
-        "4. Editar Advogado", "5. Excluir Advogado", "6. Voltar"
+    char options[9][30] = {
+        "1. Cadastrar Advogado", "2. Mostrar Advogados", "3. Achar advogado", "4. Achar advogado por CPF",
+        "5. Achar advogado por CNA", "6. Achar advogado por Nome", "7. Editar Advogado", "8. Excluir Advogado", "9. Voltar"
     };
     void (*actions[])() = {
-        createLawyer, listLawyers, readLawyer, updateLawyer, deleteLawyer
+        createLawyer, listLawyers, readLawyer, readLawyerByCpf, readLawyerByCna, readLawyerByName, updateLawyer, deleteLawyer
     };
     setOptionsStyle(optionsStyles, size);
     while (loop) {
@@ -232,73 +381,233 @@ void showLawyerMenu() {
 }
 
 /**
- * Retorna uma lista contendo todos os advogados
+ * Retorna um advogado específico a partir de seu ID
  * 
- * @param int *officesNumber: Número de advogados cadastrados
+ * @param const char *id: ID a ser procurado
  * 
- * @return Office*: endereço da lista de advogados
+ * @return Lawyer*|NULL: Advogado correspondente ao ID | NULL, caso não encontre
  * 
  * Authors:
  *  - https://github.com/akemi-adam
  */
-Lawyer* getLawyers(int *officesNumber) {
-    const size_t structSize = sizeof(Lawyer);
-    *officesNumber = getNumberOfElements("lawyers.dat", structSize);
-    Lawyer *lawyers = (Lawyer*) malloc(structSize * (*officesNumber));
-    readFile(lawyers, structSize, *officesNumber, "lawyers.dat");
+Lawyer* findLawyer(int id) {
+    Lawyer* lawyer = (Lawyer*) malloc(sizeof(Lawyer));
+    if (lawyer == NULL) return NULL;
 
-    return lawyers;
+    if (!readElementById(lawyer, sizeof(Lawyer), id, "lawyers.dat") || lawyer->isDeleted) {
+        free(lawyer);
+        return NULL;
+    }
+
+    return lawyer;
 }
 
+
 /**
- * Retorna um advogado específico a partir de seu ID
+ * Cadastra um novo advogado no arquivo e o seu CPF, a sua CNA e o seu nome nos índices, em uma única transação
  * 
- * @param const char *id: ID a ser procurado
+ * @param Lawyer *lawyer: Advogado
  * 
- * @return Lawyer*|NULL: Advogado correspondente ao ID | NULL, caso não encontre
+ * @return int: Código atribuído ao advogado | 0, se houver alguma falha
  * 
  * Authors:
  *  - https://github.com/akemi-adam
  */
-Lawyer* findLawyer(int id) {
-    int count;
-    id--;
-
-    Lawyer* lawyers = getLawyers(&count);
-    if (!lawyers || id < 0 || id >= count) {
-        free(lawyers);
-        return NULL;
+int addLawyer(Lawyer *lawyer) {
+    if (!reserveHashIndex(LAWYER_CPF_INDEX, 1) || !reserveHashIndex(LAWYER_CNA_INDEX, 1)) return 0;
+
+    beginTransaction();
+    int id = addElementToFile(lawyer, sizeof(Lawyer), "lawyers.dat");
+    bool status = id > 0 && insertIntoHashIndex(LAWYER_CPF_INDEX, lawyer->person.cpf, id) && insertIntoHashIndex(LAWYER_CNA_INDEX, lawyer->cna, id)
+        && insertTrigrams(LAWYER_NAME_INDEX, lawyer->person.name, id);
+    if (!status || !commitTransaction()) {
+        rollbackTransaction();
+        return 0;
     }
 
-    if (lawyers[id].isDeleted) {
-        free(lawyers);
-        return NULL;
+    return id;
+}
+
+/**
+ * Edita/atualiza um advogado no arquivo, sobrescrevendo apenas o seu registro, e atualiza os índices de CPF, de CNA e
+ * de nomes na mesma transação
+ * 
+ * @param int id: ID do advogado
+ * @param Lawyer *lawyer: Advogado
+ * 
+ * @return bool: Retorna false se o advogado não existir ou se houver alguma falha
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool editLawyers(int id, Lawyer *lawyer) {
+    Lawyer *current = findLawyer(id);
+    if (current == NULL) return false;
+
+    // As reescritas dos índices, quando necessárias, acontecem antes da transação e apenas nos índices cuja chave mudou
+    bool isCpfChanged = !lawyer->isDeleted && strcmp(current->person.cpf, lawyer->person.cpf) != 0;
+    bool isCnaChanged = !lawyer->isDeleted && strcmp(current->cna, lawyer->cna) != 0;
+    bool status = (!isCpfChanged || reserveHashIndex(LAWYER_CPF_INDEX, 1)) && (!isCnaChanged || reserveHashIndex(LAWYER_CNA_INDEX, 1));
+
+    if (status) {
+        beginTransaction();
+        status = updateElementById(lawyer, sizeof(Lawyer), id, "lawyers.dat")
+            && replaceInHashIndex(LAWYER_CPF_INDEX, current->person.cpf, lawyer->person.cpf, id, lawyer->isDeleted)
+            && replaceInHashIndex(LAWYER_CNA_INDEX, current->cna, lawyer->cna, id, lawyer->isDeleted)
+            && replaceTrigrams(LAWYER_NAME_INDEX, current->person.name, lawyer->person.name, id, lawyer->isDeleted);
+        if (status) status = commitTransaction();
+        else rollbackTransaction();
     }
 
-    Lawyer* lawyer = (Lawyer*) malloc(sizeof(Lawyer));
+    free(current);
+    return status;
+}
 
-    *lawyer = lawyers[id];
-    free(lawyers);
+/**
+ * Retorna um advogado específico a partir de seu CPF, consultando o índice de CPF
+ * 
+ * @param const char *cpf
+ * 
+ * @return Lawyer*|NULL: Advogado com o CPF | NULL, caso não encontre
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+Lawyer* findLawyerByCpf(const char *cpf) {
+    int id = findInHashIndex(LAWYER_CPF_INDEX, cpf);
+    return id > 0 ? findLawyer(id) : NULL;
+}
 
-    return lawyer;
+/**
+ * Verifica se um CPF já pertence a outro advogado
+ * 
+ * @param const char *cpf
+ * @param int id: ID do advogado que está sendo editado, ou 0 em um cadastro
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool isLawyerCpfTaken(const char *cpf, int id) {
+    int ownerId = findInHashIndex(LAWYER_CPF_INDEX, cpf);
+    return ownerId > 0 && ownerId != id;
 }
 
+/**
+ * Retorna um advogado específico a partir de sua CNA, consultando o índice de CNA
+ * 
+ * @param const char *cna
+ * 
+ * @return Lawyer*|NULL: Advogado com a CNA | NULL, caso não encontre
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+Lawyer* findLawyerByCna(const char *cna) {
+    int id = findInHashIndex(LAWYER_CNA_INDEX, cna);
+    return id > 0 ? findLawyer(id) : NULL;
+}
 
 /**
- * Edita/atualiza a lista de advogados no arquivo
+ * Procura os advogados cujo nome contém o texto informado, consultando o índice de nomes
  * 
- * @param int id: ID do advogado
- * @param Lawyer *lawyer: Advogado
+ * @param const char *name: Nome ou parte do nome
+ * @param int *ids: Destino dos códigos encontrados, do mais ao menos relevante
+ * @param int maxIds: Número máximo de códigos
+ * @param bool *isTruncated: Indica se a busca parou antes de conferir todos os nomes candidatos (opcional)
  * 
- * @return void
+ * @return int: Número de advogados encontrados | -1, se o nome tiver menos de TRIGRAM_MIN_QUERY letras
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+int findLawyersByName(const char *name, int *ids, int maxIds, bool *isTruncated) {
+    return searchTrigramIndex(LAWYER_NAME_INDEX, "lawyers.dat", sizeof(Lawyer), offsetof(Lawyer, person.name), name, ids, maxIds, isTruncated);
+}
+
+/**
+ * Procura os advogados com os nomes mais parecidos com o texto informado, tolerando erros de digitação, acentos e
+ * maiúsculas
+ * 
+ * @param const char *name: Nome ou parte do nome
+ * @param int *ids: Destino dos códigos encontrados, do mais ao menos parecido
+ * @param int maxIds: Número máximo de códigos, até FUZZY_MAX_MATCHES
+ * 
+ * @return int: Número de advogados encontrados | -1, se o nome não tiver letras ou números
  * 
  * Authors:
  *  - https://github.com/akemi-adam
  */
-void editLawyers(int id, Lawyer *lawyer) {
-    int count;
-    Lawyer *lawyers = getLawyers(&count);
-    lawyers[id - 1] = *lawyer;
-    saveFile(lawyers, sizeof(Lawyer), count, "lawyers.dat");
-    free(lawyers);
-}
\ No newline at end of file
+int findLawyersBySimilarName(const char *name, int *ids, int maxIds) {
+    FuzzyMatch matches[FUZZY_MAX_MATCHES];
+    int matchesNumber = searchFuzzy("lawyers.dat", sizeof(Lawyer), offsetof(Lawyer, id), offsetof(Lawyer, isDeleted), offsetof(Lawyer, person.name), name, matches, maxIds, 0);
+
+    for (int i = 0; i < matchesNumber; i++) ids[i] = matches[i].id;
+    return matchesNumber;
+}
+
+/**
+ * Verifica se uma CNA já pertence a outro advogado
+ * 
+ * @param const char *cna
+ * @param int id: ID do advogado que está sendo editado, ou 0 em um cadastro
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool isLawyerCnaTaken(const char *cna, int id) {
+    int ownerId = findInHashIndex(LAWYER_CNA_INDEX, cna);
+    return ownerId > 0 && ownerId != id;
+}
+
+
+/**
+ * Monta as chaves do nome de um advogado no índice de nomes
+ * 
+ * @param const void *element: Lawyer
+ * @param BPlusKey *keys
+ * 
+ * @return int: Número de chaves
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static int getLawyerNameKeys(const void *element, BPlusKey *keys) {
+    const Lawyer *lawyer = (const Lawyer*) element;
+    return getTrigramKeys(lawyer->person.name, lawyer->id, keys);
+}
+
+/**
+ * Abre e mapeia o arquivo de advogados em memória para o restante da sessão, junto com os índices de CPF, de CNA e de
+ * nomes
+ * 
+ * @return bool: Retorna false se o arquivo tiver um layout incompatível ou se houver alguma falha ao mapeá-lo
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool openLawyerTable() {
+    return openFile("lawyers.dat", sizeof(Lawyer), offsetof(Lawyer, id), offsetof(Lawyer, isDeleted))
+        && openHashIndex(LAWYER_CPF_INDEX, "lawyers.dat", sizeof(Lawyer), offsetof(Lawyer, id), offsetof(Lawyer, person.cpf))
+        && openHashIndex(LAWYER_CNA_INDEX, "lawyers.dat", sizeof(Lawyer), offsetof(Lawyer, id), offsetof(Lawyer, cna))
+        && openMultiKeyBPlusTree(LAWYER_NAME_INDEX, "lawyers.dat", sizeof(Lawyer), getLawyerNameKeys, TRIGRAM_MAX_KEYS);
+}
+
+/**
+ * Compacta o arquivo de advogados, removendo os advogados excluídos sem alterar os códigos dos demais, e recria o
+ * índice de nomes sem as folhas esvaziadas pelas exclusões e edições
+ * 
+ * @return int: Número de advogados removidos | -1, se houver alguma falha
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+int compactLawyerTable() {
+    int removed = compactFile("lawyers.dat", sizeof(Lawyer));
+    if (removed < 0 || !compactMultiKeyBPlusTree(LAWYER_NAME_INDEX, "lawyers.dat", sizeof(Lawyer), getLawyerNameKeys, TRIGRAM_MAX_KEYS)) return -1;
+
+    return removed;
+}
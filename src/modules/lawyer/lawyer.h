@@ -1,5 +1,8 @@
 #ifndef LAWYER
 #define LAWYER
+#define LAWYER_CPF_INDEX "lawyers.cpf.idx"
+#define LAWYER_NAME_INDEX "lawyers.name.idx"
+#define LAWYER_CNA_INDEX "lawyers.cna.idx"
 
 #include <stdbool.h>
 #include "./../person/person.h"
@@ -17,16 +20,38 @@ void createLawyer(void);
 
 void readLawyer(void);
 
+void readLawyerByCpf(void);
+
+void readLawyerByName(void);
+
+void readLawyerByCna(void);
+
 void listLawyers(void);
 
 void updateLawyer(void);
 
 void deleteLawyer(void);
 
-Lawyer* getLawyers(int*);
-
 Lawyer* findLawyer(int);
 
-void editLawyers(int, Lawyer*);
+bool editLawyers(int, Lawyer*);
+
+int addLawyer(Lawyer*);
+
+Lawyer* findLawyerByCpf(const char*);
+
+int findLawyersByName(const char*, int*, int, bool*);
+
+int findLawyersBySimilarName(const char*, int*, int);
+
+bool isLawyerCpfTaken(const char*, int);
+
+Lawyer* findLawyerByCna(const char*);
+
+bool isLawyerCnaTaken(const char*, int);
+
+bool openLawyerTable(void);
+
+int compactLawyerTable(void);
 
 #endif
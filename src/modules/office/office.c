@@ -2,10 +2,14 @@
 #include <stdbool.h>
 #include <string.h>
 #include <stdlib.h>
+#include <stddef.h>
 #include "./../../utils/interfaces.h"
 #include "./../../utils/validation.h"
 #include "./../../utils/storage.h"
 #include "./../../utils/str.h"
+#include "./../../utils/bptree.h"
+#include "./../../utils/textindex.h"
+#include "./../appointment/appointment.h"
 #include "office.h"
 
 #ifdef __unix__
@@ -33,9 +37,13 @@ void createOffice() {
     readStrField(office.address, "Endereço", 100, enderecoRules, 2);
     office.isDeleted = false;
 
-    bool status = addElementToFile(&office, sizeof(Office), "offices.dat");
+    int id = addOffice(&office);
 
-    printf("\n%s\n", status ? "Escritório cadastrado com sucesso!\nPressione <Enter> para prosseguir..." : "Houve um erro ao cadastrar o escritório!");
+    if (id > 0) {
+        printf("\nEscritório cadastrado com sucesso! Código: %d\nPressione <Enter> para prosseguir...\n", id);
+    } else {
+        printf("\nHouve um erro ao cadastrar o escritório!\n");
+    }
     proceed();
 }
 
@@ -49,19 +57,19 @@ void createOffice() {
  *  - https://github.com/akemi-adam
  */
 void listOffices() {
-    int count;
-    Office *offices = getOffices(&count);
+    Cursor cursor;
+    const Office *office;
     
     printf("---- Listar Escritórios ----\n");
     printf("---------------------------------------------------------\n");
-    for (int i = 0; i < count; i++) {
-        if (!offices[i].isDeleted) {
-            printf("ID: %d\nEndereço: %s\n", i + 1, offices[i].address);
+    if (openCursor(&cursor, "offices.dat", sizeof(Office), true)) {
+        while ((office = nextElement(&cursor)) != NULL) {
+            printf("ID: %d\nEndereço: %s\n", office->id, office->address);
             printf("---------------------------------------------------------\n");
         }
+        closeCursor(&cursor);
     }
     
-    free(offices);
     printf("Pressione <Enter> para prosseguir...\n");
     proceed();
 }
@@ -98,6 +106,44 @@ void readOffice() {
     proceed();
 }
 
+/**
+ * Formulário para buscar escritórios pelas palavras do endereço (rua, bairro, cidade), sem diferenciar acentos nem
+ * maiúsculas. São exibidos os escritórios cujo endereço tem todas as palavras informadas.
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+void searchOffices() {
+    char terms[100] = "";
+    int ids[OFFICE_SEARCH_MAX];
+    bool isTruncated = false;
+    Validation termsRules[1] = {validateRequired};
+    printf("---- Buscar Escritório por Endereço ----\n");
+    readStrField(terms, "Palavras do endereço", 100, termsRules, 1);
+    int idsNumber = findOfficesByAddress(terms, ids, OFFICE_SEARCH_MAX, &isTruncated);
+
+    if (idsNumber < 0) {
+        printf("Informe ao menos uma palavra do endereço\n");
+    } else if (idsNumber == 0) {
+        printf("Nenhum escritório tem todas as palavras informadas no endereço\n");
+    } else {
+        printf("---------------------------------------------------------\n");
+        for (int i = 0; i < idsNumber; i++) {
+            Office *office = findOffice(ids[i]);
+            if (office == NULL) continue;
+            printf("ID: %d\nEndereço: %s\n", office->id, office->address);
+            printf("---------------------------------------------------------\n");
+            free(office);
+        }
+        if (isTruncated) printf("Exibindo os %d primeiros escritórios; informe mais palavras para refinar a busca\n", OFFICE_SEARCH_MAX);
+    }
+
+    printf("Pressione <Enter> para prosseguir...\n");
+    proceed();
+}
+
 /**
  * Formulário para atualizar os dados de um escritório específico
  * 
@@ -121,10 +167,8 @@ void updateOffice() {
         printf("Escritório encontrado!\n\n---- Editar Escritório ----\n");
         readStrField(office->address, "Endereço", 100, enderecoRules, 1);
         
-        editOffices(intId, office);
+        printf("\n%s\n", editOffices(intId, office) ? "Escritório editado com sucesso!" : "Houve um erro ao editar o escritório!");
         free(office);
-
-        printf("\nEscritório editado com sucesso!\n");
     } else {
         printf("O código informado não corresponde a nenhum escritório\n");
     }
@@ -133,6 +177,26 @@ void updateOffice() {
     proceed();
 }
 
+/**
+ * Marca um escritório como excluído, dentro da transação em que os seus agendamentos são resolvidos
+ * 
+ * @param int id: Código do escritório
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static bool markOfficeDeleted(int id) {
+    Office *office = findOffice(id);
+    if (office == NULL) return false;
+
+    office->isDeleted = true;
+    bool status = editOffices(id, office);
+    free(office);
+    return status;
+}
+
 /**
  * Deleta um escritório do sistema
  * 
@@ -153,10 +217,14 @@ void deleteOffice() {
     Office *office = findOffice(intId);
 
     if (office != NULL) {
-        office->isDeleted = true;
-        editOffices(intId, office);
+        ReferenceAction action;
+        int newId;
+        if (readReferenceAction(REFERENCE_OFFICE, intId, &action, &newId)) {
+            printf("%s\n", deleteReferencedRecord(REFERENCE_OFFICE, intId, action, newId, markOfficeDeleted) ? "Escritório deletado com sucesso!" : "Houve um erro ao deletar o escritório!");
+        } else {
+            printf("O escritório não foi deletado\n");
+        }
         free(office);
-        printf("Escritório deletado com sucesso!\n");
     } else {
         printf("O código informado não corresponde a nenhum escritório\n");
     }
@@ -179,15 +247,15 @@ void showOfficeMenu() {
         struct termios originalTerminal;
         tcgetattr(STDIN_FILENO, &originalTerminal);
     #endif
-    int option = 0, size = 6;
+    int option = 0, size = 7;
     bool isSelected = false, loop = true;
     char optionsStyles[size][11];
-    char options[6][30] = {
-        "1. Cadastrar Escritório", "2. Mostrar Escritórios", "3. Achar Escritório",
-        "4. Editar Escritório", "5. Excluir Escritório", "6. Voltar"
+    char options[7][30] = {
+        "1. Cadastrar Escritório", "2. Mostrar Escritórios", "3. Achar Escritório", "4. Achar por Endereço",
+        "5. Editar Escritório", "6. Excluir Escritório", "7. Voltar"
     };
     void (*actions[])() = {
-        createOffice, listOffices, readOffice, updateOffice, deleteOffice
+        createOffice, listOffices, readOffice, searchOffices, updateOffice, deleteOffice
     };
     setOptionsStyle(optionsStyles, size);
     while (loop) {
@@ -217,72 +285,132 @@ void showOfficeMenu() {
 }
 
 /**
- * Retorna uma lista contendo todos os escritórios
+ * Retorna um escritório específico a partir de seu ID
  * 
- * @param int *officesNumber: Número de escritórios cadastrados
+ * @param const char *id: ID a ser procurado
  * 
- * @return Office*: endereço da lista de escritórios
+ * @return Office*|NULL: Escritório correspondente ao ID | NULL, caso não encontre
  * 
  * Authors:
  *  - https://github.com/akemi-adam
  */
-Office* getOffices(int *officesNumber) {
-    const size_t structSize = sizeof(Office);
-    *officesNumber = getNumberOfElements("offices.dat", structSize);
-    Office *offices = (Office*) malloc(structSize * (*officesNumber));
-    readFile(offices, structSize, *officesNumber, "offices.dat");
+Office* findOffice(int id) {
+    Office* office = (Office*) malloc(sizeof(Office));
+    if (office == NULL) return NULL;
+
+    if (!readElementById(office, sizeof(Office), id, "offices.dat") || office->isDeleted) {
+        free(office);
+        return NULL;
+    }
 
-    return offices;
+    return office;
 }
 
 /**
- * Retorna um escritório específico a partir de seu ID
+ * Cadastra um novo escritório no arquivo e o seu endereço no índice de endereços, em uma única transação
  * 
- * @param const char *id: ID a ser procurado
+ * @param Office *office: Escritório
  * 
- * @return Office*|NULL: Escritório correspondente ao ID | NULL, caso não encontre
+ * @return int: Código atribuído ao escritório | 0, se houver alguma falha
  * 
  * Authors:
  *  - https://github.com/akemi-adam
  */
-Office* findOffice(int id) {
-    int count;
-    id--;
-
-    Office* offices = getOffices(&count);
-    if (!offices || id < 0 || id >= count) {
-        free(offices);
-        return NULL;
+int addOffice(Office *office) {
+    beginTransaction();
+    int id = addElementToFile(office, sizeof(Office), "offices.dat");
+    if (id == 0 || !insertTokens(OFFICE_ADDRESS_INDEX, office->address, id) || !commitTransaction()) {
+        rollbackTransaction();
+        return 0;
     }
 
-    if (offices[id].isDeleted) {
-        free(offices);
-        return NULL;
-    }
+    return id;
+}
 
-    Office* office = (Office*) malloc(sizeof(Office));
+/**
+ * Edita/atualiza um escritório no arquivo, sobrescrevendo apenas o seu registro, e atualiza o índice de endereços na
+ * mesma transação caso o endereço tenha mudado ou o escritório tenha sido excluído
+ * 
+ * @param int id: ID do escritório
+ * @param Office *office: Escritório
+ * 
+ * @return bool: Retorna false se o escritório não existir ou se houver alguma falha
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool editOffices(int id, Office *office) {
+    Office *current = findOffice(id);
+    if (current == NULL) return false;
 
-    *office = offices[id];
-    free(offices);
+    beginTransaction();
+    bool status = updateElementById(office, sizeof(Office), id, "offices.dat")
+        && replaceTokens(OFFICE_ADDRESS_INDEX, current->address, office->address, id, office->isDeleted);
+    if (status) status = commitTransaction();
+    else rollbackTransaction();
 
-    return office;
+    free(current);
+    return status;
 }
 
 /**
- * Edita/atualiza a lista de escritórios no arquivo
+ * Procura os escritórios cujo endereço tem todas as palavras informadas, consultando o índice de endereços
  * 
- * @param int id: ID do escritório
- * @param Office *office: Escritório
+ * @param const char *terms: Palavras do endereço, separadas por espaços
+ * @param int *ids: Destino dos códigos encontrados, em ordem de código
+ * @param int maxIds: Número máximo de códigos
+ * @param bool *isTruncated: Indica se havia mais escritórios com as palavras do que maxIds (opcional)
  * 
- * @return void
+ * @return int: Número de escritórios encontrados | -1, se não houver palavras ou se houver alguma falha
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+int findOfficesByAddress(const char *terms, int *ids, int maxIds, bool *isTruncated) {
+    return searchTokenIndex(OFFICE_ADDRESS_INDEX, "offices.dat", sizeof(Office), offsetof(Office, address), terms, ids, maxIds, isTruncated);
+}
+
+/**
+ * Monta as chaves do endereço de um escritório no índice de endereços
+ * 
+ * @param const void *element: Office
+ * @param BPlusKey *keys
+ * 
+ * @return int: Número de chaves
  * 
  * Authors:
  *  - https://github.com/akemi-adam
  */
-void editOffices(int id, Office *office) {
-    int count;
-    Office *offices = getOffices(&count);
-    offices[id - 1] = *office;
-    saveFile(offices, sizeof(Office), count, "offices.dat");
-    free(offices);
-}
\ No newline at end of file
+static int getOfficeAddressKeys(const void *element, BPlusKey *keys) {
+    const Office *office = (const Office*) element;
+    return getTokenKeys(office->address, office->id, keys);
+}
+
+/**
+ * Abre e mapeia o arquivo de escritórios em memória para o restante da sessão, junto com o índice de endereços
+ * 
+ * @return bool: Retorna false se o arquivo tiver um layout incompatível ou se houver alguma falha ao mapeá-lo
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool openOfficeTable() {
+    return openFile("offices.dat", sizeof(Office), offsetof(Office, id), offsetof(Office, isDeleted))
+        && openMultiKeyBPlusTree(OFFICE_ADDRESS_INDEX, "offices.dat", sizeof(Office), getOfficeAddressKeys, TEXTINDEX_MAX_KEYS);
+}
+
+/**
+ * Compacta o arquivo de escritórios, removendo os escritórios excluídos sem alterar os códigos dos demais, e recria o
+ * índice de endereços sem as folhas esvaziadas pelas exclusões e edições
+ * 
+ * @return int: Número de escritórios removidos | -1, se houver alguma falha
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+int compactOfficeTable() {
+    int removed = compactFile("offices.dat", sizeof(Office));
+    if (removed < 0 || !compactMultiKeyBPlusTree(OFFICE_ADDRESS_INDEX, "offices.dat", sizeof(Office), getOfficeAddressKeys, TEXTINDEX_MAX_KEYS)) return -1;
+
+    return removed;
+}
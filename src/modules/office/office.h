@@ -1,5 +1,7 @@
 #ifndef OFFICE
 #define OFFICE
+#define OFFICE_ADDRESS_INDEX "offices.address.idx"
+#define OFFICE_SEARCH_MAX 20
 
 #include <stdbool.h>
 
@@ -15,16 +17,24 @@ void createOffice(void);
 
 void readOffice(void);
 
+void searchOffices(void);
+
 void listOffices(void);
 
 void updateOffice(void);
 
 void deleteOffice(void);
 
-Office* getOffices(int*);
-
 Office* findOffice(int);
 
-void editOffices(int, Office*);
+bool editOffices(int, Office*);
+
+int addOffice(Office*);
+
+int findOfficesByAddress(const char*, int*, int, bool*);
+
+bool openOfficeTable(void);
+
+int compactOfficeTable(void);
 
 #endif
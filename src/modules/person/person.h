@@ -1,5 +1,6 @@
 #ifndef PERSON
 #define PERSON
+#define PERSON_SEARCH_MAX 10
 
 typedef struct Person {
     char name[55];
@@ -0,0 +1,806 @@
+#include <stdbool.h>
+#include <string.h>
+#include <stdlib.h>
+#include "./storage.h"
+#include "./bptree.h"
+
+/**
+ * Tabela de cada árvore aberta, cujo cabeçalho é copiado para o nó 0 a cada alteração da árvore
+ */
+typedef struct BPlusTable {
+    char filename[64];
+    char table[64];
+    size_t structSize;
+} BPlusTable;
+
+static BPlusTable tables[BPTREE_MAX_TREES];
+static int tablesNumber = 0;
+
+/**
+ * Compara duas chaves pelo grupo, pelo valor e pelo ID
+ * 
+ * @param const BPlusKey *a
+ * @param const BPlusKey *b
+ * 
+ * @return int: Negativo se a vier antes de b, 0 se forem iguais e positivo se a vier depois de b
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static int compareKeys(const BPlusKey *a, const BPlusKey *b) {
+    if (a->group != b->group) return a->group < b->group ? -1 : 1;
+    if (a->value != b->value) return a->value < b->value ? -1 : 1;
+    if (a->id != b->id) return a->id < b->id ? -1 : 1;
+    return 0;
+}
+
+/**
+ * Compara duas chaves, para o qsort
+ * 
+ * @param const void *a
+ * @param const void *b
+ * 
+ * @return int
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static int compareKeysForSort(const void *a, const void *b) {
+    return compareKeys((const BPlusKey*) a, (const BPlusKey*) b);
+}
+
+/**
+ * Retorna, por busca binária, a posição da primeira chave de um nó que não é menor que key (ou que é maior que key,
+ * se isUpper for verdadeiro)
+ * 
+ * @param const BPlusNode *node
+ * @param const BPlusKey *key
+ * @param bool isUpper
+ * 
+ * @return int
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static int searchNode(const BPlusNode *node, const BPlusKey *key, bool isUpper) {
+    int low = 0, high = node->count;
+
+    while (low < high) {
+        int middle = (low + high) / 2, comparison = compareKeys(&node->keys[middle], key);
+        if (comparison < 0 || (isUpper && comparison == 0)) low = middle + 1;
+        else high = middle;
+    }
+
+    return low;
+}
+
+/**
+ * Lê um nó da árvore
+ * 
+ * @param const char *filename
+ * @param int index: Posição do nó
+ * @param BPlusNode *node: Destino da leitura
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static bool readNode(const char *filename, int index, BPlusNode *node) {
+    return readElementFromFile(node, sizeof(BPlusNode), index, filename);
+}
+
+/**
+ * Sobrescreve um nó da árvore
+ * 
+ * @param const char *filename
+ * @param int index: Posição do nó
+ * @param const BPlusNode *node
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static bool writeNode(const char *filename, int index, const BPlusNode *node) {
+    return updateElementInFile(node, sizeof(BPlusNode), index, filename);
+}
+
+/**
+ * Grava um novo nó no fim do arquivo
+ * 
+ * @param const char *filename
+ * @param const BPlusNode *node
+ * 
+ * @return int: Posição do nó | -1, se houver alguma falha
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static int appendNode(const char *filename, const BPlusNode *node) {
+    return addElementToFile(node, sizeof(BPlusNode), filename) - 1;
+}
+
+/**
+ * Guarda a tabela de uma árvore, para que as alterações seguintes atualizem o estado da tabela no nó 0. Sem espaço
+ * para outra árvore, ou com nomes longos demais, a árvore não é registrada e será recriada na próxima abertura.
+ * 
+ * @param const char *filename: Caminho completo da árvore
+ * @param const char *table: Caminho completo da tabela
+ * @param const size_t structSize: Tamanho da struct da tabela
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static void registerBPlusTable(const char *filename, const char *table, const size_t structSize) {
+    if (strlen(filename) >= sizeof(tables[0].filename) || strlen(table) >= sizeof(tables[0].table)) return;
+
+    int i = 0;
+    while (i < tablesNumber && strcmp(tables[i].filename, filename) != 0) i++;
+    if (i == BPTREE_MAX_TREES) return;
+    if (i == tablesNumber) tablesNumber++;
+
+    strcpy(tables[i].filename, filename);
+    strcpy(tables[i].table, table);
+    tables[i].structSize = structSize;
+}
+
+/**
+ * Copia para o nó 0 o próximo ID e os números de registros ativos e excluídos de uma tabela
+ * 
+ * @param BPlusNode *meta
+ * @param const FileHeader *header: Cabeçalho da tabela
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static void setTableState(BPlusNode *meta, const FileHeader *header) {
+    meta->children[1] = header->nextId;
+    meta->children[2] = header->liveCount;
+    meta->children[3] = header->deletedCount;
+}
+
+/**
+ * Atualiza, no nó 0 de uma árvore registrada, o estado atual da sua tabela. Como as alterações da árvore são feitas
+ * na mesma transação e depois das da tabela, o estado gravado corresponde às chaves da árvore.
+ * 
+ * @param const char *filename: Caminho completo da árvore
+ * @param BPlusNode *meta
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static void refreshTableState(const char *filename, BPlusNode *meta) {
+    FileHeader header;
+
+    for (int i = 0; i < tablesNumber; i++) {
+        if (strcmp(tables[i].filename, filename) != 0) continue;
+        if (getFileHeader(tables[i].table, tables[i].structSize, &header)) setTableState(meta, &header);
+        return;
+    }
+}
+
+/**
+ * Verifica se uma árvore existente foi alterada pela última vez com a tabela no estado atual
+ * 
+ * @param const char *filename: Caminho completo da árvore
+ * @param const FileHeader *header: Cabeçalho atual da tabela
+ * @param BPlusNode *meta: Destino do nó 0
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static bool isTableStateCurrent(const char *filename, const FileHeader *header, BPlusNode *meta) {
+    return getNumberOfElements(filename, sizeof(BPlusNode)) > 1 && readNode(filename, 0, meta)
+        && meta->children[1] == header->nextId && meta->children[2] == header->liveCount
+        && meta->children[3] == header->deletedCount;
+}
+
+/**
+ * Desce da raiz até a folha em que uma chave deve estar, guardando as posições dos nós internos do caminho
+ * 
+ * @param const char *filename
+ * @param const BPlusKey *key
+ * @param BPlusNode *meta: Destino dos contadores da árvore
+ * @param BPlusNode *leaf: Destino da folha
+ * @param int *path: Destino das posições dos nós internos, da raiz até o pai da folha (pode ser NULL)
+ * @param int *depth: Destino do número de nós internos no caminho
+ * 
+ * @return int: Posição da folha | -1, se houver alguma falha
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static int findLeaf(const char *filename, const BPlusKey *key, BPlusNode *meta, BPlusNode *leaf, int *path, int *depth) {
+    if (!readNode(filename, 0, meta)) return -1;
+
+    int index = meta->children[0];
+    *depth = 0;
+    if (!readNode(filename, index, leaf)) return -1;
+
+    while (!leaf->isLeaf) {
+        if (*depth == BPTREE_MAX_HEIGHT) return -1;
+        if (path != NULL) path[*depth] = index;
+        (*depth)++;
+
+        index = leaf->children[searchNode(leaf, key, true)];
+        if (!readNode(filename, index, leaf)) return -1;
+    }
+
+    return index;
+}
+
+/**
+ * Mapeia a árvore em memória, para que a leitura de um nó seja apenas uma cópia, sem chamadas ao sistema
+ * 
+ * @param const char *filename: Caminho completo da árvore
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static bool mapBPlusTree(const char *filename) {
+    int nodesNumber;
+    return getMappedElements(filename, sizeof(BPlusNode), &nodesNumber) != NULL;
+}
+
+/**
+ * Recria a árvore a partir dos registros ativos de uma tabela, ordenando as chaves e montando a árvore de baixo para
+ * cima, com os nós preenchidos até BPTREE_FILL para que as próximas inserções raramente precisem dividi-los. Cada
+ * registro gera uma chave, por getKey, ou até maxKeys chaves, por getKeys.
+ * 
+ * @param const char *filename: Caminho completo da árvore
+ * @param const char *table: Caminho completo da tabela
+ * @param const size_t structSize: Tamanho da struct da tabela
+ * @param void (*getKey)(const void*, BPlusKey*): Monta a chave de um registro (NULL se getKeys for usada)
+ * @param int (*getKeys)(const void*, BPlusKey*): Monta as chaves de um registro e retorna quantas são
+ * @param int maxKeys: Número máximo de chaves de um registro
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static bool rebuildBPlusTree(const char *filename, const char *table, const size_t structSize, void (*getKey)(const void*, BPlusKey*), int (*getKeys)(const void*, BPlusKey*), int maxKeys) {
+    FileHeader header;
+    if (!getFileHeader(table, structSize, &header)) return false;
+
+    int keysNumber = 0, keysCapacity = header.liveCount > maxKeys ? header.liveCount : maxKeys;
+    BPlusKey *keys = (BPlusKey*) malloc(keysCapacity * sizeof(BPlusKey));
+    if (keys == NULL) return false;
+
+    Cursor cursor;
+    const void *element;
+    bool status = openCursor(&cursor, table, structSize, true);
+    while (status && (element = nextElement(&cursor)) != NULL) {
+        if (keysNumber + maxKeys > keysCapacity) {
+            BPlusKey *grown = (BPlusKey*) realloc(keys, 2 * keysCapacity * sizeof(BPlusKey));
+            if (grown == NULL) {
+                status = false;
+                break;
+            }
+            keys = grown;
+            keysCapacity *= 2;
+        }
+        if (getKeys != NULL) {
+            keysNumber += getKeys(element, &keys[keysNumber]);
+        } else {
+            getKey(element, &keys[keysNumber++]);
+        }
+    }
+    closeCursor(&cursor);
+    if (keysNumber > 1) qsort(keys, keysNumber, sizeof(BPlusKey), compareKeysForSort);
+
+    // Cada nível interno tem um nó para cada BPTREE_FILL + 1 nós do nível abaixo, mais o nó 0
+    int leavesNumber = keysNumber > 0 ? (keysNumber + BPTREE_FILL - 1) / BPTREE_FILL : 1;
+    int nodesCapacity = 1 + leavesNumber, nodesNumber = 1;
+    for (int levelNodes = leavesNumber; levelNodes > 1; nodesCapacity += levelNodes) {
+        levelNodes = (levelNodes + BPTREE_FILL) / (BPTREE_FILL + 1);
+    }
+    BPlusNode *nodes = (BPlusNode*) calloc(nodesCapacity, sizeof(BPlusNode));
+    int *level = (int*) malloc(leavesNumber * sizeof(int));
+    BPlusKey *lowKeys = (BPlusKey*) malloc(leavesNumber * sizeof(BPlusKey));
+    if (nodes == NULL || level == NULL || lowKeys == NULL) status = false;
+
+    int levelNumber = 0;
+    for (int i = 0; status && i < leavesNumber; i++) {
+        BPlusNode *leaf = &nodes[nodesNumber];
+        int first = i * BPTREE_FILL, count = keysNumber - first < BPTREE_FILL ? keysNumber - first : BPTREE_FILL;
+
+        leaf->isLeaf = 1;
+        leaf->count = count > 0 ? count : 0;
+        leaf->next = i + 1 < leavesNumber ? nodesNumber + 1 : 0;
+        if (count > 0) memcpy(leaf->keys, keys + first, count * sizeof(BPlusKey));
+        if (count > 0) lowKeys[levelNumber] = keys[first];
+        level[levelNumber++] = nodesNumber++;
+    }
+
+    // Cada nível interno agrupa até BPTREE_FILL + 1 nós do nível abaixo
+    while (status && levelNumber > 1) {
+        int parentsNumber = 0;
+        for (int i = 0; i < levelNumber; i += BPTREE_FILL + 1) {
+            BPlusNode *parent = &nodes[nodesNumber];
+            int count = levelNumber - i < BPTREE_FILL + 1 ? levelNumber - i : BPTREE_FILL + 1;
+
+            parent->isLeaf = 0;
+            parent->count = count - 1;
+            for (int j = 0; j < count; j++) {
+                parent->children[j] = level[i + j];
+                if (j > 0) parent->keys[j - 1] = lowKeys[i + j];
+            }
+            lowKeys[parentsNumber] = lowKeys[i];
+            level[parentsNumber++] = nodesNumber++;
+        }
+        levelNumber = parentsNumber;
+    }
+
+    if (status) {
+        nodes[0].count = keysNumber;
+        nodes[0].children[0] = level[0];
+        setTableState(&nodes[0], &header);
+        status = saveFile(nodes, sizeof(BPlusNode), nodesNumber, filename);
+    }
+
+    free(keys);
+    free(nodes);
+    free(level);
+    free(lowKeys);
+    return status;
+}
+
+/**
+ * Abre a árvore B+ de uma tabela. Se a árvore não existir, não tiver o mesmo número de chaves que a tabela tem de
+ * registros ativos ou tiver sido alterada pela última vez com a tabela em outro estado (veja BPlusNode), ela é
+ * recriada a partir da tabela.
+ * 
+ * @param const char *filename: Caminho completo da árvore
+ * @param const char *table: Caminho completo da tabela, já aberta com openFile
+ * @param const size_t structSize: Tamanho da struct da tabela
+ * @param void (*getKey)(const void*, BPlusKey*): Monta a chave de um registro
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool openBPlusTree(const char *filename, const char *table, const size_t structSize, void (*getKey)(const void*, BPlusKey*)) {
+    FileHeader header;
+    BPlusNode meta;
+    if (!getFileHeader(table, structSize, &header)) return false;
+
+    registerBPlusTable(filename, table, structSize);
+    if (isTableStateCurrent(filename, &header, &meta) && meta.count == header.liveCount) return mapBPlusTree(filename);
+
+    return rebuildBPlusTree(filename, table, structSize, getKey, NULL, 1) && mapBPlusTree(filename);
+}
+
+/**
+ * Abre uma árvore B+ em que cada registro da tabela pode ter várias chaves, como as palavras de um texto. Como o
+ * número de chaves não pode ser comparado com o da tabela, apenas o estado da tabela guardado no nó 0 é conferido,
+ * sem percorrer os registros; a árvore é recriada se não existir ou se a tabela tiver mudado sem ela.
+ * 
+ * @param const char *filename: Caminho completo da árvore
+ * @param const char *table: Caminho completo da tabela, já aberta com openFile
+ * @param const size_t structSize: Tamanho da struct da tabela
+ * @param int (*getKeys)(const void*, BPlusKey*): Monta as chaves de um registro e retorna quantas são
+ * @param int maxKeys: Número máximo de chaves de um registro
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool openMultiKeyBPlusTree(const char *filename, const char *table, const size_t structSize, int (*getKeys)(const void*, BPlusKey*), int maxKeys) {
+    FileHeader header;
+    BPlusNode meta;
+    if (!getFileHeader(table, structSize, &header)) return false;
+
+    registerBPlusTable(filename, table, structSize);
+    if (isTableStateCurrent(filename, &header, &meta)) return mapBPlusTree(filename);
+
+    return rebuildBPlusTree(filename, table, structSize, NULL, getKeys, maxKeys) && mapBPlusTree(filename);
+}
+
+/**
+ * Recria a árvore de uma tabela, descartando as folhas que as remoções deixaram vazias ou quase vazias e que os
+ * percursos de intervalos continuariam visitando. Deve ser chamada depois da compactação da tabela.
+ * 
+ * @param const char *filename: Caminho completo da árvore
+ * @param const char *table: Caminho completo da tabela, já aberta com openFile
+ * @param const size_t structSize: Tamanho da struct da tabela
+ * @param void (*getKey)(const void*, BPlusKey*): Monta a chave de um registro
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool compactBPlusTree(const char *filename, const char *table, const size_t structSize, void (*getKey)(const void*, BPlusKey*)) {
+    registerBPlusTable(filename, table, structSize);
+    return rebuildBPlusTree(filename, table, structSize, getKey, NULL, 1) && mapBPlusTree(filename);
+}
+
+/**
+ * Recria uma árvore em que cada registro da tabela pode ter várias chaves, como em compactBPlusTree
+ * 
+ * @param const char *filename: Caminho completo da árvore
+ * @param const char *table: Caminho completo da tabela, já aberta com openFile
+ * @param const size_t structSize: Tamanho da struct da tabela
+ * @param int (*getKeys)(const void*, BPlusKey*): Monta as chaves de um registro e retorna quantas são
+ * @param int maxKeys: Número máximo de chaves de um registro
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool compactMultiKeyBPlusTree(const char *filename, const char *table, const size_t structSize, int (*getKeys)(const void*, BPlusKey*), int maxKeys) {
+    registerBPlusTable(filename, table, structSize);
+    return rebuildBPlusTree(filename, table, structSize, NULL, getKeys, maxKeys) && mapBPlusTree(filename);
+}
+
+/**
+ * Insere uma chave na árvore. Um nó cheio é dividido ao meio e a menor chave da nova metade sobe para o pai, o que
+ * pode dividir os nós acima e, no limite, criar uma nova raiz. Todas as escritas fazem parte de uma única transação.
+ * 
+ * @param const char *filename: Caminho completo da árvore
+ * @param const BPlusKey *key
+ * 
+ * @return bool: Retorna false se a chave já estiver na árvore ou se houver alguma falha
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool insertIntoBPlusTree(const char *filename, const BPlusKey *key) {
+    BPlusNode meta, node, right;
+    int path[BPTREE_MAX_HEIGHT], depth;
+
+    int index = findLeaf(filename, key, &meta, &node, path, &depth);
+    if (index < 0) return false;
+
+    int position = searchNode(&node, key, false);
+    if (position < node.count && compareKeys(&node.keys[position], key) == 0) return false;
+
+    memmove(&node.keys[position + 1], &node.keys[position], (node.count - position) * sizeof(BPlusKey));
+    node.keys[position] = *key;
+    node.count++;
+
+    beginTransaction();
+    bool status = true, isPlaced = node.count <= BPTREE_ORDER;
+    BPlusKey separator;
+    int rightIndex = 0;
+
+    if (isPlaced) {
+        status = writeNode(filename, index, &node);
+    } else {
+        int half = node.count / 2;
+        memset(&right, 0, sizeof(BPlusNode));
+        right.isLeaf = 1;
+        right.count = node.count - half;
+        right.next = node.next;
+        memcpy(right.keys, &node.keys[half], right.count * sizeof(BPlusKey));
+        node.count = half;
+
+        rightIndex = appendNode(filename, &right);
+        node.next = rightIndex;
+        separator = right.keys[0];
+        status = rightIndex > 0 && writeNode(filename, index, &node);
+    }
+
+    // A chave separadora sobe enquanto os nós do caminho estiverem cheios
+    while (status && !isPlaced && depth > 0) {
+        index = path[--depth];
+        status = readNode(filename, index, &node);
+        if (!status) break;
+
+        position = searchNode(&node, &separator, true);
+        memmove(&node.keys[position + 1], &node.keys[position], (node.count - position) * sizeof(BPlusKey));
+        memmove(&node.children[position + 2], &node.children[position + 1], (node.count - position) * sizeof(int));
+        node.keys[position] = separator;
+        node.children[position + 1] = rightIndex;
+        node.count++;
+
+        isPlaced = node.count <= BPTREE_ORDER;
+        if (isPlaced) {
+            status = writeNode(filename, index, &node);
+            break;
+        }
+
+        int half = node.count / 2;
+        memset(&right, 0, sizeof(BPlusNode));
+        right.count = node.count - half - 1;
+        memcpy(right.keys, &node.keys[half + 1], right.count * sizeof(BPlusKey));
+        memcpy(right.children, &node.children[half + 1], (right.count + 1) * sizeof(int));
+        separator = node.keys[half];
+        node.count = half;
+
+        rightIndex = appendNode(filename, &right);
+        status = rightIndex > 0 && writeNode(filename, index, &node);
+    }
+
+    if (status && !isPlaced) {
+        BPlusNode root;
+        memset(&root, 0, sizeof(BPlusNode));
+        root.count = 1;
+        root.keys[0] = separator;
+        root.children[0] = meta.children[0];
+        root.children[1] = rightIndex;
+
+        meta.children[0] = appendNode(filename, &root);
+        status = meta.children[0] > 0;
+    }
+
+    meta.count++;
+    refreshTableState(filename, &meta);
+    status = status && writeNode(filename, 0, &meta);
+    if (!status) {
+        rollbackTransaction();
+        return false;
+    }
+
+    return commitTransaction();
+}
+
+/**
+ * Remove uma chave da sua folha. Os nós não são rebalanceados: uma folha pode ficar com poucas chaves (ou nenhuma)
+ * até a árvore ser recriada por compactBPlusTree, sem prejudicar o resultado das buscas.
+ * 
+ * @param const char *filename: Caminho completo da árvore
+ * @param const BPlusKey *key
+ * 
+ * @return bool: Retorna false apenas se houver falha na leitura ou na escrita da árvore
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool removeFromBPlusTree(const char *filename, const BPlusKey *key) {
+    BPlusNode meta, leaf;
+    int depth;
+
+    int index = findLeaf(filename, key, &meta, &leaf, NULL, &depth);
+    if (index < 0) return false;
+
+    int position = searchNode(&leaf, key, false);
+    if (position >= leaf.count || compareKeys(&leaf.keys[position], key) != 0) return true;
+
+    memmove(&leaf.keys[position], &leaf.keys[position + 1], (leaf.count - position - 1) * sizeof(BPlusKey));
+    leaf.count--;
+    meta.count--;
+    refreshTableState(filename, &meta);
+
+    beginTransaction();
+    if (!writeNode(filename, index, &leaf) || !writeNode(filename, 0, &meta)) {
+        rollbackTransaction();
+        return false;
+    }
+
+    return commitTransaction();
+}
+
+/**
+ * Insere várias chaves na árvore, em uma única transação
+ * 
+ * @param const char *filename: Caminho completo da árvore
+ * @param const BPlusKey *keys
+ * @param int keysNumber
+ * 
+ * @return bool: Retorna false se alguma chave já estiver na árvore ou se houver alguma falha; nesse caso, nenhuma
+ * chave é inserida
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool insertKeysIntoBPlusTree(const char *filename, const BPlusKey *keys, int keysNumber) {
+    bool status = true;
+
+    beginTransaction();
+    for (int i = 0; status && i < keysNumber; i++) status = insertIntoBPlusTree(filename, &keys[i]);
+    if (status) return commitTransaction();
+
+    rollbackTransaction();
+    return false;
+}
+
+/**
+ * Remove várias chaves da árvore, em uma única transação
+ * 
+ * @param const char *filename: Caminho completo da árvore
+ * @param const BPlusKey *keys
+ * @param int keysNumber
+ * 
+ * @return bool: Retorna false se houver falha na leitura ou na escrita da árvore; nesse caso, nenhuma chave é removida
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool removeKeysFromBPlusTree(const char *filename, const BPlusKey *keys, int keysNumber) {
+    bool status = true;
+
+    beginTransaction();
+    for (int i = 0; status && i < keysNumber; i++) status = removeFromBPlusTree(filename, &keys[i]);
+    if (status) return commitTransaction();
+
+    rollbackTransaction();
+    return false;
+}
+
+/**
+ * Troca, em uma única transação, as chaves que um texto gera na árvore, como as de um nome em um índice de trigramas,
+ * caso o texto tenha mudado ou o registro tenha sido excluído. As chaves são montadas pela função informada, que
+ * define o tipo de índice.
+ * 
+ * @param const char *filename: Caminho completo da árvore
+ * @param const char *currentText: Texto atual | NULL, para um registro novo
+ * @param const char *newText: Novo texto
+ * @param int id: ID do registro
+ * @param bool isDeleted: Indica se o registro foi excluído, caso em que as chaves são apenas removidas
+ * @param int (*getKeys)(const char*, int, BPlusKey*): Monta as chaves de um texto e retorna o número delas
+ * @param int maxKeys: Número máximo de chaves de um texto
+ * 
+ * @return bool: Retorna false se houver falha na leitura ou na escrita da árvore; nesse caso, nenhuma chave é trocada
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool replaceTextKeys(const char *filename, const char *currentText, const char *newText, int id, bool isDeleted, int (*getKeys)(const char*, int, BPlusKey*), int maxKeys) {
+    if (!isDeleted && currentText != NULL && strcmp(currentText, newText) == 0) return true;
+
+    BPlusKey *keys = (BPlusKey*) malloc(maxKeys * sizeof(BPlusKey));
+    if (keys == NULL) return false;
+
+    BPlusNode meta;
+    bool status = true;
+    beginTransaction();
+    if (currentText != NULL) status = removeKeysFromBPlusTree(filename, keys, getKeys(currentText, id, keys));
+    if (status && !isDeleted) status = insertKeysIntoBPlusTree(filename, keys, getKeys(newText, id, keys));
+    free(keys);
+
+    // Um texto sem chaves não altera a árvore, mas o registro mudou a tabela
+    status = status && readNode(filename, 0, &meta);
+    if (status) {
+        refreshTableState(filename, &meta);
+        status = writeNode(filename, 0, &meta);
+    }
+    if (status) return commitTransaction();
+
+    rollbackTransaction();
+    return false;
+}
+
+/**
+ * Posiciona um cursor na primeira chave do intervalo [from, to), descendo da raiz até a folha em O(log n). As chaves
+ * seguintes são lidas em ordem por nextBPlusKey, seguindo as folhas.
+ * 
+ * @param BPlusCursor *cursor
+ * @param const char *filename: Caminho completo da árvore
+ * @param const BPlusKey *from: Primeira chave do intervalo
+ * @param const BPlusKey *to: Chave logo após o fim do intervalo
+ * 
+ * @return bool: Retorna false se houver falha na leitura da árvore
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool seekBPlusTree(BPlusCursor *cursor, const char *filename, const BPlusKey *from, const BPlusKey *to) {
+    BPlusNode meta;
+    int depth;
+
+    cursor->filename = filename;
+    cursor->end = *to;
+    if (findLeaf(filename, from, &meta, &cursor->leaf, NULL, &depth) < 0) {
+        cursor->leaf.count = 0;
+        cursor->leaf.next = 0;
+        cursor->position = 0;
+        return false;
+    }
+
+    cursor->position = searchNode(&cursor->leaf, from, false);
+    return true;
+}
+
+/**
+ * Retorna a próxima chave de um cursor
+ * 
+ * @param BPlusCursor *cursor
+ * 
+ * @return const BPlusKey*|NULL: Próxima chave | NULL, ao fim do intervalo
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+const BPlusKey* nextBPlusKey(BPlusCursor *cursor) {
+    while (cursor->position >= cursor->leaf.count) {
+        if (cursor->leaf.next == 0 || !readNode(cursor->filename, cursor->leaf.next, &cursor->leaf)) return NULL;
+        cursor->position = 0;
+    }
+
+    const BPlusKey *key = &cursor->leaf.keys[cursor->position];
+    if (compareKeys(key, &cursor->end) >= 0) return NULL;
+
+    cursor->position++;
+    return key;
+}
+
+/**
+ * Avança um cursor até a primeira chave maior ou igual a key, sem sair do intervalo do cursor. Se a chave estiver na
+ * folha atual, a busca é feita apenas na folha; caso contrário, o cursor desce novamente da raiz. Chaves menores que
+ * key que ainda não foram lidas são descartadas.
+ * 
+ * @param BPlusCursor *cursor
+ * @param const BPlusKey *key
+ * 
+ * @return const BPlusKey*|NULL: Primeira chave maior ou igual a key, já consumida | NULL, ao fim do intervalo
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+const BPlusKey* advanceBPlusCursor(BPlusCursor *cursor, const BPlusKey *key) {
+    if (cursor->leaf.count == 0 || compareKeys(&cursor->leaf.keys[cursor->leaf.count - 1], key) < 0) {
+        BPlusKey end = cursor->end;
+        if (!seekBPlusTree(cursor, cursor->filename, key, &end)) return NULL;
+    } else {
+        cursor->position = searchNode(&cursor->leaf, key, false);
+    }
+
+    return nextBPlusKey(cursor);
+}
+
+/**
+ * Percorre, em ordem crescente, os IDs presentes em todas as listas dos grupos informados, em que a lista de um grupo
+ * são as chaves {grupo, 0, ID}, como nos índices invertidos. As listas são intersectadas saltando de ID em ID, com um
+ * cursor por lista: cada cursor avança até o candidato atual e, se encontrar um ID maior, este se torna o novo
+ * candidato. Um salto dentro da folha atual é uma busca binária na folha; os demais descem a árvore em O(log n).
+ * 
+ * @param const char *filename: Caminho completo da árvore
+ * @param const int *groups
+ * @param int groupsNumber
+ * @param bool (*visit)(int, void*): Função chamada com cada ID da interseção e com context; a busca termina quando ela
+ * retorna false
+ * @param void *context
+ * 
+ * @return bool: Retorna false se houver alguma falha na leitura da árvore ou se não houver memória disponível
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool intersectBPlusGroups(const char *filename, const int *groups, int groupsNumber, bool (*visit)(int, void*), void *context) {
+    if (groupsNumber <= 0) return true;
+
+    BPlusCursor *cursors = (BPlusCursor*) malloc(groupsNumber * sizeof(BPlusCursor));
+    if (cursors == NULL) return false;
+
+    bool status = true;
+    for (int i = 0; status && i < groupsNumber; i++) {
+        BPlusKey from = {groups[i], 0, 0}, to = {groups[i], 1, 0};
+        status = seekBPlusTree(&cursors[i], filename, &from, &to);
+    }
+
+    int candidate = 1, agreeing = 0;
+    for (int i = 0; status; i = (i + 1) % groupsNumber) {
+        BPlusKey target = {groups[i], 0, candidate};
+        const BPlusKey *found = advanceBPlusCursor(&cursors[i], &target);
+        if (found == NULL) break;
+
+        if (found->id != candidate) {
+            candidate = found->id;
+            agreeing = 0;
+        }
+        if (++agreeing < groupsNumber) continue;
+
+        if (!visit(candidate, context)) break;
+        candidate++;
+        agreeing = 0;
+    }
+    free(cursors);
+
+    return status;
+}
@@ -0,0 +1,75 @@
+#ifndef BPTREE
+#define BPTREE
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#define BPTREE_ORDER 32
+#define BPTREE_FILL (BPTREE_ORDER * 3 / 4)
+#define BPTREE_MAX_HEIGHT 16
+#define BPTREE_MAX_TREES 16
+
+/**
+ * Chave de uma árvore B+, ordenada por grupo (como o código do advogado), valor (como o início do agendamento) e ID do
+ * registro. O ID torna cada chave única.
+ */
+typedef struct BPlusKey {
+    int group;
+    int value;
+    int id;
+} BPlusKey;
+
+/**
+ * Nó de uma árvore B+ gravada em disco, identificado pela sua posição no arquivo. Nas folhas, keys guarda as chaves e
+ * next a posição da folha seguinte (0 na última). Nos nós internos, keys[i] é a menor chave da subárvore children[i + 1].
+ * Os vetores têm uma posição extra, usada apenas durante a divisão de um nó cheio.
+ * 
+ * O nó 0 guarda os contadores da árvore: em children[0], a posição da raiz, e em count, o número de chaves. Em
+ * children[1], children[2] e children[3], guarda o próximo ID e os números de registros ativos e excluídos da tabela
+ * na última vez em que a árvore foi alterada, para que a abertura perceba mudanças na tabela sem percorrê-la.
+ */
+typedef struct BPlusNode {
+    int isLeaf;
+    int count;
+    int next;
+    BPlusKey keys[BPTREE_ORDER + 1];
+    int children[BPTREE_ORDER + 2];
+} BPlusNode;
+
+/**
+ * Cursor para percorrer, em ordem, as chaves de um intervalo de uma árvore B+, lendo uma folha por vez
+ */
+typedef struct BPlusCursor {
+    const char *filename;
+    BPlusNode leaf;
+    int position;
+    BPlusKey end;
+} BPlusCursor;
+
+bool openBPlusTree(const char*, const char*, const size_t, void (*)(const void*, BPlusKey*));
+
+bool openMultiKeyBPlusTree(const char*, const char*, const size_t, int (*)(const void*, BPlusKey*), int);
+
+bool compactBPlusTree(const char*, const char*, const size_t, void (*)(const void*, BPlusKey*));
+
+bool compactMultiKeyBPlusTree(const char*, const char*, const size_t, int (*)(const void*, BPlusKey*), int);
+
+bool insertIntoBPlusTree(const char*, const BPlusKey*);
+
+bool removeFromBPlusTree(const char*, const BPlusKey*);
+
+bool insertKeysIntoBPlusTree(const char*, const BPlusKey*, int);
+
+bool removeKeysFromBPlusTree(const char*, const BPlusKey*, int);
+
+bool replaceTextKeys(const char*, const char*, const char*, int, bool, int (*)(const char*, int, BPlusKey*), int);
+
+bool seekBPlusTree(BPlusCursor*, const char*, const BPlusKey*, const BPlusKey*);
+
+const BPlusKey* nextBPlusKey(BPlusCursor*);
+
+const BPlusKey* advanceBPlusCursor(BPlusCursor*, const BPlusKey*);
+
+bool intersectBPlusGroups(const char*, const int*, int, bool (*)(int, void*), void*);
+
+#endif
@@ -0,0 +1,225 @@
+#include <stdbool.h>
+#include "./calendar.h"
+#include "./date.h"
+
+/**
+ * Número de dias de cada mês e número de dias do ano antes do início de cada mês, em anos comuns (linha 0) e
+ * bissextos (linha 1). A posição 0 não corresponde a um mês.
+ */
+static const unsigned char DAYS_IN_MONTH[2][13] = {
+    {0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31},
+    {0, 31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31}
+};
+static const short DAYS_BEFORE_MONTH[2][13] = {
+    {0, 0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334},
+    {0, 0, 31, 60, 91, 121, 152, 182, 213, 244, 274, 305, 335}
+};
+
+static const char WEEKDAY_NAMES[DAYS_PER_WEEK][14] = {
+    "domingo", "segunda-feira", "terça-feira", "quarta-feira", "quinta-feira", "sexta-feira", "sábado"
+};
+
+/**
+ * Dias entre 01/01/0001 e 01/01/1970 no calendário gregoriano proléptico
+ */
+#define DAYS_BEFORE_EPOCH 719162L
+
+/**
+ * Divide dois números arredondando o resultado para baixo, também para dividendos negativos
+ * 
+ * @param long dividend
+ * @param long divisor: Positivo
+ * 
+ * @return long
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static long floorDivide(long dividend, long divisor) {
+    return dividend >= 0 ? dividend / divisor : -((-dividend + divisor - 1) / divisor);
+}
+
+/**
+ * Verifica se um ano é bissexto, retornando 1 ou 0 para indexar as tabelas
+ * 
+ * @param long year
+ * 
+ * @return int
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static int leapIndex(long year) {
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+/**
+ * Retorna o número de dias de um mês
+ * 
+ * @param int month
+ * @param int year
+ * 
+ * @return int: Número de dias | 0, se o mês for inválido
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+int getDaysInMonth(int month, int year) {
+    if (month < 1 || month > 12) return 0;
+    return DAYS_IN_MONTH[leapIndex(year)][month];
+}
+
+/**
+ * Converte uma data em número de dias desde 01/01/1970 (negativo para datas anteriores), somando os dias dos anos
+ * completos à tabela de dias antes de cada mês
+ * 
+ * @param int year
+ * @param int month
+ * @param int day
+ * 
+ * @return long
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+long daysFromCivil(int year, int month, int day) {
+    long previousYear = (long) year - 1;
+    long days = previousYear * 365 + floorDivide(previousYear, 4) - floorDivide(previousYear, 100) + floorDivide(previousYear, 400);
+
+    return days + DAYS_BEFORE_MONTH[leapIndex(year)][month] + day - 1 - DAYS_BEFORE_EPOCH;
+}
+
+/**
+ * Converte um número de dias desde 01/01/1970 na data correspondente
+ * 
+ * @param long days
+ * @param int *year
+ * @param int *month
+ * @param int *day
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ * 
+ * References:
+ *  - https://howardhinnant.github.io/date_algorithms.html#civil_from_days
+ */
+void civilFromDays(long days, int *year, int *month, int *day) {
+    days += 719468;
+    long era = floorDivide(days, 146097);
+    long dayOfEra = days - era * 146097;
+    long yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    long dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    long monthIndex = (5 * dayOfYear + 2) / 153;
+
+    *day = (int) (dayOfYear - (153 * monthIndex + 2) / 5 + 1);
+    *month = (int) (monthIndex < 10 ? monthIndex + 3 : monthIndex - 9);
+    *year = (int) (yearOfEra + era * 400 + (*month <= 2));
+}
+
+/**
+ * Retorna o dia da semana de um dia (01/01/1970 foi uma quinta-feira)
+ * 
+ * @param long days: Dias desde 01/01/1970
+ * 
+ * @return Weekday
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+Weekday getWeekday(long days) {
+    long shifted = days + THURSDAY;
+    return (Weekday) (shifted - floorDivide(shifted, DAYS_PER_WEEK) * DAYS_PER_WEEK);
+}
+
+/**
+ * Retorna o nome de um dia da semana
+ * 
+ * @param Weekday weekday
+ * 
+ * @return const char*
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+const char* getWeekdayName(Weekday weekday) {
+    return WEEKDAY_NAMES[(int) weekday % DAYS_PER_WEEK];
+}
+
+/**
+ * Retorna o dia de um instante
+ * 
+ * @param long minutes: Minutos desde 01/01/1970
+ * 
+ * @return long: Dias desde 01/01/1970
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+long minutesToDays(long minutes) {
+    return floorDivide(minutes, MINUTES_PER_DAY);
+}
+
+/**
+ * Retorna o minuto do dia de um instante (de 0 a 1439)
+ * 
+ * @param long minutes: Minutos desde 01/01/1970
+ * 
+ * @return int
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+int getMinuteOfDay(long minutes) {
+    return (int) (minutes - minutesToDays(minutes) * MINUTES_PER_DAY);
+}
+
+/**
+ * Soma (ou subtrai, se negativo) um número de minutos a uma data e horário, passando de um dia, mês ou ano para o
+ * seguinte quando necessário
+ * 
+ * @param Datetime *datetime
+ * @param long minutes
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+void addMinutesToDatetime(Datetime *datetime, long minutes) {
+    minutesToDatetime(datetimeToMinutes(datetime) + minutes, datetime);
+}
+
+/**
+ * Retorna o número de minutos entre duas datas e horários
+ * 
+ * @param const Datetime *start
+ * @param const Datetime *end
+ * 
+ * @return long: Negativo se end for anterior a start
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+long getDuration(const Datetime *start, const Datetime *end) {
+    return datetimeToMinutes(end) - datetimeToMinutes(start);
+}
+
+/**
+ * Verifica se dois intervalos [startA, endA) e [startB, endB) se sobrepõem. Intervalos que apenas se encostam não se
+ * sobrepõem.
+ * 
+ * @param long startA
+ * @param long endA
+ * @param long startB
+ * @param long endB
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool rangesOverlap(long startA, long endA, long startB, long endB) {
+    return startA < endB && startB < endA;
+}
@@ -0,0 +1,40 @@
+#ifndef CALENDAR
+#define CALENDAR
+
+#include <stdbool.h>
+#include "./date.h"
+
+#define MINUTES_PER_DAY (24 * 60)
+#define DAYS_PER_WEEK 7
+
+typedef enum Weekday {
+    SUNDAY,
+    MONDAY,
+    TUESDAY,
+    WEDNESDAY,
+    THURSDAY,
+    FRIDAY,
+    SATURDAY
+} Weekday;
+
+int getDaysInMonth(int, int);
+
+long daysFromCivil(int, int, int);
+
+void civilFromDays(long, int*, int*, int*);
+
+Weekday getWeekday(long);
+
+const char* getWeekdayName(Weekday);
+
+long minutesToDays(long);
+
+int getMinuteOfDay(long);
+
+void addMinutesToDatetime(Datetime*, long);
+
+long getDuration(const Datetime*, const Datetime*);
+
+bool rangesOverlap(long, long, long, long);
+
+#endif
@@ -1,7 +1,91 @@
 #include "./date.h"
-#include "./str.h"
+#include "./calendar.h"
 #include <stdio.h>
-#include <string.h>
+#include <limits.h>
+
+/**
+ * Campo preenchido por cada posição dos formatos dd/mm/aaaa e hh:mm (-1 nas posições do separador)
+ */
+static const signed char DATE_LAYOUT[DATE_SIZE - 1] = {0, 0, -1, 1, 1, -1, 2, 2, 2, 2};
+static const signed char TIME_LAYOUT[TIME_SIZE - 1] = {0, 0, -1, 1, 1};
+
+/**
+ * Lê, em uma única passagem, os campos numéricos de um texto de formato fixo. Os erros de cada posição são combinados em
+ * uma máscara, verificada apenas ao final, em vez de interromper a leitura a cada caractere.
+ * 
+ * @param const char *text
+ * @param const signed char *layout: Campo de cada posição do formato
+ * @param int length: Tamanho do formato
+ * @param char separator
+ * @param int fields[3]: Destino dos campos
+ * 
+ * @return bool: Retorna false se o texto não seguir o formato
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static bool parseFixedFormat(const char *text, const signed char *layout, int length, char separator, int *fields) {
+    unsigned int invalid = 0;
+    fields[0] = fields[1] = fields[2] = 0;
+
+    for (int i = 0; i < length; i++) {
+        if (text[i] == '\0') return false;
+
+        unsigned int digit = (unsigned int) (unsigned char) text[i] - '0';
+        int field = layout[i];
+
+        invalid |= field < 0 ? (unsigned int) (text[i] != separator) : (unsigned int) (digit > 9);
+        if (field >= 0) fields[field] = fields[field] * 10 + (int) (digit & 0xF);
+    }
+
+    return invalid == 0 && text[length] == '\0';
+}
+
+/**
+ * Valida e converte uma data no formato dd/mm/aaaa, em uma única passagem. O dia é conferido com a tabela de dias de
+ * cada mês, e o ano vai até DATE_MAX_YEAR, o último cujos instantes cabem no int usado pelos registros.
+ * 
+ * @param const char *date
+ * @param Datetime *datetime: Destino do dia, do mês e do ano
+ * 
+ * @return bool: Retorna false se a data não estiver no formato ou não existir
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool parseDate(const char *date, Datetime *datetime) {
+    int fields[3];
+    if (date == NULL || !parseFixedFormat(date, DATE_LAYOUT, DATE_SIZE - 1, '/', fields)) return false;
+
+    int day = fields[0], month = fields[1], year = fields[2];
+    if (year < 1 || year > DATE_MAX_YEAR || day < 1 || day > getDaysInMonth(month, year)) return false;
+
+    datetime->day = day;
+    datetime->month = month;
+    datetime->year = year;
+    return true;
+}
+
+/**
+ * Valida e converte um horário no formato hh:mm, em uma única passagem
+ * 
+ * @param const char *time
+ * @param Datetime *datetime: Destino da hora e do minuto
+ * 
+ * @return bool: Retorna false se o horário não estiver no formato ou não existir
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool parseTime(const char *time, Datetime *datetime) {
+    int fields[3];
+    if (time == NULL || !parseFixedFormat(time, TIME_LAYOUT, TIME_SIZE - 1, ':', fields)) return false;
+    if (fields[0] > 23 || fields[1] > 59) return false;
+
+    datetime->hour = fields[0];
+    datetime->minute = fields[1];
+    return true;
+}
 
 /**
  * Carrega uma data e horário em uma struct Datetime
@@ -10,28 +94,139 @@
  * @param const char date[11]
  * @param const char time[6]
  * 
+ * @return bool: Retorna false se a data ou o horário forem inválidos
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool loadDatetime(Datetime *datetime, const char *date, const char *time) {
+    return parseDate(date, datetime) && parseTime(time, datetime);
+}
+
+/**
+ * Converte uma data e horário para o número de minutos desde 01/01/1970 00:00, permitindo comparar e medir intervalos
+ * 
+ * @param const Datetime *datetime
+ * 
+ * @return long
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+long datetimeToMinutes(const Datetime *datetime) {
+    long days = daysFromCivil(datetime->year, datetime->month, datetime->day);
+    return days * MINUTES_PER_DAY + datetime->hour * 60 + datetime->minute;
+}
+
+/**
+ * Carrega em uma struct Datetime a data e horário correspondentes a um número de minutos desde 01/01/1970 00:00
+ * 
+ * @param long minutes
+ * @param Datetime *datetime
+ * 
  * @return void
  * 
  * Authors:
  *  - https://github.com/akemi-adam
  */
-void loadDatetime(Datetime *datetime, const char *date, const char *time) {
-    char strYear[5], strMonth[3], strDay[3], strHour[3], strMinute[3];
-    
-    strncpy(strDay, date, 2);
-    strncpy(strMonth, date + 3, 2);
-    strncpy(strYear, date + 6, 4);
-    strncpy(strHour, time, 2);
-    strncpy(strMinute, time + 3, 2);
+void minutesToDatetime(long minutes, Datetime *datetime) {
+    int minuteOfDay = getMinuteOfDay(minutes);
+
+    civilFromDays(minutesToDays(minutes), &datetime->year, &datetime->month, &datetime->day);
+    datetime->hour = minuteOfDay / 60;
+    datetime->minute = minuteOfDay % 60;
+}
+
+/**
+ * Converte uma data e horário para o número de minutos desde 01/01/1970 00:00 no int usado pelos registros. Os campos
+ * são conferidos, já que podem vir de registros antigos gravados com lixo.
+ * 
+ * @param const Datetime *datetime
+ * @param int *minutes: Destino da conversão
+ * 
+ * @return bool: Retorna false se a data ou o horário não existirem ou se o instante não couber em um int (a partir de
+ * 6053, aproximadamente)
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool datetimeToStoredMinutes(const Datetime *datetime, int *minutes) {
+    if (datetime->year < 1 || datetime->day < 1 || datetime->day > getDaysInMonth(datetime->month, datetime->year)) return false;
+    if (datetime->hour < 0 || datetime->hour > 23 || datetime->minute < 0 || datetime->minute > 59) return false;
+
+    long value = datetimeToMinutes(datetime);
+    if (value < INT_MIN || value > INT_MAX) return false;
 
-    strcpy(datetime->onlyDate, date);
-    strcpy(datetime->time, time);
+    *minutes = (int) value;
+    return true;
+}
 
-    parseInt(strYear, &datetime->year);
-    parseInt(strMonth, &datetime->month);
-    parseInt(strDay, &datetime->day);
-    parseInt(strHour, &datetime->hour);
-    parseInt(strMinute, &datetime->minute);
+/**
+ * Converte uma data e um horário em texto para o número de minutos desde 01/01/1970 00:00, a forma em que as datas são
+ * armazenadas nos registros
+ * 
+ * @param const char date[11]: Data (dd/mm/aaaa)
+ * @param const char time[6]: Horário (hh:mm)
+ * @param int *minutes: Destino da conversão
+ * 
+ * @return bool: Retorna false se a data ou o horário não puderem ser convertidos ou se o instante não couber no
+ * registro
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool parseDatetime(const char *date, const char *time, int *minutes) {
+    Datetime datetime;
+    return loadDatetime(&datetime, date, time) && datetimeToStoredMinutes(&datetime, minutes);
+}
 
-    sprintf(datetime->date, "%s %s", date, time);
+/**
+ * Formata a data de um instante no formato dd/mm/aaaa
+ * 
+ * @param long minutes: Minutos desde 01/01/1970
+ * @param char date[11]: Destino do texto
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+void formatDate(long minutes, char *date) {
+    Datetime datetime;
+    minutesToDatetime(minutes, &datetime);
+    snprintf(date, DATE_SIZE, "%02u/%02u/%04u", (unsigned) datetime.day % 100, (unsigned) datetime.month % 100, (unsigned) datetime.year % 10000);
+}
+
+/**
+ * Formata o horário de um instante no formato hh:mm
+ * 
+ * @param long minutes: Minutos desde 01/01/1970
+ * @param char time[6]: Destino do texto
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+void formatTime(long minutes, char *time) {
+    Datetime datetime;
+    minutesToDatetime(minutes, &datetime);
+    snprintf(time, TIME_SIZE, "%02u:%02u", (unsigned) datetime.hour % 100, (unsigned) datetime.minute % 100);
+}
+
+/**
+ * Formata a data e o horário de um instante no formato dd/mm/aaaa hh:mm
+ * 
+ * @param long minutes: Minutos desde 01/01/1970
+ * @param char datetime[17]: Destino do texto
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+void formatDatetime(long minutes, char *datetime) {
+    formatDate(minutes, datetime);
+    datetime[DATE_SIZE - 1] = ' ';
+    formatTime(minutes, datetime + DATE_SIZE);
 }
\ No newline at end of file
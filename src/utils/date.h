@@ -1,17 +1,39 @@
 #ifndef DATE
 #define DATE
 
+#include <stdbool.h>
+
+#define DATE_SIZE 11
+#define TIME_SIZE 6
+#define DATETIME_SIZE 17
+#define DATE_MAX_YEAR 6052
+
 typedef struct Datetime {
     int day;
     int month;
     int year;
     int hour;
     int minute;
-    char date[18];
-    char onlyDate[11];
-    char time[6];
 } Datetime;
 
-void loadDatetime(Datetime*, const char*, const char*);
+bool parseDate(const char*, Datetime*);
+
+bool parseTime(const char*, Datetime*);
+
+bool loadDatetime(Datetime*, const char*, const char*);
+
+long datetimeToMinutes(const Datetime*);
+
+void minutesToDatetime(long, Datetime*);
+
+bool datetimeToStoredMinutes(const Datetime*, int*);
+
+bool parseDatetime(const char*, const char*, int*);
+
+void formatDate(long, char*);
+
+void formatTime(long, char*);
+
+void formatDatetime(long, char*);
 
 #endif
\ No newline at end of file
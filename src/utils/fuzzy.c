@@ -0,0 +1,462 @@
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <pthread.h>
+#ifdef __unix__
+    #include <unistd.h>
+#endif
+#include "./storage.h"
+#include "./str.h"
+#include "./fuzzy.h"
+
+/**
+ * Textos normalizados dos registros ativos de uma tabela, gravados em sequência, com a versão da tabela em que foram
+ * lidos
+ */
+typedef struct FuzzyColumn {
+    char table[64];
+    size_t textOffset;
+    unsigned long version;
+    int textsNumber;
+    int *ids;
+    int *offsets;
+    uint64_t *characters;
+    uint64_t *bigrams;
+    char *texts;
+} FuzzyColumn;
+
+/**
+ * Parte de uma coluna percorrida por uma thread da busca aproximada, com os melhores registros encontrados nela
+ */
+typedef struct FuzzyTask {
+    const FuzzyPattern *pattern;
+    const FuzzyColumn *column;
+    int from;
+    int to;
+    int maxDistance;
+    int maxMatches;
+    int matchesNumber;
+    FuzzyMatch matches[FUZZY_MAX_MATCHES];
+} FuzzyTask;
+
+static FuzzyColumn columns[FUZZY_MAX_COLUMNS];
+
+/**
+ * Retorna o bit de um caractere normalizado na assinatura de caracteres de um texto
+ * 
+ * @param unsigned char c
+ * 
+ * @return int
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static int getCharacterBit(unsigned char c) {
+    return c & 63;
+}
+
+/**
+ * Retorna o bit de um par de caracteres vizinhos na assinatura de pares de um texto, espalhando os pares pelos 64 bits
+ * com um hash multiplicativo
+ * 
+ * @param unsigned char first
+ * @param unsigned char second
+ * 
+ * @return int
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static int getBigramBit(unsigned char first, unsigned char second) {
+    return (int) ((((uint32_t) first << 8 | second) * UINT32_C(0x9E3779B1)) >> 26);
+}
+
+/**
+ * Normaliza a consulta e monta, para cada caractere, a máscara com as posições em que ele aparece na consulta
+ * 
+ * @param const char *query
+ * @param FuzzyPattern *pattern: Destino da consulta pré-processada
+ * 
+ * @return bool: Retorna false se a consulta normalizada for vazia ou tiver mais de FUZZY_MAX_PATTERN caracteres
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool compileFuzzyPattern(const char *query, FuzzyPattern *pattern) {
+    char folded[FUZZY_TEXT_SIZE];
+    foldText(query, folded, FUZZY_TEXT_SIZE);
+
+    int length = (int) strlen(folded);
+    if (length == 0 || length > FUZZY_MAX_PATTERN) return false;
+
+    memset(pattern, 0, sizeof(FuzzyPattern));
+    for (int i = 0; i < length; i++) {
+        pattern->peq[(unsigned char) folded[i]] |= (uint64_t) 1 << i;
+        pattern->characterBits[i] = (uint8_t) getCharacterBit((unsigned char) folded[i]);
+        if (i > 0) pattern->bigramBits[i - 1] = (uint8_t) getBigramBit((unsigned char) folded[i - 1], (unsigned char) folded[i]);
+    }
+    pattern->lastBit = (uint64_t) 1 << (length - 1);
+    pattern->length = length;
+
+    return true;
+}
+
+/**
+ * Calcula a distância de edição (Levenshtein) entre a consulta e um texto já normalizado, com o algoritmo
+ * bit-paralelo de Myers na formulação de Hyyrö: cada coluna da matriz de programação dinâmica é representada pelas
+ * suas diferenças verticais em duas palavras de 64 bits, de modo que cada caractere do texto custa algumas operações
+ * sobre inteiros, independentemente do tamanho da consulta.
+ * 
+ * @param const FuzzyPattern *pattern
+ * @param const char *text: Texto normalizado
+ * @param bool isSubstring: Se true, retorna a menor distância entre a consulta e um trecho qualquer do texto; se
+ * false, a distância até o texto inteiro
+ * 
+ * @return int
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ * 
+ * References:
+ *  - https://doi.org/10.1145/316542.316550
+ */
+int getEditDistance(const FuzzyPattern *pattern, const char *text, bool isSubstring) {
+    uint64_t positive = ~(uint64_t) 0, negative = 0, firstRow = isSubstring ? 0 : 1;
+    int score = pattern->length, best = score;
+
+    for (const unsigned char *c = (const unsigned char*) text; *c != '\0'; c++) {
+        uint64_t equal = pattern->peq[*c], vertical = equal | negative;
+        uint64_t horizontal = (((equal & positive) + positive) ^ positive) | equal;
+        uint64_t horizontalPositive = negative | ~(horizontal | positive), horizontalNegative = positive & horizontal;
+
+        score += (int) ((horizontalPositive & pattern->lastBit) != 0) - (int) ((horizontalNegative & pattern->lastBit) != 0);
+        best = score < best ? score : best;
+
+        // Na busca por trecho, a primeira linha da matriz é zero: o trecho pode começar em qualquer posição do texto
+        horizontalPositive = (horizontalPositive << 1) | firstRow;
+        horizontalNegative <<= 1;
+        positive = horizontalNegative | ~(vertical | horizontalPositive);
+        negative = horizontalPositive & vertical;
+    }
+
+    return isSubstring ? best : score;
+}
+
+/**
+ * Compara dois registros encontrados: vem primeiro o que tem um trecho mais próximo da consulta, depois o que tem o
+ * texto inteiro mais próximo e, por fim, o de menor ID
+ * 
+ * @param const FuzzyMatch *first
+ * @param const FuzzyMatch *second
+ * 
+ * @return int
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static int compareFuzzyMatches(const FuzzyMatch *first, const FuzzyMatch *second) {
+    if (first->distance != second->distance) return first->distance - second->distance;
+    if (first->editDistance != second->editDistance) return first->editDistance - second->editDistance;
+    return (first->id > second->id) - (first->id < second->id);
+}
+
+/**
+ * Insere um registro na lista ordenada dos melhores registros, descartando o pior quando a lista está cheia
+ * 
+ * @param FuzzyMatch *matches
+ * @param int *matchesNumber
+ * @param int maxMatches
+ * @param const FuzzyMatch *match
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static void insertFuzzyMatch(FuzzyMatch *matches, int *matchesNumber, int maxMatches, const FuzzyMatch *match) {
+    int position = *matchesNumber;
+    if (position == maxMatches && compareFuzzyMatches(match, &matches[position - 1]) >= 0) return;
+    if (position == maxMatches) position--;
+    else (*matchesNumber)++;
+
+    for (; position > 0 && compareFuzzyMatches(match, &matches[position - 1]) < 0; position--) {
+        matches[position] = matches[position - 1];
+    }
+    matches[position] = *match;
+}
+
+/**
+ * Avalia um texto da coluna cuja menor distância até a consulta já foi calculada, guardando-o se estiver entre os
+ * melhores da parte
+ * 
+ * @param FuzzyTask *task
+ * @param int index: Posição do texto na coluna
+ * @param int distance: Menor distância entre a consulta e um trecho do texto
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static void checkFuzzyMatch(FuzzyTask *task, int index, int distance) {
+    const FuzzyColumn *column = task->column;
+    if (distance > task->maxDistance) return;
+
+    // Com a lista cheia, a segunda distância só é calculada quando a primeira empata com a do pior registro e a
+    // diferença de tamanho entre o texto e a consulta (um limite inferior para ela) não o descarta
+    if (task->matchesNumber == task->maxMatches) {
+        const FuzzyMatch *worst = &task->matches[task->matchesNumber - 1];
+        int lengthDifference = abs(column->offsets[index + 1] - column->offsets[index] - 1 - task->pattern->length);
+        if (distance > worst->distance || (distance == worst->distance && lengthDifference > worst->editDistance)) return;
+    }
+
+    FuzzyMatch match = {column->ids[index], distance, getEditDistance(task->pattern, column->texts + column->offsets[index], false)};
+    insertFuzzyMatch(task->matches, &task->matchesNumber, task->maxMatches, &match);
+}
+
+/**
+ * Retorna um limite inferior, calculado em poucas operações, para a menor distância entre a consulta e um trecho de
+ * um texto da coluna. Cada posição da consulta cujo caractere não aparece no texto custa uma edição; cada edição
+ * desfaz no máximo dois dos pares de caracteres vizinhos da consulta; e um texto menor que a consulta precisa de uma
+ * inserção por caractere que falta. Como as assinaturas juntam caracteres e pares diferentes no mesmo bit, o limite
+ * pode ser menor que o real, mas nunca maior.
+ * 
+ * @param const FuzzyPattern *pattern
+ * @param const FuzzyColumn *column
+ * @param int index: Posição do texto na coluna
+ * 
+ * @return int
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static int getDistanceLowerBound(const FuzzyPattern *pattern, const FuzzyColumn *column, int index) {
+    uint64_t characters = ~column->characters[index], bigrams = ~column->bigrams[index];
+    int missingCharacters = 0, missingBigrams = 0;
+
+    for (int i = 0; i < pattern->length; i++) missingCharacters += (int) ((characters >> pattern->characterBits[i]) & 1);
+    for (int i = 0; i < pattern->length - 1; i++) missingBigrams += (int) ((bigrams >> pattern->bigramBits[i]) & 1);
+
+    int bound = pattern->length - (column->offsets[index + 1] - column->offsets[index] - 1);
+    if ((missingBigrams + 1) / 2 > bound) bound = (missingBigrams + 1) / 2;
+    return missingCharacters > bound ? missingCharacters : bound;
+}
+
+/**
+ * Percorre uma parte da coluna, guardando os registros mais próximos da consulta. Recebe e retorna um FuzzyTask*,
+ * para que possa ser executada por uma thread.
+ * 
+ * @param void *argument: FuzzyTask*
+ * 
+ * @return void*
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static void* scanFuzzyTask(void *argument) {
+    FuzzyTask *task = (FuzzyTask*) argument;
+    const FuzzyColumn *column = task->column;
+
+    for (int i = task->from; i < task->to; i++) {
+        // Só são calculadas as distâncias dos textos que ainda podem entrar na lista: com ela cheia, o limite é a
+        // distância do pior registro guardado, que costuma cair para 0 ou 1 logo no início da coluna
+        int limit = task->matchesNumber == task->maxMatches ? task->matches[task->matchesNumber - 1].distance : task->maxDistance;
+        if (getDistanceLowerBound(task->pattern, column, i) > limit) continue;
+        checkFuzzyMatch(task, i, getEditDistance(task->pattern, column->texts + column->offsets[i], true));
+    }
+
+    return task;
+}
+
+/**
+ * Libera os textos de uma coluna
+ * 
+ * @param FuzzyColumn *column
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static void releaseFuzzyColumn(FuzzyColumn *column) {
+    free(column->ids);
+    free(column->offsets);
+    free(column->characters);
+    free(column->bigrams);
+    free(column->texts);
+    memset(column, 0, sizeof(FuzzyColumn));
+}
+
+/**
+ * Retorna a coluna com os textos normalizados de uma tabela, lendo a tabela mapeada em memória apenas quando ela
+ * mudou desde a última leitura. Normalizar os textos uma única vez e guardá-los em sequência faz com que cada busca
+ * percorra poucos megabytes contíguos em vez de todos os registros da tabela. Quando não há espaço para outra
+ * coluna, a mais antiga é descartada.
+ * 
+ * @param const char *table: Caminho completo da tabela, aberta com openFile
+ * @param const size_t structSize: Tamanho da struct da tabela
+ * @param const size_t idOffset: Posição do campo id dentro da struct
+ * @param const size_t deletedOffset: Posição do campo isDeleted dentro da struct
+ * @param const size_t textOffset: Posição do texto dentro da struct
+ * 
+ * @return const FuzzyColumn*|NULL: Coluna | NULL, se a tabela não puder ser lida ou não houver memória disponível
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static const FuzzyColumn* loadFuzzyColumn(const char *table, const size_t structSize, const size_t idOffset, const size_t deletedOffset, const size_t textOffset) {
+    unsigned long version = getFileVersion(table, structSize);
+    if (version == 0 || strlen(table) >= sizeof(columns[0].table)) return NULL;
+
+    FuzzyColumn *column = &columns[0];
+    for (int i = 0; i < FUZZY_MAX_COLUMNS; i++) {
+        if (strcmp(columns[i].table, table) == 0 && columns[i].textOffset == textOffset) {
+            if (columns[i].version == version) return &columns[i];
+            column = &columns[i];
+            break;
+        }
+        if (columns[i].version < column->version) column = &columns[i];
+    }
+
+    int elementsNumber;
+    const char *elements = (const char*) getMappedElements(table, structSize, &elementsNumber);
+    if (elements == NULL && elementsNumber > 0) return NULL;
+
+    FuzzyColumn loaded = {"", textOffset, version, 0, NULL, NULL, NULL, NULL, NULL};
+    size_t textsCapacity = (size_t) elementsNumber * 32 + FUZZY_TEXT_SIZE, textsLength = 0;
+    loaded.ids = (int*) malloc(((size_t) elementsNumber + 1) * sizeof(int));
+    loaded.offsets = (int*) malloc(((size_t) elementsNumber + 1) * sizeof(int));
+    loaded.characters = (uint64_t*) malloc(((size_t) elementsNumber + 1) * sizeof(uint64_t));
+    loaded.bigrams = (uint64_t*) malloc(((size_t) elementsNumber + 1) * sizeof(uint64_t));
+    loaded.texts = (char*) malloc(textsCapacity);
+    strcpy(loaded.table, table);
+
+    bool isAllocated = loaded.ids != NULL && loaded.offsets != NULL && loaded.characters != NULL && loaded.bigrams != NULL;
+    for (int i = 0; i < elementsNumber && loaded.texts != NULL && isAllocated; i++) {
+        const char *element = elements + (size_t) i * structSize;
+        if (*((const bool*) (element + deletedOffset))) continue;
+
+        if (textsLength + FUZZY_TEXT_SIZE > textsCapacity) {
+            textsCapacity *= 2;
+            char *texts = (char*) realloc(loaded.texts, textsCapacity);
+            if (texts == NULL) {
+                free(loaded.texts);
+                loaded.texts = NULL;
+                break;
+            }
+            loaded.texts = texts;
+        }
+
+        const unsigned char *text = (const unsigned char*) loaded.texts + textsLength;
+        uint64_t characters = 0, bigrams = 0;
+        foldText(element + textOffset, loaded.texts + textsLength, FUZZY_TEXT_SIZE);
+        for (int j = 0; text[j] != '\0'; j++) {
+            characters |= (uint64_t) 1 << getCharacterBit(text[j]);
+            if (j > 0) bigrams |= (uint64_t) 1 << getBigramBit(text[j - 1], text[j]);
+        }
+
+        memcpy(&loaded.ids[loaded.textsNumber], element + idOffset, sizeof(int));
+        loaded.characters[loaded.textsNumber] = characters;
+        loaded.bigrams[loaded.textsNumber] = bigrams;
+        loaded.offsets[loaded.textsNumber++] = (int) textsLength;
+        textsLength += strlen(loaded.texts + textsLength) + 1;
+    }
+
+    if (loaded.texts == NULL || !isAllocated) {
+        releaseFuzzyColumn(&loaded);
+        return NULL;
+    }
+    loaded.offsets[loaded.textsNumber] = (int) textsLength;
+
+    releaseFuzzyColumn(column);
+    *column = loaded;
+    return column;
+}
+
+/**
+ * Retorna o número de threads usado por padrão nas buscas aproximadas: o número de processadores disponíveis, até
+ * FUZZY_MAX_THREADS
+ * 
+ * @return int
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+int getFuzzyThreadsNumber(void) {
+    long processors = 1;
+    #ifdef __unix__
+        processors = sysconf(_SC_NPROCESSORS_ONLN);
+    #endif
+    if (processors < 1) return 1;
+    return processors < FUZZY_MAX_THREADS ? (int) processors : FUZZY_MAX_THREADS;
+}
+
+/**
+ * Procura os registros cujo texto mais se aproxima da consulta, ignorando acentos, maiúsculas e pontuação. Cada texto
+ * é comparado com a consulta pela distância de edição até o seu trecho mais parecido, de modo que "sousa" encontra
+ * "Maria Souza" com distância 1; os empates são desfeitos pela distância até o texto inteiro. São aceitos até
+ * length / FUZZY_ERROR_RATIO erros (no mínimo 1), em que length é o tamanho da consulta normalizada.
+ * 
+ * Os textos normalizados ficam em memória enquanto a tabela não muda (veja loadFuzzyColumn). Com mais de uma thread,
+ * eles são divididos em partes iguais, cada uma percorrida por uma thread com a sua própria lista de melhores
+ * registros, que são unidas ao final.
+ * 
+ * @param const char *table: Caminho completo da tabela, aberta com openFile
+ * @param const size_t structSize: Tamanho da struct da tabela
+ * @param const size_t idOffset: Posição do campo id dentro da struct
+ * @param const size_t deletedOffset: Posição do campo isDeleted dentro da struct
+ * @param const size_t textOffset: Posição do texto comparado dentro da struct
+ * @param const char *query
+ * @param FuzzyMatch *matches: Destino dos registros encontrados, do mais ao menos próximo
+ * @param int maxMatches: Número máximo de registros, até FUZZY_MAX_MATCHES
+ * @param int threadsNumber: Número de threads, até FUZZY_MAX_THREADS, ou 0 para usar getFuzzyThreadsNumber
+ * 
+ * @return int: Número de registros encontrados | -1, se a consulta normalizada for vazia ou tiver mais de
+ * FUZZY_MAX_PATTERN caracteres, ou se a tabela não puder ser lida
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+int searchFuzzy(const char *table, const size_t structSize, const size_t idOffset, const size_t deletedOffset, const size_t textOffset, const char *query, FuzzyMatch *matches, int maxMatches, int threadsNumber) {
+    FuzzyPattern pattern;
+    if (!compileFuzzyPattern(query, &pattern)) return -1;
+
+    const FuzzyColumn *column = loadFuzzyColumn(table, structSize, idOffset, deletedOffset, textOffset);
+    if (column == NULL) return -1;
+
+    if (maxMatches <= 0) return 0;
+    if (maxMatches > FUZZY_MAX_MATCHES) maxMatches = FUZZY_MAX_MATCHES;
+    if (threadsNumber <= 0) threadsNumber = getFuzzyThreadsNumber();
+    if (threadsNumber > FUZZY_MAX_THREADS) threadsNumber = FUZZY_MAX_THREADS;
+    if (threadsNumber > column->textsNumber) threadsNumber = column->textsNumber > 0 ? column->textsNumber : 1;
+
+    FuzzyTask *tasks = (FuzzyTask*) malloc(threadsNumber * sizeof(FuzzyTask));
+    if (tasks == NULL) return -1;
+
+    int maxDistance = pattern.length / FUZZY_ERROR_RATIO > 0 ? pattern.length / FUZZY_ERROR_RATIO : 1;
+    for (int i = 0; i < threadsNumber; i++) {
+        tasks[i] = (FuzzyTask) {
+            &pattern, column, (int) ((long) column->textsNumber * i / threadsNumber),
+            (int) ((long) column->textsNumber * (i + 1) / threadsNumber), maxDistance, maxMatches, 0, {{0, 0, 0}}
+        };
+    }
+
+    // A primeira parte é percorrida pela própria thread da chamada; se uma thread não puder ser criada, também
+    pthread_t threads[FUZZY_MAX_THREADS];
+    bool isStarted[FUZZY_MAX_THREADS] = {false};
+    for (int i = 1; i < threadsNumber; i++) isStarted[i] = pthread_create(&threads[i], NULL, scanFuzzyTask, &tasks[i]) == 0;
+    for (int i = 0; i < threadsNumber; i++) {
+        if (i == 0 || !isStarted[i]) scanFuzzyTask(&tasks[i]);
+        else pthread_join(threads[i], NULL);
+    }
+
+    int matchesNumber = 0;
+    for (int i = 0; i < threadsNumber; i++) {
+        for (int j = 0; j < tasks[i].matchesNumber; j++) insertFuzzyMatch(matches, &matchesNumber, maxMatches, &tasks[i].matches[j]);
+    }
+    free(tasks);
+
+    return matchesNumber;
+}
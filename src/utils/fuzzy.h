@@ -0,0 +1,45 @@
+#ifndef FUZZY
+#define FUZZY
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define FUZZY_MAX_PATTERN 64
+#define FUZZY_MAX_MATCHES 32
+#define FUZZY_MAX_THREADS 16
+#define FUZZY_MAX_COLUMNS 4
+#define FUZZY_ERROR_RATIO 3
+#define FUZZY_TEXT_SIZE 128
+
+/**
+ * Consulta pré-processada para o algoritmo de Myers: para cada caractere, os bits das posições em que ele aparece. Guarda
+ * também, para o filtro que descarta textos antes do algoritmo, o bit de cada caractere e de cada par de caracteres
+ * vizinhos da consulta nas assinaturas dos textos.
+ */
+typedef struct FuzzyPattern {
+    uint64_t peq[256];
+    uint64_t lastBit;
+    int length;
+    uint8_t characterBits[FUZZY_MAX_PATTERN];
+    uint8_t bigramBits[FUZZY_MAX_PATTERN];
+} FuzzyPattern;
+
+/**
+ * Registro encontrado em uma busca aproximada
+ */
+typedef struct FuzzyMatch {
+    int id;
+    int distance;
+    int editDistance;
+} FuzzyMatch;
+
+bool compileFuzzyPattern(const char*, FuzzyPattern*);
+
+int getEditDistance(const FuzzyPattern*, const char*, bool);
+
+int getFuzzyThreadsNumber(void);
+
+int searchFuzzy(const char*, const size_t, const size_t, const size_t, const size_t, const char*, FuzzyMatch*, int, int);
+
+#endif
@@ -0,0 +1,326 @@
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdlib.h>
+#include "./storage.h"
+#include "./hashindex.h"
+
+/**
+ * Calcula o hash (FNV-1a) de uma chave
+ * 
+ * @param const char *key
+ * 
+ * @return unsigned int
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ * 
+ * References:
+ *  - http://www.isthe.com/chongo/tech/comp/fnv/index.html
+ */
+static unsigned int hashKey(const char *key) {
+    unsigned int hash = 2166136261u;
+    for (int i = 0; i < HASH_KEY_SIZE && key[i] != '\0'; i++) hash = (hash ^ (unsigned char) key[i]) * 16777619u;
+    return hash;
+}
+
+/**
+ * Retorna o número de posições de um índice, sem contar a posição dos contadores
+ * 
+ * @param const char *filename: Caminho completo do índice
+ * 
+ * @return int
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static int getCapacity(const char *filename) {
+    int bucketsNumber = getNumberOfElements(filename, sizeof(HashBucket));
+    return bucketsNumber > 1 ? bucketsNumber - 1 : 0;
+}
+
+/**
+ * Coloca uma chave em um índice carregado em memória, usando sondagem linear
+ * 
+ * @param HashBucket *buckets: Posições do índice, começando pela posição dos contadores
+ * @param int capacity: Número de posições, sem contar a posição dos contadores
+ * @param const HashBucket *bucket: Chave a ser colocada
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static void placeBucket(HashBucket *buckets, int capacity, const HashBucket *bucket) {
+    int index = (int) (bucket->hash % (unsigned int) capacity);
+    while (buckets[1 + index].id != 0) index = (index + 1) % capacity;
+
+    buckets[1 + index] = *bucket;
+    buckets[0].id++;
+    buckets[0].hash++;
+}
+
+/**
+ * Reescreve um índice com uma nova capacidade, mantendo apenas as chaves ativas
+ * 
+ * @param const char *filename: Caminho completo do índice
+ * @param int capacity: Nova capacidade
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static bool resizeHashIndex(const char *filename, int capacity) {
+    HashBucket *buckets = (HashBucket*) calloc(capacity + 1, sizeof(HashBucket));
+    if (buckets == NULL) return false;
+
+    Cursor cursor;
+    const HashBucket *bucket;
+    bool status = openCursor(&cursor, filename, sizeof(HashBucket), false);
+    while (status && (bucket = nextElement(&cursor)) != NULL) {
+        if (cursor.index > 0 && bucket->id > 0) placeBucket(buckets, capacity, bucket);
+    }
+    closeCursor(&cursor);
+
+    status = status && saveFile(buckets, sizeof(HashBucket), capacity + 1, filename);
+    free(buckets);
+
+    return status;
+}
+
+/**
+ * Recria um índice a partir dos registros ativos de uma tabela
+ * 
+ * @param const char *filename: Caminho completo do índice
+ * @param const char *table: Caminho completo da tabela
+ * @param const size_t structSize: Tamanho da struct da tabela
+ * @param const size_t idOffset: Posição do campo id dentro da struct
+ * @param const size_t keyOffset: Posição da chave dentro da struct
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static bool rebuildHashIndex(const char *filename, const char *table, const size_t structSize, const size_t idOffset, const size_t keyOffset) {
+    FileHeader header;
+    if (!getFileHeader(table, structSize, &header)) return false;
+
+    int capacity = HASH_INDEX_INITIAL_CAPACITY;
+    while ((long) capacity * HASH_INDEX_MAX_LOAD < (long) header.liveCount * 200) capacity *= 2;
+
+    HashBucket *buckets = (HashBucket*) calloc(capacity + 1, sizeof(HashBucket));
+    if (buckets == NULL) return false;
+
+    Cursor cursor;
+    const char *element;
+    bool status = openCursor(&cursor, table, structSize, true);
+    while (status && (element = nextElement(&cursor)) != NULL) {
+        // Chaves repetidas de dados antigos são mantidas, para que nenhum registro fique fora do índice
+        HashBucket bucket;
+        memset(&bucket, 0, sizeof(HashBucket));
+        memcpy(&bucket.id, element + idOffset, sizeof(int));
+        strncpy(bucket.key, element + keyOffset, HASH_KEY_SIZE - 1);
+        bucket.hash = hashKey(bucket.key);
+        placeBucket(buckets, capacity, &bucket);
+    }
+    closeCursor(&cursor);
+
+    status = status && saveFile(buckets, sizeof(HashBucket), capacity + 1, filename);
+    free(buckets);
+
+    return status;
+}
+
+/**
+ * Abre o índice hash de uma tabela. Se o índice não existir ou não tiver o mesmo número de chaves que a tabela tem de
+ * registros ativos, ele é recriado a partir da tabela.
+ * 
+ * @param const char *filename: Caminho completo do índice
+ * @param const char *table: Caminho completo da tabela, já aberta com openFile
+ * @param const size_t structSize: Tamanho da struct da tabela
+ * @param const size_t idOffset: Posição do campo id dentro da struct
+ * @param const size_t keyOffset: Posição da chave (texto terminado em '\0') dentro da struct
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool openHashIndex(const char *filename, const char *table, const size_t structSize, const size_t idOffset, const size_t keyOffset) {
+    FileHeader header;
+    HashBucket counters;
+    if (!getFileHeader(table, structSize, &header)) return false;
+
+    if (getCapacity(filename) > 0 && readElementFromFile(&counters, sizeof(HashBucket), 0, filename) && (int) counters.hash == header.liveCount) {
+        return true;
+    }
+
+    return rebuildHashIndex(filename, table, structSize, idOffset, keyOffset);
+}
+
+/**
+ * Procura uma chave no índice, lendo apenas as posições da sua sequência de sondagem
+ * 
+ * @param const char *filename: Caminho completo do índice
+ * @param const char *key
+ * 
+ * @return int: ID do registro com a chave | 0, caso a chave não esteja no índice
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+int findInHashIndex(const char *filename, const char *key) {
+    int capacity = getCapacity(filename);
+    if (capacity == 0) return 0;
+
+    HashBucket bucket;
+    unsigned int hash = hashKey(key);
+    int index = (int) (hash % (unsigned int) capacity);
+
+    for (int i = 0; i < capacity; i++, index = (index + 1) % capacity) {
+        if (!readElementFromFile(&bucket, sizeof(HashBucket), 1 + index, filename) || bucket.id == 0) return 0;
+        if (bucket.id > 0 && bucket.hash == hash && strncmp(bucket.key, key, HASH_KEY_SIZE) == 0) return bucket.id;
+    }
+
+    return 0;
+}
+
+/**
+ * Garante espaço no índice para novas chaves, dobrando a sua capacidade quando a ocupação passaria do limite. Como
+ * reescreve o índice por completo, deve ser chamada antes de iniciar a transação que insere as chaves.
+ * 
+ * @param const char *filename: Caminho completo do índice
+ * @param int keysNumber: Número de chaves que serão inseridas
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool reserveHashIndex(const char *filename, int keysNumber) {
+    int capacity = getCapacity(filename);
+    HashBucket counters;
+    memset(&counters, 0, sizeof(HashBucket));
+    if (capacity > 0 && !readElementFromFile(&counters, sizeof(HashBucket), 0, filename)) return false;
+
+    if (capacity > 0 && (long) (counters.id + keysNumber) * 100 <= (long) capacity * HASH_INDEX_MAX_LOAD) return true;
+
+    // A nova capacidade deixa o índice com metade da ocupação máxima, descartando as posições removidas
+    int newCapacity = capacity > 0 ? capacity : HASH_INDEX_INITIAL_CAPACITY;
+    while ((long) newCapacity * HASH_INDEX_MAX_LOAD < ((long) counters.hash + keysNumber) * 200) newCapacity *= 2;
+
+    return resizeHashIndex(filename, newCapacity);
+}
+
+/**
+ * Insere uma chave no índice. A posição de uma chave removida na sequência de sondagem é reaproveitada.
+ * 
+ * @param const char *filename: Caminho completo do índice
+ * @param const char *key
+ * @param int id: ID do registro com a chave
+ * 
+ * @return bool: Retorna false se a chave já estiver no índice, se não houver espaço reservado ou se houver falha
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool insertIntoHashIndex(const char *filename, const char *key, int id) {
+    int capacity = getCapacity(filename);
+    HashBucket counters, bucket;
+    if (capacity == 0 || !readElementFromFile(&counters, sizeof(HashBucket), 0, filename)) return false;
+    if ((long) (counters.id + 1) * 100 > (long) capacity * HASH_INDEX_MAX_LOAD) return false;
+
+    unsigned int hash = hashKey(key);
+    int index = (int) (hash % (unsigned int) capacity), target = -1;
+
+    for (int i = 0; i < capacity; i++, index = (index + 1) % capacity) {
+        if (!readElementFromFile(&bucket, sizeof(HashBucket), 1 + index, filename)) return false;
+        if (bucket.id == 0) break;
+        if (bucket.id < 0 && target < 0) target = index;
+        if (bucket.id > 0 && bucket.hash == hash && strncmp(bucket.key, key, HASH_KEY_SIZE) == 0) return false;
+    }
+    if (target < 0) {
+        target = index;
+        counters.id++;
+    }
+    counters.hash++;
+
+    memset(&bucket, 0, sizeof(HashBucket));
+    bucket.id = id;
+    bucket.hash = hash;
+    strncpy(bucket.key, key, HASH_KEY_SIZE - 1);
+
+    beginTransaction();
+    if (!updateElementInFile(&bucket, sizeof(HashBucket), 1 + target, filename) || !updateElementInFile(&counters, sizeof(HashBucket), 0, filename)) {
+        rollbackTransaction();
+        return false;
+    }
+
+    return commitTransaction();
+}
+
+/**
+ * Remove do índice a chave de um registro, marcando a sua posição como removida para não interromper a sequência de
+ * sondagem das demais chaves
+ * 
+ * @param const char *filename: Caminho completo do índice
+ * @param const char *key
+ * @param int id: ID do registro com a chave
+ * 
+ * @return bool: Retorna false apenas se houver falha na leitura ou na escrita do índice
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool removeFromHashIndex(const char *filename, const char *key, int id) {
+    int capacity = getCapacity(filename);
+    HashBucket counters, bucket;
+    if (capacity == 0) return true;
+    if (!readElementFromFile(&counters, sizeof(HashBucket), 0, filename)) return false;
+
+    unsigned int hash = hashKey(key);
+    int index = (int) (hash % (unsigned int) capacity);
+    bool isFound = false;
+
+    for (int i = 0; i < capacity && !isFound; i++) {
+        if (!readElementFromFile(&bucket, sizeof(HashBucket), 1 + index, filename)) return false;
+        if (bucket.id == 0) return true;
+        isFound = bucket.id == id && strncmp(bucket.key, key, HASH_KEY_SIZE) == 0;
+        if (!isFound) index = (index + 1) % capacity;
+    }
+    if (!isFound) return true;
+
+    bucket.id = -1;
+    counters.hash--;
+
+    beginTransaction();
+    if (!updateElementInFile(&bucket, sizeof(HashBucket), 1 + index, filename) || !updateElementInFile(&counters, sizeof(HashBucket), 0, filename)) {
+        rollbackTransaction();
+        return false;
+    }
+
+    return commitTransaction();
+}
+
+/**
+ * Substitui a chave de um registro no índice, caso ela tenha mudado ou o registro tenha sido excluído
+ * 
+ * @param const char *filename: Caminho completo do índice
+ * @param const char *currentKey: Chave atual
+ * @param const char *newKey: Nova chave
+ * @param int id: ID do registro
+ * @param bool isDeleted: Indica se o registro foi excluído, caso em que a chave é apenas removida
+ * 
+ * @return bool: Retorna false se a nova chave já pertencer a outro registro ou se houver falha no índice
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool replaceInHashIndex(const char *filename, const char *currentKey, const char *newKey, int id, bool isDeleted) {
+    if (!isDeleted && strcmp(currentKey, newKey) == 0) return true;
+    if (!removeFromHashIndex(filename, currentKey, id)) return false;
+
+    return isDeleted || insertIntoHashIndex(filename, newKey, id);
+}
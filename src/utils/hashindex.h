@@ -0,0 +1,34 @@
+#ifndef HASH_INDEX
+#define HASH_INDEX
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#define HASH_KEY_SIZE 16
+#define HASH_INDEX_INITIAL_CAPACITY 64
+#define HASH_INDEX_MAX_LOAD 70
+
+/**
+ * Posição (bucket) de um índice hash gravado em disco. O id vale 0 em posições vazias e -1 em posições removidas.
+ * A primeira posição do arquivo guarda os contadores do índice: em id, as posições ocupadas (incluindo as removidas),
+ * e em hash, as chaves ativas.
+ */
+typedef struct HashBucket {
+    int id;
+    unsigned int hash;
+    char key[HASH_KEY_SIZE];
+} HashBucket;
+
+bool openHashIndex(const char*, const char*, const size_t, const size_t, const size_t);
+
+int findInHashIndex(const char*, const char*);
+
+bool reserveHashIndex(const char*, int);
+
+bool insertIntoHashIndex(const char*, const char*, int);
+
+bool removeFromHashIndex(const char*, const char*, int);
+
+bool replaceInHashIndex(const char*, const char*, const char*, int, bool);
+
+#endif
@@ -9,6 +9,7 @@
 #include "./../modules/client/client.h"
 #include "./str.h"
 #include "./validation.h"
+#include "./storage.h"
 
 #ifdef __unix__
 
@@ -243,6 +244,9 @@ void showOptions(char title[], char options[][30], char optionsStyles[][11], int
     int paddingLeft = (width - titleLen) / 2;
     int paddingRight = width - titleLen - paddingLeft;
 
+    // Enquanto o usuário escolhe uma opção, as operações do commit em grupo pendente não ficam esperando a próxima escrita
+    syncPendingCommits();
+
     printf("------------------------------\n");
     printf("|%*s%s%*s|\n", paddingLeft, "", title, paddingRight, "");
     printf("------------------------------\n");
@@ -299,17 +303,30 @@ void showMainMenu() {
         struct termios originalTerminal;
         tcgetattr(STDIN_FILENO, &originalTerminal);
     #endif
-    int option = 0, size = 7;
-    char options[7][30] = {
+    int option = 0, size = 8;
+    char options[8][30] = {
         "1. Modulo Clientes", "2. Modulo Advogados", "3. Modulo Escritórios",
-        "4. Modulo Agendamentos", "5. Modulo Sobre", "6. Modulo Equipe", "7. Encerrar Programa"
+        "4. Modulo Agendamentos", "5. Modulo Sobre", "6. Modulo Equipe", "7. Compactar Dados",
+        "8. Encerrar Programa"
     };
     char optionsStyles[size][11];
     bool isSelected = false, loop = true;
     void (*actions[])() = {
-        showClientMenu, showLawyerMenu, showOfficeMenu, showAppointmentMenu, showAboutMenu, showTeamMenu
+        showClientMenu, showLawyerMenu, showOfficeMenu, showAppointmentMenu, showAboutMenu, showTeamMenu, showCompactMenu
     };
     setOptionsStyle(optionsStyles, size);
+    if (!configureDurability(getenv("SIGLAW_DURABILITY"))) {
+        showGenericInfo(RED_STYLE "Modo de durabilidade inválido em SIGLAW_DURABILITY, usando o modo padrão" RESET_STYLE "\nPressione <Enter> para prosseguir...\n");
+    }
+    if (!configureRoomCapacity(getenv("SIGLAW_ROOM_CAPACITY"))) {
+        showGenericInfo(RED_STYLE "Número de salas inválido em SIGLAW_ROOM_CAPACITY, usando o valor padrão" RESET_STYLE "\nPressione <Enter> para prosseguir...\n");
+    }
+    if (!openClientTable() || !openLawyerTable() || !openOfficeTable() || !openAppointmentTable()) {
+        printf("%sOs arquivos de dados possuem um formato incompatível com esta versão do sistema%s\n", RED_STYLE, RESET_STYLE);
+        closeAppointmentTable();
+        closeFiles();
+        return;
+    }
     while (loop) {
         #ifdef __unix__
             system("clear");
@@ -334,6 +351,8 @@ void showMainMenu() {
             }
         }
     }
+    closeAppointmentTable();
+    closeFiles();
 }
 
 /**
@@ -360,6 +379,28 @@ void showTeamMenu() {
     showGenericInfo("--------------------------------------------------------------------------------------------------\n|                                             Equipe                                             |\n--------------------------------------------------------------------------------------------------\n| O projeto foi feitos pelos alunos do curso de Bachalerado em Sistemas de Informação na UFRN:   |  \n|                                                                                                |\n| - Mosiah Adam Maria de Araújo: https://github.com/akemi-adam                                   |\n| - Felipe Erik: https://github.com/zfelip                                                       |\n--------------------------------------------------------------------------------------------------\n");   
 }
 
+/**
+ * Compacta os arquivos de dados, removendo os registros excluídos, e exibe quantos registros foram removidos de cada
+ * arquivo. Os códigos dos registros não mudam.
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+void showCompactMenu() {
+    char message[512];
+    int clients = compactClientTable(), lawyers = compactLawyerTable(), offices = compactOfficeTable(), appointments = compactAppointmentTable();
+
+    if (clients < 0 || lawyers < 0 || offices < 0 || appointments < 0) {
+        showGenericInfo(RED_STYLE "Houve um erro ao compactar os arquivos de dados" RESET_STYLE "\nPressione <Enter> para prosseguir...\n");
+        return;
+    }
+
+    snprintf(message, sizeof(message), "---- Compactar Dados ----\nRegistros excluídos removidos:\nClientes: %d\nAdvogados: %d\nEscritórios: %d\nAgendamentos: %d\nPressione <Enter> para prosseguir...\n", clients, lawyers, offices, appointments);
+    showGenericInfo(message);
+}
+
 /**
  * Exibe uma mensagem de erro com base em um código de erro correspondente
  * 
@@ -424,11 +465,11 @@ void readStrField(char *field, char *label, int maxLength, Validation validation
     int i = 0;
     int status; 
     bool isValidated = true;
-    char *defaultValue = (char*) malloc(sizeof(char));
+    char *defaultValue = (char*) calloc(maxLength + 1, sizeof(char));
     do {
         printf("%s: ", label);
 
-        if (strlen(field)) strcpy(defaultValue, field);
+        if (strlen(field)) strncpy(defaultValue, field, maxLength);
         
         readline(field, maxLength);
 
@@ -38,6 +38,8 @@ void showAboutMenu(void);
 
 void showTeamMenu(void);
 
+void showCompactMenu(void);
+
 void showErrorMessage(int);
 
 void readStrField(char*, char*, int, Validation[], int);
@@ -0,0 +1,321 @@
+#include <stdlib.h>
+#include <stdbool.h>
+#include "./intervaltree.h"
+
+/**
+ * Retorna a altura de um nó (0 para um nó vazio)
+ * 
+ * @param const IntervalNode *node
+ * 
+ * @return int
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static int nodeHeight(const IntervalNode *node) {
+    return node != NULL ? node->height : 0;
+}
+
+/**
+ * Recalcula a altura e o maior fim de um nó a partir dos seus filhos
+ * 
+ * @param IntervalNode *node
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static void updateNode(IntervalNode *node) {
+    int leftHeight = nodeHeight(node->left), rightHeight = nodeHeight(node->right);
+    node->height = 1 + (leftHeight > rightHeight ? leftHeight : rightHeight);
+
+    node->maxEnd = node->end;
+    if (node->left != NULL && node->left->maxEnd > node->maxEnd) node->maxEnd = node->left->maxEnd;
+    if (node->right != NULL && node->right->maxEnd > node->maxEnd) node->maxEnd = node->right->maxEnd;
+}
+
+/**
+ * Rotaciona uma subárvore para a direita
+ * 
+ * @param IntervalNode *node
+ * 
+ * @return IntervalNode*: Nova raiz da subárvore
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static IntervalNode* rotateRight(IntervalNode *node) {
+    IntervalNode *left = node->left;
+    node->left = left->right;
+    left->right = node;
+    updateNode(node);
+    updateNode(left);
+    return left;
+}
+
+/**
+ * Rotaciona uma subárvore para a esquerda
+ * 
+ * @param IntervalNode *node
+ * 
+ * @return IntervalNode*: Nova raiz da subárvore
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static IntervalNode* rotateLeft(IntervalNode *node) {
+    IntervalNode *right = node->right;
+    node->right = right->left;
+    right->left = node;
+    updateNode(node);
+    updateNode(right);
+    return right;
+}
+
+/**
+ * Atualiza um nó e, se a diferença de altura entre os filhos passar de 1, rebalanceia a subárvore
+ * 
+ * @param IntervalNode *node
+ * 
+ * @return IntervalNode*: Nova raiz da subárvore
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static IntervalNode* balanceNode(IntervalNode *node) {
+    updateNode(node);
+    int balance = nodeHeight(node->left) - nodeHeight(node->right);
+
+    if (balance > 1) {
+        if (nodeHeight(node->left->left) < nodeHeight(node->left->right)) node->left = rotateLeft(node->left);
+        return rotateRight(node);
+    }
+    if (balance < -1) {
+        if (nodeHeight(node->right->right) < nodeHeight(node->right->left)) node->right = rotateRight(node->right);
+        return rotateLeft(node);
+    }
+
+    return node;
+}
+
+/**
+ * Compara a posição de um intervalo com a de um nó, pelo início e, em caso de empate, pelo ID
+ * 
+ * @param long start
+ * @param int id
+ * @param const IntervalNode *node
+ * 
+ * @return int: Negativo se o intervalo vem antes do nó, positivo se vem depois e 0 se é o próprio nó
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static int compareInterval(long start, int id, const IntervalNode *node) {
+    if (start != node->start) return start < node->start ? -1 : 1;
+    if (id != node->id) return id < node->id ? -1 : 1;
+    return 0;
+}
+
+/**
+ * Insere um nó em uma subárvore
+ * 
+ * @param IntervalNode *node: Raiz da subárvore
+ * @param IntervalNode *newNode
+ * 
+ * @return IntervalNode*: Nova raiz da subárvore
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static IntervalNode* insertNode(IntervalNode *node, IntervalNode *newNode) {
+    if (node == NULL) return newNode;
+
+    if (compareInterval(newNode->start, newNode->id, node) < 0) node->left = insertNode(node->left, newNode);
+    else node->right = insertNode(node->right, newNode);
+
+    return balanceNode(node);
+}
+
+/**
+ * Desliga o nó de menor início de uma subárvore
+ * 
+ * @param IntervalNode *node: Raiz da subárvore
+ * @param IntervalNode **minNode: Destino do nó desligado
+ * 
+ * @return IntervalNode*: Nova raiz da subárvore
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static IntervalNode* detachMinNode(IntervalNode *node, IntervalNode **minNode) {
+    if (node->left == NULL) {
+        *minNode = node;
+        return node->right;
+    }
+
+    node->left = detachMinNode(node->left, minNode);
+    return balanceNode(node);
+}
+
+/**
+ * Remove um nó de uma subárvore
+ * 
+ * @param IntervalNode *node: Raiz da subárvore
+ * @param long start
+ * @param int id
+ * @param bool *isRemoved: Indica se o nó foi encontrado
+ * 
+ * @return IntervalNode*: Nova raiz da subárvore
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static IntervalNode* removeNode(IntervalNode *node, long start, int id, bool *isRemoved) {
+    if (node == NULL) return NULL;
+
+    int comparison = compareInterval(start, id, node);
+    if (comparison < 0) {
+        node->left = removeNode(node->left, start, id, isRemoved);
+    } else if (comparison > 0) {
+        node->right = removeNode(node->right, start, id, isRemoved);
+    } else {
+        IntervalNode *left = node->left, *right = node->right, *successor;
+        free(node);
+        *isRemoved = true;
+
+        if (right == NULL) return left;
+        right = detachMinNode(right, &successor);
+        successor->left = left;
+        successor->right = right;
+        return balanceNode(successor);
+    }
+
+    return balanceNode(node);
+}
+
+/**
+ * Procura, em uma subárvore, um intervalo que se sobreponha a [start, end). As subárvores cujo maior fim não passa de
+ * start, e as subárvores à direita de um nó que começa depois de end, são descartadas sem serem visitadas.
+ * 
+ * @param const IntervalNode *node: Raiz da subárvore
+ * @param long start
+ * @param long end
+ * @param int ignoredId
+ * 
+ * @return int: ID do intervalo encontrado | 0, caso não haja sobreposição
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static int findOverlapInNode(const IntervalNode *node, long start, long end, int ignoredId) {
+    if (node == NULL || node->maxEnd <= start) return 0;
+
+    int id = findOverlapInNode(node->left, start, end, ignoredId);
+    if (id != 0) return id;
+
+    if (node->start >= end) return 0;
+    if (node->end > start && node->id != ignoredId) return node->id;
+
+    return findOverlapInNode(node->right, start, end, ignoredId);
+}
+
+/**
+ * Libera os nós de uma subárvore
+ * 
+ * @param IntervalNode *node
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static void freeNode(IntervalNode *node) {
+    if (node == NULL) return;
+    freeNode(node->left);
+    freeNode(node->right);
+    free(node);
+}
+
+/**
+ * Insere o intervalo [start, end) de um registro na árvore, em O(log n)
+ * 
+ * @param IntervalTree *tree
+ * @param long start
+ * @param long end
+ * @param int id: ID do registro
+ * 
+ * @return bool: Retorna false se não houver memória disponível
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool insertInterval(IntervalTree *tree, long start, long end, int id) {
+    IntervalNode *node = (IntervalNode*) malloc(sizeof(IntervalNode));
+    if (node == NULL) return false;
+
+    node->start = start;
+    node->end = end;
+    node->maxEnd = end;
+    node->id = id;
+    node->height = 1;
+    node->left = NULL;
+    node->right = NULL;
+
+    tree->root = insertNode(tree->root, node);
+    tree->size++;
+    return true;
+}
+
+/**
+ * Remove da árvore o intervalo de um registro, em O(log n)
+ * 
+ * @param IntervalTree *tree
+ * @param long start: Início do intervalo
+ * @param int id: ID do registro
+ * 
+ * @return bool: Retorna false se o intervalo não estiver na árvore
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool removeInterval(IntervalTree *tree, long start, int id) {
+    bool isRemoved = false;
+    tree->root = removeNode(tree->root, start, id, &isRemoved);
+    if (isRemoved) tree->size--;
+    return isRemoved;
+}
+
+/**
+ * Procura um intervalo da árvore que se sobreponha a [start, end). Intervalos que apenas se encostam (um termina
+ * quando o outro começa) não se sobrepõem.
+ * 
+ * @param const IntervalTree *tree
+ * @param long start
+ * @param long end
+ * @param int ignoredId: ID de um registro a ser desconsiderado, como o próprio registro em uma edição (0 para nenhum)
+ * 
+ * @return int: ID do registro com o intervalo sobreposto | 0, caso não haja sobreposição
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+int findOverlap(const IntervalTree *tree, long start, long end, int ignoredId) {
+    return findOverlapInNode(tree->root, start, end, ignoredId);
+}
+
+/**
+ * Libera todos os nós de uma árvore
+ * 
+ * @param IntervalTree *tree
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+void freeIntervalTree(IntervalTree *tree) {
+    freeNode(tree->root);
+    tree->root = NULL;
+    tree->size = 0;
+}
@@ -0,0 +1,33 @@
+#ifndef INTERVAL_TREE
+#define INTERVAL_TREE
+
+#include <stdbool.h>
+
+/**
+ * Nó de uma árvore de intervalos: uma árvore AVL ordenada pelo início (e pelo ID, em caso de empate), em que cada nó
+ * guarda o maior fim entre os intervalos da sua subárvore
+ */
+typedef struct IntervalNode {
+    long start;
+    long end;
+    long maxEnd;
+    int id;
+    int height;
+    struct IntervalNode *left;
+    struct IntervalNode *right;
+} IntervalNode;
+
+typedef struct IntervalTree {
+    IntervalNode *root;
+    int size;
+} IntervalTree;
+
+bool insertInterval(IntervalTree*, long, long, int);
+
+bool removeInterval(IntervalTree*, long, int);
+
+int findOverlap(const IntervalTree*, long, long, int);
+
+void freeIntervalTree(IntervalTree*);
+
+#endif
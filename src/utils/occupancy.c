@@ -0,0 +1,332 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "./occupancy.h"
+#include "./calendar.h"
+
+/**
+ * Monta a máscara das faixas [firstSlot, lastSlot) de um dia
+ * 
+ * @param uint64_t mask[OCCUPANCY_WORDS]: Destino da máscara
+ * @param int firstSlot
+ * @param int lastSlot
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static void buildMask(uint64_t *mask, int firstSlot, int lastSlot) {
+    for (int i = 0; i < OCCUPANCY_WORDS; i++) {
+        int wordStart = i * 64, from = firstSlot - wordStart, to = lastSlot - wordStart;
+        if (from < 0) from = 0;
+        if (to > 64) to = 64;
+
+        if (from >= to) mask[i] = 0;
+        else if (to - from == 64) mask[i] = UINT64_MAX;
+        else mask[i] = ((UINT64_C(1) << (to - from)) - 1) << from;
+    }
+}
+
+/**
+ * Procura um dia na ocupação, por busca binária
+ * 
+ * @param const Occupancy *occupancy
+ * @param long day: Dias desde 01/01/1970
+ * @param bool *isFound
+ * 
+ * @return int: Posição do dia | posição onde ele deveria ser inserido, caso não exista
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static int findDay(const Occupancy *occupancy, long day, bool *isFound) {
+    int low = 0, high = occupancy->daysNumber;
+
+    while (low < high) {
+        int middle = low + (high - low) / 2;
+        if (occupancy->days[middle].day < day) low = middle + 1;
+        else high = middle;
+    }
+
+    *isFound = low < occupancy->daysNumber && occupancy->days[low].day == day;
+    return low;
+}
+
+/**
+ * Retorna a ocupação de um dia, criando-a vazia se ainda não existir
+ * 
+ * @param Occupancy *occupancy
+ * @param long day: Dias desde 01/01/1970
+ * 
+ * @return DayOccupancy*|NULL: Ocupação do dia | NULL, se não houver memória disponível
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static DayOccupancy* getDay(Occupancy *occupancy, long day) {
+    bool isFound;
+    int index = findDay(occupancy, day, &isFound);
+    if (isFound) return &occupancy->days[index];
+
+    if (occupancy->daysNumber == occupancy->daysCapacity) {
+        int daysCapacity = occupancy->daysCapacity > 0 ? occupancy->daysCapacity * 2 : 8;
+        DayOccupancy *days = (DayOccupancy*) realloc(occupancy->days, daysCapacity * sizeof(DayOccupancy));
+        if (days == NULL) return NULL;
+
+        occupancy->days = days;
+        occupancy->daysCapacity = daysCapacity;
+    }
+
+    memmove(&occupancy->days[index + 1], &occupancy->days[index], (occupancy->daysNumber - index) * sizeof(DayOccupancy));
+    memset(&occupancy->days[index], 0, sizeof(DayOccupancy));
+    occupancy->days[index].day = day;
+    occupancy->daysNumber++;
+
+    return &occupancy->days[index];
+}
+
+/**
+ * Converte um trecho de um dia em faixas, arredondando o início para baixo e o fim para cima
+ * 
+ * @param long start: Início, em minutos desde 01/01/1970
+ * @param long end: Fim do intervalo [start, end)
+ * @param long day: Dia do trecho
+ * @param int *firstSlot
+ * @param int *lastSlot
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static void getDaySlots(long start, long end, long day, int *firstSlot, int *lastSlot) {
+    long dayStart = day * MINUTES_PER_DAY, dayEnd = dayStart + MINUTES_PER_DAY;
+    long from = start > dayStart ? start : dayStart, to = end < dayEnd ? end : dayEnd;
+
+    *firstSlot = (int) ((from - dayStart) / OCCUPANCY_SLOT_MINUTES);
+    *lastSlot = (int) ((to - dayStart + OCCUPANCY_SLOT_MINUTES - 1) / OCCUPANCY_SLOT_MINUTES);
+}
+
+/**
+ * Registra uma reserva no intervalo [start, end). Em cada palavra, a reserva é somada às camadas como um incremento
+ * em unário: as faixas que já estavam na camada k passam para a camada k + 1.
+ * 
+ * @param Occupancy *occupancy
+ * @param long start: Início, em minutos desde 01/01/1970
+ * @param long end
+ * 
+ * @return bool: Retorna false se não houver memória disponível
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool occupySlots(Occupancy *occupancy, long start, long end) {
+    for (long day = minutesToDays(start); start < end && day <= minutesToDays(end - 1); day++) {
+        DayOccupancy *dayOccupancy = getDay(occupancy, day);
+        if (dayOccupancy == NULL) return false;
+
+        uint64_t mask[OCCUPANCY_WORDS];
+        int firstSlot, lastSlot;
+        getDaySlots(start, end, day, &firstSlot, &lastSlot);
+        buildMask(mask, firstSlot, lastSlot);
+
+        for (int i = 0; i < OCCUPANCY_WORDS; i++) {
+            uint64_t carry = mask[i];
+            for (int k = 0; k < OCCUPANCY_MAX_CAPACITY && carry != 0; k++) {
+                uint64_t next = dayOccupancy->layers[k][i] & carry;
+                dayOccupancy->layers[k][i] |= carry;
+                carry = next;
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Retira uma reserva do intervalo [start, end), desligando em cada faixa a camada mais alta ocupada
+ * 
+ * @param Occupancy *occupancy
+ * @param long start: Início, em minutos desde 01/01/1970
+ * @param long end
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+void releaseSlots(Occupancy *occupancy, long start, long end) {
+    for (long day = minutesToDays(start); start < end && day <= minutesToDays(end - 1); day++) {
+        bool isFound;
+        int index = findDay(occupancy, day, &isFound);
+        if (!isFound) continue;
+
+        uint64_t mask[OCCUPANCY_WORDS];
+        int firstSlot, lastSlot;
+        getDaySlots(start, end, day, &firstSlot, &lastSlot);
+        buildMask(mask, firstSlot, lastSlot);
+
+        for (int i = 0; i < OCCUPANCY_WORDS; i++) {
+            uint64_t borrow = mask[i];
+            for (int k = OCCUPANCY_MAX_CAPACITY - 1; k >= 0 && borrow != 0; k--) {
+                uint64_t cleared = occupancy->days[index].layers[k][i] & borrow;
+                occupancy->days[index].layers[k][i] &= ~cleared;
+                borrow &= ~cleared;
+            }
+        }
+    }
+}
+
+/**
+ * Retorna quantas vagas continuam livres durante todo o intervalo [start, end), ou seja, a capacidade menos a maior
+ * ocupação de uma faixa do intervalo. A camada mais alta que cruza a máscara do intervalo dá essa ocupação.
+ * 
+ * @param const Occupancy *occupancy
+ * @param long start: Início, em minutos desde 01/01/1970
+ * @param long end
+ * @param int capacity: Número de vagas (até OCCUPANCY_MAX_CAPACITY)
+ * 
+ * @return int
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+int getFreeCapacity(const Occupancy *occupancy, long start, long end, int capacity) {
+    if (capacity > OCCUPANCY_MAX_CAPACITY) capacity = OCCUPANCY_MAX_CAPACITY;
+    int freeCapacity = capacity;
+
+    for (long day = minutesToDays(start); start < end && day <= minutesToDays(end - 1); day++) {
+        bool isFound;
+        int index = findDay(occupancy, day, &isFound);
+        if (!isFound) continue;
+
+        uint64_t mask[OCCUPANCY_WORDS];
+        int firstSlot, lastSlot;
+        getDaySlots(start, end, day, &firstSlot, &lastSlot);
+        buildMask(mask, firstSlot, lastSlot);
+
+        for (int k = capacity - 1; k >= 0 && capacity - (k + 1) < freeCapacity; k--) {
+            uint64_t overlap = 0;
+            for (int i = 0; i < OCCUPANCY_WORDS; i++) overlap |= occupancy->days[index].layers[k][i] & mask[i];
+            if (overlap != 0) {
+                freeCapacity = capacity - (k + 1);
+                break;
+            }
+        }
+    }
+
+    return freeCapacity;
+}
+
+/**
+ * Desloca um mapa de bits de um dia em direção às primeiras faixas, de modo que a faixa i passe a ter o valor da
+ * faixa i + shift
+ * 
+ * @param const uint64_t *bits
+ * @param int shift
+ * @param uint64_t *result
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static void shiftSlots(const uint64_t *bits, int shift, uint64_t *result) {
+    int words = shift / 64, offset = shift % 64;
+
+    for (int i = 0; i < OCCUPANCY_WORDS; i++) {
+        uint64_t low = i + words < OCCUPANCY_WORDS ? bits[i + words] : 0;
+        uint64_t high = i + words + 1 < OCCUPANCY_WORDS ? bits[i + words + 1] : 0;
+        result[i] = offset == 0 ? low : (low >> offset) | (high << (64 - offset));
+    }
+}
+
+/**
+ * Monta o mapa das faixas lotadas de um dia, isto é, das faixas que já têm capacity reservas
+ * 
+ * @param const Occupancy *occupancy
+ * @param long day: Dias desde 01/01/1970
+ * @param int capacity: Número de vagas (até OCCUPANCY_MAX_CAPACITY)
+ * @param uint64_t *full: Destino do mapa, com OCCUPANCY_WORDS palavras
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+void getFullSlots(const Occupancy *occupancy, long day, int capacity, uint64_t *full) {
+    bool isFound;
+    int index = findDay(occupancy, day, &isFound);
+    if (capacity > OCCUPANCY_MAX_CAPACITY) capacity = OCCUPANCY_MAX_CAPACITY;
+
+    for (int i = 0; i < OCCUPANCY_WORDS; i++) full[i] = isFound && capacity > 0 ? occupancy->days[index].layers[capacity - 1][i] : 0;
+}
+
+/**
+ * Procura, dentro das faixas [firstSlot, lastSlot) de um dia, as primeiras sequências de length faixas livres que não se
+ * sobrepõem. As faixas onde começa uma sequência livre são obtidas combinando o mapa livre com cópias deslocadas de si
+ * mesmo, dobrando o comprimento coberto a cada passo.
+ * 
+ * @param const uint64_t *busy: Mapa das faixas ocupadas do dia
+ * @param int firstSlot
+ * @param int lastSlot
+ * @param int length: Número de faixas de cada sequência
+ * @param int *starts: Destino da faixa inicial de cada sequência
+ * @param int maxStarts: Número máximo de sequências
+ * 
+ * @return int: Número de sequências encontradas
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+int findFreeRuns(const uint64_t *busy, int firstSlot, int lastSlot, int length, int *starts, int maxStarts) {
+    if (length <= 0 || lastSlot - firstSlot < length) return 0;
+
+    uint64_t runs[OCCUPANCY_WORDS], window[OCCUPANCY_WORDS], shifted[OCCUPANCY_WORDS];
+    buildMask(window, firstSlot, lastSlot);
+    for (int i = 0; i < OCCUPANCY_WORDS; i++) runs[i] = ~busy[i] & window[i];
+
+    for (int covered = 1; covered < length;) {
+        int shift = covered < length - covered ? covered : length - covered;
+        shiftSlots(runs, shift, shifted);
+        for (int i = 0; i < OCCUPANCY_WORDS; i++) runs[i] &= shifted[i];
+        covered += shift;
+    }
+
+    int startsNumber = 0;
+    for (int slot = firstSlot; slot <= lastSlot - length && startsNumber < maxStarts;) {
+        uint64_t bits = runs[slot / 64] >> (slot % 64);
+        if (bits == 0) {
+            slot = (slot / 64 + 1) * 64;
+            continue;
+        }
+
+        while ((bits & 1) == 0) {
+            bits >>= 1;
+            slot++;
+        }
+        starts[startsNumber++] = slot;
+        slot += length;
+    }
+
+    return startsNumber;
+}
+
+/**
+ * Libera os dias de uma ocupação
+ * 
+ * @param Occupancy *occupancy
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+void freeOccupancy(Occupancy *occupancy) {
+    free(occupancy->days);
+    occupancy->days = NULL;
+    occupancy->daysNumber = 0;
+    occupancy->daysCapacity = 0;
+}
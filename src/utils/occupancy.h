@@ -0,0 +1,42 @@
+#ifndef OCCUPANCY
+#define OCCUPANCY
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define OCCUPANCY_SLOT_MINUTES 5
+#define OCCUPANCY_DAY_SLOTS (24 * 60 / OCCUPANCY_SLOT_MINUTES)
+#define OCCUPANCY_WORDS ((OCCUPANCY_DAY_SLOTS + 63) / 64)
+#define OCCUPANCY_MAX_CAPACITY 16
+
+/**
+ * Ocupação de um dia, dividido em faixas de OCCUPANCY_SLOT_MINUTES minutos. Cada camada é um mapa de bits do dia: o bit
+ * de uma faixa está ligado na camada k se a faixa tiver pelo menos k + 1 reservas.
+ */
+typedef struct DayOccupancy {
+    long day;
+    uint64_t layers[OCCUPANCY_MAX_CAPACITY][OCCUPANCY_WORDS];
+} DayOccupancy;
+
+/**
+ * Ocupação de um recurso (como as salas de um escritório), com os dias ordenados
+ */
+typedef struct Occupancy {
+    DayOccupancy *days;
+    int daysNumber;
+    int daysCapacity;
+} Occupancy;
+
+bool occupySlots(Occupancy*, long, long);
+
+void releaseSlots(Occupancy*, long, long);
+
+int getFreeCapacity(const Occupancy*, long, long, int);
+
+void getFullSlots(const Occupancy*, long, int, uint64_t*);
+
+int findFreeRuns(const uint64_t*, int, int, int, int*, int);
+
+void freeOccupancy(Occupancy*);
+
+#endif
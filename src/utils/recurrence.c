@@ -0,0 +1,178 @@
+#include <stdbool.h>
+#include "./recurrence.h"
+#include "./calendar.h"
+
+/**
+ * Retorna o número de meses entre janeiro do ano 0 e o mês de um instante
+ * 
+ * @param long minutes: Minutos desde 01/01/1970
+ * 
+ * @return long
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static long getMonthIndex(long minutes) {
+    int year, month, day;
+    civilFromDays(minutesToDays(minutes), &year, &month, &day);
+    return (long) year * 12 + month - 1;
+}
+
+/**
+ * Retorna o índice da primeira ocorrência que pode se sobrepor a um instante, sem percorrer as anteriores
+ * 
+ * @param const Recurrence *recurrence
+ * @param long from: Minutos desde 01/01/1970
+ * 
+ * @return long
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static long getFirstCandidate(const Recurrence *recurrence, long from) {
+    if (recurrence->frequency == RECURRENCE_WEEKLY) {
+        long period = (long) recurrence->interval * DAYS_PER_WEEK * MINUTES_PER_DAY;
+        long elapsed = from - recurrence->duration - recurrence->start;
+        return elapsed >= 0 ? elapsed / period + 1 : 0;
+    }
+
+    // Um mês de folga cobre a ocorrência do fim do mês anterior que ainda não terminou em from
+    long months = getMonthIndex(from) - getMonthIndex(recurrence->start) - 1;
+    return months > 0 ? months / recurrence->interval : 0;
+}
+
+/**
+ * Verifica se uma regra de repetição é válida: frequência conhecida, intervalo positivo, duração de até um dia e
+ * término posterior ao início
+ * 
+ * @param const Recurrence *recurrence
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool isValidRecurrence(const Recurrence *recurrence) {
+    return (recurrence->frequency == RECURRENCE_WEEKLY || recurrence->frequency == RECURRENCE_MONTHLY)
+        && recurrence->interval > 0
+        && recurrence->duration > 0 && recurrence->duration <= MINUTES_PER_DAY
+        && recurrence->until >= recurrence->start
+        && recurrence->exceptionsNumber >= 0 && recurrence->exceptionsNumber <= RECURRENCE_MAX_EXCEPTIONS;
+}
+
+/**
+ * Calcula o início da ocorrência de índice index. Nas repetições mensais, os meses que não têm o dia da primeira
+ * ocorrência (como o dia 31 em abril) são pulados.
+ * 
+ * @param const Recurrence *recurrence
+ * @param long index: Índice da ocorrência, a partir de 0
+ * @param long *start: Destino do início, em minutos desde 01/01/1970. Quando o mês não tem o dia, recebe o início do
+ * primeiro dia do mês, que serve apenas para limitar a busca.
+ * 
+ * @return bool: Retorna false se a ocorrência não existir
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool getOccurrenceStart(const Recurrence *recurrence, long index, long *start) {
+    if (recurrence->frequency == RECURRENCE_WEEKLY) {
+        *start = recurrence->start + index * recurrence->interval * DAYS_PER_WEEK * MINUTES_PER_DAY;
+        return true;
+    }
+
+    int year, month, day;
+    civilFromDays(minutesToDays(recurrence->start), &year, &month, &day);
+
+    long monthIndex = (long) year * 12 + month - 1 + index * recurrence->interval;
+    year = (int) (monthIndex / 12);
+    month = (int) (monthIndex % 12) + 1;
+
+    bool exists = day <= getDaysInMonth(month, year);
+    *start = daysFromCivil(year, month, exists ? day : 1) * MINUTES_PER_DAY + getMinuteOfDay(recurrence->start);
+    return exists;
+}
+
+/**
+ * Verifica se um horário é uma ocorrência cancelada
+ * 
+ * @param const Recurrence *recurrence
+ * @param long start: Minutos desde 01/01/1970
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static bool isException(const Recurrence *recurrence, long start) {
+    for (int i = 0; i < recurrence->exceptionsNumber; i++) {
+        if (recurrence->exceptions[i] == start) return true;
+    }
+    return false;
+}
+
+/**
+ * Calcula, em ordem, os inícios das ocorrências que se sobrepõem ao intervalo [from, to), sem contar as canceladas. Só
+ * as ocorrências da janela são calculadas, a partir do índice da primeira delas.
+ * 
+ * @param const Recurrence *recurrence
+ * @param long from: Minutos desde 01/01/1970
+ * @param long to
+ * @param long *starts: Destino dos inícios
+ * @param int maxStarts: Número máximo de ocorrências
+ * 
+ * @return int: Número de ocorrências encontradas
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+int expandRecurrence(const Recurrence *recurrence, long from, long to, long *starts, int maxStarts) {
+    int startsNumber = 0;
+    long start;
+
+    if (!isValidRecurrence(recurrence)) return 0;
+
+    for (long index = getFirstCandidate(recurrence, from); startsNumber < maxStarts; index++) {
+        bool exists = getOccurrenceStart(recurrence, index, &start);
+        if (start >= to || start > recurrence->until) break;
+
+        if (exists && start + recurrence->duration > from && !isException(recurrence, start)) {
+            starts[startsNumber++] = start;
+        }
+    }
+
+    return startsNumber;
+}
+
+/**
+ * Verifica se um horário é o início de uma ocorrência não cancelada
+ * 
+ * @param const Recurrence *recurrence
+ * @param long start: Minutos desde 01/01/1970
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool isOccurrence(const Recurrence *recurrence, long start) {
+    long found;
+    return expandRecurrence(recurrence, start, start + 1, &found, 1) == 1 && found == start;
+}
+
+/**
+ * Cancela uma ocorrência, guardando o seu início entre as exceções da regra
+ * 
+ * @param Recurrence *recurrence
+ * @param long start: Início da ocorrência, em minutos desde 01/01/1970
+ * 
+ * @return bool: Retorna false se o horário não for uma ocorrência ou se não houver espaço para mais exceções
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool addRecurrenceException(Recurrence *recurrence, long start) {
+    if (!isOccurrence(recurrence, start) || recurrence->exceptionsNumber >= RECURRENCE_MAX_EXCEPTIONS) return false;
+
+    recurrence->exceptions[recurrence->exceptionsNumber++] = (int) start;
+    return true;
+}
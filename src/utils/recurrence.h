@@ -0,0 +1,38 @@
+#ifndef RECURRENCE
+#define RECURRENCE
+
+#include <stdbool.h>
+
+#define RECURRENCE_MAX_EXCEPTIONS 16
+
+typedef enum RecurrenceFrequency {
+    RECURRENCE_WEEKLY = 1,
+    RECURRENCE_MONTHLY
+} RecurrenceFrequency;
+
+/**
+ * Regra de repetição de um horário. As ocorrências começam em start e se repetem a cada interval semanas (ou meses, no
+ * mesmo dia do mês) até until, exceto as que começam em um dos horários de exceptions. Os horários são armazenados em
+ * minutos desde 01/01/1970 00:00, e as ocorrências são calculadas apenas quando necessárias.
+ */
+typedef struct Recurrence {
+    int start;
+    int duration;
+    int frequency;
+    int interval;
+    int until;
+    int exceptionsNumber;
+    int exceptions[RECURRENCE_MAX_EXCEPTIONS];
+} Recurrence;
+
+bool isValidRecurrence(const Recurrence*);
+
+bool getOccurrenceStart(const Recurrence*, long, long*);
+
+int expandRecurrence(const Recurrence*, long, long, long*, int);
+
+bool isOccurrence(const Recurrence*, long);
+
+bool addRecurrenceException(Recurrence*, long);
+
+#endif
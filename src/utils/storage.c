@@ -2,113 +2,2007 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <string.h>
+#include <time.h>
 #include "./storage.h"
 
+#ifdef __unix__
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#else
+
+#include <io.h>
+
+#endif
+
+/**
+ * Estado de um arquivo de dados mantido durante a sessão: cabeçalho em cache, descritor aberto e mapeamento em memória
+ */
+typedef struct StorageFile {
+    char filename[64];
+    size_t structSize;
+    long idOffset;
+    long deletedOffset;
+    FileHeader header;
+    FILE *fp;
+    bool isMapped;
+    void *data;
+    size_t length;
+    bool isMmap;
+    bool isStale;
+    unsigned long version;
+    int *slots;
+    int slotsCapacity;
+    bool isIndexed;
+} StorageFile;
+
+/**
+ * Escrita preparada durante uma operação e ainda não aplicada ao arquivo de dados
+ */
+typedef struct StagedWrite {
+    StorageFile *file;
+    long offset;
+    size_t length;
+    char *data;
+} StagedWrite;
+
+/**
+ * Cabeçalho de cada entrada do log de escrita antecipada (write-ahead log). Entradas do tipo LOG_WRITE são seguidas
+ * por length bytes de dados; uma entrada LOG_COMMIT encerra o grupo de escritas de uma operação.
+ */
+typedef struct LogEntry {
+    unsigned int magic;
+    unsigned int type;
+    unsigned int checksum;
+    unsigned int length;
+    long offset;
+    char filename[64];
+} LogEntry;
+
+static StorageFile storageFiles[MAX_STORAGE_FILES];
+static int storageFilesNumber = 0;
+
+static StagedWrite *stagedWrites = NULL;
+static int stagedWritesNumber = 0, stagedWritesCapacity = 0;
+static StagedWrite *committedWrites = NULL;
+static int committedWritesNumber = 0, committedWritesCapacity = 0;
+
+static FILE *logFile = NULL;
+static long logSize = 0;
+static bool isRecovered = false;
+static DurabilityMode durabilityMode = DURABILITY_SYNC;
+static int groupCommitInterval = DEFAULT_GROUP_COMMIT_INTERVAL;
+static int groupCommitSize = DEFAULT_GROUP_COMMIT_SIZE;
+static int pendingCommitsNumber = 0;
+static double firstPendingCommitTime = 0;
+static int transactionDepth = 0;
+static unsigned long lastVersion = 0;
+
+static bool syncFile(FILE*);
+static void syncDirectory(const char*);
+static void releaseMappedFile(StorageFile*);
+static bool recoverFromLog(void);
+static bool syncLog(bool);
+static bool saveSlotIndex(StorageFile*);
+static bool loadSlotIndex(StorageFile*);
+
+/**
+ * Procura um arquivo entre os arquivos já abertos na sessão
+ * 
+ * @param const char *filename: Caminho completo do arquivo
+ * 
+ * @return StorageFile*|NULL: Estado do arquivo | NULL, caso o arquivo ainda não tenha sido aberto
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static StorageFile* findStorageFile(const char *filename) {
+    for (int i = 0; i < storageFilesNumber; i++) {
+        if (strcmp(storageFiles[i].filename, filename) == 0) return &storageFiles[i];
+    }
+    return NULL;
+}
+
+/**
+ * Retorna o número total de registros (ativos e excluídos) de um arquivo
+ * 
+ * @param const StorageFile *file
+ * 
+ * @return int
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static int countRecords(const StorageFile *file) {
+    return file->header.liveCount + file->header.deletedCount;
+}
+
+/**
+ * Retorna a posição, em bytes, de um registro dentro do arquivo
+ * 
+ * @param const StorageFile *file
+ * @param int index: Posição do registro (começando em 0)
+ * 
+ * @return long
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static long recordOffset(const StorageFile *file, int index) {
+    return (long) sizeof(FileHeader) + (long) index * (long) file->structSize;
+}
+
+/**
+ * Verifica se um registro está marcado como excluído. Se a posição do campo isDeleted não for conhecida, o registro é
+ * considerado ativo.
+ * 
+ * @param const StorageFile *file
+ * @param const void *element
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static bool isElementDeleted(const StorageFile *file, const void *element) {
+    if (file->deletedOffset < 0) return false;
+    return *((const bool*) ((const char*) element + file->deletedOffset));
+}
+
+/**
+ * Retorna o ID estável de um registro. Se a posição do campo id não for conhecida, retorna 0.
+ * 
+ * @param const StorageFile *file
+ * @param const void *element
+ * 
+ * @return int
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static int getElementId(const StorageFile *file, const void *element) {
+    int id = 0;
+    if (file->idOffset >= 0) memcpy(&id, (const char*) element + file->idOffset, sizeof(int));
+    return id;
+}
+
+/**
+ * Define o ID estável de um registro, caso a posição do campo id seja conhecida
+ * 
+ * @param const StorageFile *file
+ * @param void *element
+ * @param int id
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static void setElementId(const StorageFile *file, void *element, int id) {
+    if (file->idOffset >= 0) memcpy((char*) element + file->idOffset, &id, sizeof(int));
+}
+
+/**
+ * Retorna a posição atual do registro com um determinado ID
+ * 
+ * @param const StorageFile *file
+ * @param int id
+ * 
+ * @return int: Posição do registro (começando em 0) ou -1, caso não exista um registro ativo com o ID
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static int getElementSlot(const StorageFile *file, int id) {
+    if (id <= 0 || id > file->slotsCapacity) return -1;
+    return file->slots[id - 1];
+}
+
+/**
+ * Associa um ID à posição do seu registro no arquivo. A posição -1 desfaz a associação.
+ * 
+ * @param StorageFile *file
+ * @param int id
+ * @param int slot: Posição do registro (começando em 0) ou -1
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static bool setElementSlot(StorageFile *file, int id, int slot) {
+    if (id <= 0) return false;
+
+    if (id > file->slotsCapacity) {
+        int capacity = file->slotsCapacity ? file->slotsCapacity : 64;
+        while (capacity < id) capacity *= 2;
+
+        int *slots = (int*) realloc(file->slots, capacity * sizeof(int));
+        if (slots == NULL) return false;
+        for (int i = file->slotsCapacity; i < capacity; i++) slots[i] = -1;
+        file->slots = slots;
+        file->slotsCapacity = capacity;
+    }
+
+    file->slots[id - 1] = slot;
+    return true;
+}
+
+/**
+ * Associa os IDs de um conjunto de registros consecutivos às suas posições. Registros excluídos são ignorados.
+ * 
+ * @param StorageFile *file
+ * @param const char *elements
+ * @param int elementsNumber
+ * @param int firstIndex: Posição do primeiro registro do conjunto
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static bool indexElements(StorageFile *file, const char *elements, int elementsNumber, int firstIndex) {
+    for (int i = 0; i < elementsNumber; i++) {
+        const char *element = elements + (size_t) i * file->structSize;
+        if (isElementDeleted(file, element)) continue;
+        if (!setElementSlot(file, getElementId(file, element), firstIndex + i)) return false;
+    }
+    return true;
+}
+
+/**
+ * Descarta a associação entre IDs e posições de um arquivo
+ * 
+ * @param StorageFile *file
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static void resetSlotIndex(StorageFile *file) {
+    free(file->slots);
+    file->slots = NULL;
+    file->slotsCapacity = 0;
+}
+
+/**
+ * Monta, percorrendo o arquivo em blocos, a associação entre o ID de cada registro ativo e a sua posição
+ * 
+ * @param StorageFile *file
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static bool buildSlotIndex(StorageFile *file) {
+    resetSlotIndex(file);
+
+    int elementsNumber = countRecords(file);
+    if (elementsNumber == 0) return true;
+
+    FILE *fp = fopen(file->filename, "rb");
+    if (fp == NULL) return false;
+
+    const int chunkSize = 256;
+    char *buffer = (char*) malloc(file->structSize * chunkSize);
+    bool status = buffer != NULL && fseek(fp, sizeof(FileHeader), SEEK_SET) == 0;
+
+    for (int index = 0; status && index < elementsNumber; index += chunkSize) {
+        int count = elementsNumber - index < chunkSize ? elementsNumber - index : chunkSize;
+        status = fread(buffer, file->structSize, count, fp) == (size_t) count && indexElements(file, buffer, count, index);
+    }
+
+    free(buffer);
+    fclose(fp);
+    return status;
+}
+
+/**
+ * Cria um cabeçalho vazio para um arquivo
+ * 
+ * @param FileHeader *header
+ * @param const size_t structSize: Tamanho da struct armazenada
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static void initHeader(FileHeader *header, const size_t structSize) {
+    header->magic = STORAGE_MAGIC;
+    header->version = STORAGE_VERSION;
+    header->recordSize = (unsigned int) structSize;
+    header->liveCount = 0;
+    header->deletedCount = 0;
+    header->nextId = 1;
+}
+
+/**
+ * Escreve um cabeçalho seguido de um conjunto de registros em um arquivo, substituindo o seu conteúdo. O conteúdo é
+ * escrito em um arquivo temporário, gravado em disco e só então renomeado por cima do original, de modo que uma falha
+ * no meio da escrita preserva o arquivo anterior.
+ * 
+ * @param const char *filename: Caminho completo do arquivo
+ * @param const FileHeader *header
+ * @param const void *ptr: Registros
+ * @param const size_t size: Tamanho de cada registro
+ * @param int elementsNumber: Número de registros
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static bool writeWholeFile(const char *filename, const FileHeader *header, const void *ptr, const size_t size, int elementsNumber) {
+    char tempFilename[80];
+    snprintf(tempFilename, sizeof(tempFilename), "%s.tmp", filename);
+
+    FILE *fp = fopen(tempFilename, "wb");
+    if (fp == NULL) return false;
+
+    bool status = fwrite(header, sizeof(FileHeader), 1, fp) == 1;
+    if (status && elementsNumber > 0) status = fwrite(ptr, size, elementsNumber, fp) == (size_t) elementsNumber;
+    if (durabilityMode != DURABILITY_NONE) status = syncFile(fp) && status;
+    status = fclose(fp) == 0 && status;
+
+    #ifndef __unix__
+        // Fora do UNIX, rename não substitui um arquivo existente
+        if (status) remove(filename);
+    #endif
+    if (!status || rename(tempFilename, filename) != 0) {
+        remove(tempFilename);
+        return false;
+    }
+    if (durabilityMode != DURABILITY_NONE) syncDirectory(filename);
+
+    return true;
+}
+
+/**
+ * Converte um arquivo de um formato antigo para o formato atual: arquivos sem cabeçalho (apenas registros) e arquivos
+ * da versão 1, cujos registros não tinham ID estável. Os registros recebem os IDs correspondentes às suas posições,
+ * que eram os códigos usados até então, de modo que as referências entre tabelas continuam válidas.
+ * 
+ * @param StorageFile *file
+ * @param long dataOffset: Posição do primeiro registro no arquivo antigo
+ * @param int elementsNumber: Número de registros no arquivo antigo
+ * 
+ * @return bool: Retorna false se o arquivo não puder ser convertido
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static bool upgradeLegacyFile(StorageFile *file, long dataOffset, int elementsNumber) {
+    char *buffer = (char*) malloc(elementsNumber > 0 ? (size_t) elementsNumber * file->structSize : 1);
+    if (buffer == NULL) return false;
+
+    FILE *fp = fopen(file->filename, "rb");
+    if (fp == NULL || fseek(fp, dataOffset, SEEK_SET) != 0 || fread(buffer, file->structSize, elementsNumber, fp) != (size_t) elementsNumber) {
+        if (fp != NULL) fclose(fp);
+        free(buffer);
+        return false;
+    }
+    fclose(fp);
+
+    initHeader(&file->header, file->structSize);
+    for (int i = 0; i < elementsNumber; i++) {
+        char *element = buffer + (size_t) i * file->structSize;
+        setElementId(file, element, i + 1);
+        if (isElementDeleted(file, element)) file->header.deletedCount++;
+        else file->header.liveCount++;
+    }
+    file->header.nextId = elementsNumber + 1;
+
+    bool status = writeWholeFile(file->filename, &file->header, buffer, file->structSize, elementsNumber);
+    free(buffer);
+
+    return status;
+}
+
+/**
+ * Lê o cabeçalho de um arquivo, validando o número mágico, a versão e o tamanho do registro. Arquivos inexistentes
+ * recebem um cabeçalho vazio e arquivos em formatos antigos são convertidos.
+ * 
+ * @param StorageFile *file
+ * 
+ * @return bool: Retorna false se o layout do arquivo não corresponder à struct esperada
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static bool loadHeader(StorageFile *file) {
+    initHeader(&file->header, file->structSize);
+
+    FILE *fp = fopen(file->filename, "rb");
+    if (fp == NULL) return true;
+
+    fseek(fp, 0, SEEK_END);
+    long fileSize = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+
+    FileHeader header;
+    bool hasHeader = fileSize >= (long) sizeof(FileHeader) && fread(&header, sizeof(FileHeader), 1, fp) == 1;
+    fclose(fp);
+
+    if (fileSize <= 0) return true;
+    if (!hasHeader || header.magic != STORAGE_MAGIC) {
+        if (fileSize % (long) file->structSize != 0) return false;
+        return upgradeLegacyFile(file, 0, (int) (fileSize / (long) file->structSize));
+    }
+    if (header.recordSize != file->structSize) return false;
+    if (header.version == 1) return upgradeLegacyFile(file, sizeof(FileHeader), header.liveCount + header.deletedCount);
+    if (header.version != STORAGE_VERSION) return false;
+
+    file->header = header;
+    return true;
+}
+
+/**
+ * Registra um arquivo na sessão, lendo o seu cabeçalho. Se o arquivo já estiver registrado, apenas retorna o seu estado.
+ * 
+ * @param const char *filename: Caminho completo do arquivo
+ * @param const size_t structSize: Tamanho da struct armazenada
+ * @param long idOffset: Posição do campo id dentro da struct, ou -1 se desconhecida
+ * @param long deletedOffset: Posição do campo isDeleted dentro da struct, ou -1 se desconhecida
+ * 
+ * @return StorageFile*|NULL: Estado do arquivo | NULL, se o layout do arquivo não corresponder à struct
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static StorageFile* registerStorageFile(const char *filename, const size_t structSize, long idOffset, long deletedOffset) {
+    StorageFile *file = findStorageFile(filename);
+    if (file != NULL) return file->structSize == structSize ? file : NULL;
+
+    // Antes do primeiro acesso da sessão, reaplica as escritas que ficaram no log após uma falha
+    if (!isRecovered && !recoverFromLog()) return NULL;
+
+    if (storageFilesNumber >= MAX_STORAGE_FILES || strlen(filename) >= sizeof(file->filename)) return NULL;
+
+    file = &storageFiles[storageFilesNumber];
+    memset(file, 0, sizeof(StorageFile));
+    strcpy(file->filename, filename);
+    file->structSize = structSize;
+    // As posições de id e isDeleted são registradas antes da leitura do cabeçalho para que a conversão de arquivos
+    // antigos consiga atribuir os IDs e contar os registros excluídos
+    file->idOffset = idOffset;
+    file->deletedOffset = deletedOffset;
+    file->version = ++lastVersion;
+
+    if (!loadHeader(file)) return NULL;
+
+    storageFilesNumber++;
+    return file;
+}
+
+/**
+ * Retorna o estado de um arquivo, abrindo-o e lendo o seu cabeçalho caso seja o primeiro acesso na sessão
+ * 
+ * @param const char *filename: Caminho completo do arquivo
+ * @param const size_t structSize: Tamanho da struct armazenada
+ * 
+ * @return StorageFile*|NULL: Estado do arquivo | NULL, se o layout do arquivo não corresponder à struct
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static StorageFile* getStorageFile(const char *filename, const size_t structSize) {
+    return registerStorageFile(filename, structSize, -1, -1);
+}
+
+/**
+ * Retorna o estado da lista de posições livres de um arquivo: um arquivo auxiliar, com cabeçalho próprio, que guarda
+ * como uma pilha as posições de registros excluídos que podem ser reaproveitadas por novas inserções
+ * 
+ * @param const StorageFile *file
+ * 
+ * @return StorageFile*|NULL
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static StorageFile* getFreeList(const StorageFile *file) {
+    char filename[80];
+    snprintf(filename, sizeof(filename), "%s%s", file->filename, STORAGE_FREE_LIST_SUFFIX);
+    return getStorageFile(filename, sizeof(int));
+}
+
+/**
+ * Retorna o estado do índice de posições de um arquivo: um arquivo auxiliar, com cabeçalho próprio, em que a entrada
+ * id - 1 guarda a posição atual do registro com aquele ID, ou -1 se o registro foi excluído
+ * 
+ * @param const StorageFile *file
+ * 
+ * @return StorageFile*|NULL
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static StorageFile* getSlotIndexFile(const StorageFile *file) {
+    char filename[80];
+    snprintf(filename, sizeof(filename), "%s%s", file->filename, STORAGE_SLOT_INDEX_SUFFIX);
+    return getStorageFile(filename, sizeof(int));
+}
+
+/**
+ * Carrega o índice de posições de um arquivo com uma única leitura. Se o índice não existir ou não cobrir todos os IDs
+ * já atribuídos, ele é reconstruído percorrendo os registros e salvo novamente.
+ * 
+ * @param StorageFile *file
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static bool loadSlotIndex(StorageFile *file) {
+    resetSlotIndex(file);
+
+    StorageFile *slotIndex = getSlotIndexFile(file);
+    if (slotIndex == NULL) return false;
+
+    int idsNumber = file->header.nextId - 1;
+    if (countRecords(slotIndex) != idsNumber) return buildSlotIndex(file) && saveSlotIndex(file);
+    if (idsNumber == 0) return true;
+
+    int *slots = (int*) malloc(idsNumber * sizeof(int));
+    if (slots == NULL) return false;
+
+    FILE *fp = fopen(slotIndex->filename, "rb");
+    bool status = fp != NULL && fseek(fp, sizeof(FileHeader), SEEK_SET) == 0 && fread(slots, sizeof(int), idsNumber, fp) == (size_t) idsNumber;
+    if (fp != NULL) fclose(fp);
+    if (!status) {
+        free(slots);
+        return buildSlotIndex(file) && saveSlotIndex(file);
+    }
+
+    file->slots = slots;
+    file->slotsCapacity = idsNumber;
+    return true;
+}
+
+/**
+ * Força a gravação em disco do conteúdo de um arquivo aberto
+ * 
+ * @param FILE *fp
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ * 
+ * References:
+ *  - https://man7.org/linux/man-pages/man2/fsync.2.html
+ */
+static bool syncFile(FILE *fp) {
+    if (fflush(fp) != 0) return false;
+    #ifdef __unix__
+        return fsync(fileno(fp)) == 0;
+    #else
+        return _commit(_fileno(fp)) == 0;
+    #endif
+}
+
+/**
+ * Força a gravação em disco do diretório de um arquivo, tornando um rename durável
+ * 
+ * @param const char *filename: Caminho completo do arquivo
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static void syncDirectory(const char *filename) {
+    #ifdef __unix__
+        char directory[256] = ".";
+        const char *slash = strrchr(filename, '/');
+        if (slash != NULL && (size_t) (slash - filename) < sizeof(directory)) {
+            memcpy(directory, filename, slash - filename);
+            directory[slash == filename ? 1 : slash - filename] = '\0';
+        }
+        int fd = open(directory, O_RDONLY);
+        if (fd >= 0) {
+            fsync(fd);
+            close(fd);
+        }
+    #else
+        (void) filename;
+    #endif
+}
+
+/**
+ * Retorna o descritor de escrita de um arquivo, criando o arquivo caso ele ainda não exista
+ * 
+ * @param StorageFile *file
+ * 
+ * @return FILE*|NULL
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static FILE* getWritableFile(StorageFile *file) {
+    if (file->fp != NULL) return file->fp;
+
+    file->fp = fopen(file->filename, "r+b");
+    if (file->fp == NULL) file->fp = fopen(file->filename, "w+b");
+
+    return file->fp;
+}
+
+/**
+ * Fecha o descritor de escrita de um arquivo
+ * 
+ * @param StorageFile *file
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static void closeWritableFile(StorageFile *file) {
+    if (file->fp != NULL) fclose(file->fp);
+    file->fp = NULL;
+}
+
+/**
+ * Calcula o checksum (FNV-1a) de uma entrada do log e dos seus dados
+ * 
+ * @param const LogEntry *entry
+ * @param const void *data
+ * 
+ * @return unsigned int
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ * 
+ * References:
+ *  - http://www.isthe.com/chongo/tech/comp/fnv/index.html
+ */
+static unsigned int logChecksum(const LogEntry *entry, const void *data) {
+    unsigned int hash = 2166136261u;
+    LogEntry copy = *entry;
+    copy.checksum = 0;
+
+    const unsigned char *bytes = (const unsigned char*) &copy;
+    for (size_t i = 0; i < sizeof(LogEntry); i++) hash = (hash ^ bytes[i]) * 16777619u;
+
+    bytes = (const unsigned char*) data;
+    for (size_t i = 0; i < entry->length; i++) hash = (hash ^ bytes[i]) * 16777619u;
+
+    return hash;
+}
+
+/**
+ * Acrescenta uma entrada ao final do log
+ * 
+ * @param unsigned int type: LOG_WRITE ou LOG_COMMIT
+ * @param const char *filename: Arquivo de dados afetado
+ * @param long offset: Posição da escrita no arquivo de dados
+ * @param const void *data: Dados escritos
+ * @param size_t length: Quantidade de bytes
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static bool appendLogEntry(unsigned int type, const char *filename, long offset, const void *data, size_t length) {
+    if (logFile == NULL) {
+        logFile = fopen(STORAGE_LOG_FILE, "ab");
+        if (logFile == NULL) return false;
+    }
+
+    LogEntry entry;
+    memset(&entry, 0, sizeof(LogEntry));
+    entry.magic = LOG_ENTRY_MAGIC;
+    entry.type = type;
+    entry.length = (unsigned int) length;
+    entry.offset = offset;
+    strcpy(entry.filename, filename);
+    entry.checksum = logChecksum(&entry, data);
+
+    if (fwrite(&entry, sizeof(LogEntry), 1, logFile) != 1) return false;
+    if (length > 0 && fwrite(data, 1, length, logFile) != length) return false;
+
+    logSize += (long) (sizeof(LogEntry) + length);
+    return true;
+}
+
+/**
+ * Descarta as entradas gravadas no log a partir de uma posição, como as de um grupo cuja gravação falhou no meio. Sem
+ * isso, as entradas que chegaram ao arquivo seriam reunidas pela recuperação ao grupo seguinte e reaplicadas com o
+ * commit dele. O log é fechado (o que também descarta o que ficou no buffer) e reaberto na próxima entrada.
+ * 
+ * @param long size: Tamanho do log antes do grupo
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static bool rewindLog(long size) {
+    if (logFile != NULL) fclose(logFile);
+    logFile = NULL;
+
+    FILE *fp = fopen(STORAGE_LOG_FILE, "r+b");
+    if (fp == NULL) return false;
+    #ifdef __unix__
+        bool status = ftruncate(fileno(fp), size) == 0;
+    #else
+        bool status = _chsize(_fileno(fp), size) == 0;
+    #endif
+    status = syncFile(fp) && status;
+    fclose(fp);
+    if (status) logSize = size;
+
+    return status;
+}
+
+/**
+ * Retorna o tempo atual em milissegundos
+ * 
+ * @return double
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static double currentTime(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+/**
+ * Aplica aos arquivos de dados as escritas confirmadas no log e ainda não aplicadas, na ordem em que foram confirmadas
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static bool applyCommittedWrites(void) {
+    bool status = true;
+
+    for (int i = 0; i < committedWritesNumber && status; i++) {
+        StagedWrite *write = &committedWrites[i];
+        FILE *fp = getWritableFile(write->file);
+        status = fp != NULL && fseek(fp, write->offset, SEEK_SET) == 0 && fwrite(write->data, 1, write->length, fp) == write->length;
+        write->file->isStale = true;
+    }
+    for (int i = 0; i < committedWritesNumber && status; i++) {
+        status = fflush(committedWrites[i].file->fp) == 0;
+    }
+
+    for (int i = 0; i < committedWritesNumber; i++) free(committedWrites[i].data);
+    committedWritesNumber = 0;
+
+    return status;
+}
+
+/**
+ * Grava o log em disco de acordo com o modo de durabilidade, após o commit de uma operação, e aplica aos arquivos de
+ * dados as escritas cobertas pela gravação. No modo de commit em grupo, o fsync só acontece quando o grupo atinge o
+ * número máximo de operações ou quando a operação mais antiga do grupo espera há mais do que o intervalo configurado;
+ * até lá, as escritas do grupo ficam apenas em memória, para que nenhum arquivo de dados chegue ao disco antes do log
+ * que permite refazê-lo.
+ * 
+ * @param bool force: Grava em disco as operações pendentes, independentemente do modo
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static bool syncLog(bool force) {
+    if (logFile == NULL) return true;
+
+    bool shouldSync = force || durabilityMode == DURABILITY_SYNC;
+    if (!force && durabilityMode == DURABILITY_GROUP) {
+        double now = currentTime();
+        if (pendingCommitsNumber == 0) firstPendingCommitTime = now;
+        pendingCommitsNumber++;
+        shouldSync = pendingCommitsNumber >= groupCommitSize || now - firstPendingCommitTime >= groupCommitInterval;
+    }
+
+    if (!shouldSync) {
+        if (fflush(logFile) != 0) return false;
+        // Sem fsync, a ordem entre o log e os arquivos de dados não é garantida de qualquer forma
+        return durabilityMode == DURABILITY_NONE ? applyCommittedWrites() : true;
+    }
+
+    pendingCommitsNumber = 0;
+    return syncFile(logFile) && applyCommittedWrites();
+}
+
+/**
+ * Grava em disco o grupo de operações pendente no modo de commit em grupo e aplica as suas escritas aos arquivos de
+ * dados. Deve ser chamada quando o programa fica ocioso (como ao voltar para um menu), para que as operações não
+ * esperem pela próxima escrita para se tornarem duráveis. Também é chamada antes das leituras feitas diretamente nos
+ * arquivos de dados.
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool syncPendingCommits(void) {
+    if (committedWritesNumber == 0) return true;
+    return syncLog(true);
+}
+
+/**
+ * Aplica todas as escritas pendentes aos arquivos de dados e grava em disco todos os arquivos abertos. Depois disso, o
+ * log pode ser esvaziado com segurança.
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool checkpointFiles(void) {
+    if (!syncPendingCommits()) return false;
+
+    bool status = true;
+    for (int i = 0; i < storageFilesNumber; i++) {
+        if (storageFiles[i].fp != NULL && !syncFile(storageFiles[i].fp)) status = false;
+    }
+    if (!status) return false;
+
+    if (logFile == NULL) return true;
+
+    fclose(logFile);
+    logFile = fopen(STORAGE_LOG_FILE, "wb");
+    if (logFile == NULL) return false;
+    logSize = 0;
+    pendingCommitsNumber = 0;
+
+    return syncFile(logFile);
+}
+
+/**
+ * Descarta as escritas preparadas pela operação atual
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static void discardWrites(void) {
+    for (int i = 0; i < stagedWritesNumber; i++) free(stagedWrites[i].data);
+    stagedWritesNumber = 0;
+}
+
+/**
+ * Prepara uma escrita em um arquivo de dados. A escrita só é registrada no log e aplicada ao arquivo em commitWrites.
+ * 
+ * @param StorageFile *file
+ * @param long offset: Posição em bytes
+ * @param const void *data
+ * @param size_t length: Quantidade de bytes
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static bool stageWrite(StorageFile *file, long offset, const void *data, size_t length) {
+    if (stagedWritesNumber == stagedWritesCapacity) {
+        int capacity = stagedWritesCapacity ? stagedWritesCapacity * 2 : 8;
+        StagedWrite *writes = (StagedWrite*) realloc(stagedWrites, capacity * sizeof(StagedWrite));
+        if (writes == NULL) return false;
+        stagedWrites = writes;
+        stagedWritesCapacity = capacity;
+    }
+
+    StagedWrite *write = &stagedWrites[stagedWritesNumber];
+    write->data = (char*) malloc(length);
+    if (write->data == NULL) return false;
+    memcpy(write->data, data, length);
+    write->file = file;
+    write->offset = offset;
+    write->length = length;
+    stagedWritesNumber++;
+
+    return true;
+}
+
+/**
+ * Sobrepõe a um trecho lido de um arquivo de dados as partes de uma lista de escritas que o atingem
+ * 
+ * @param const StagedWrite *writes
+ * @param int writesNumber
+ * @param const StorageFile *file
+ * @param long offset: Posição do trecho em bytes
+ * @param void *data: Trecho lido
+ * @param size_t length: Quantidade de bytes
+ * @param size_t *read: Quantidade de bytes disponíveis desde o início do trecho, atualizada com as escritas
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static void overlayWrites(const StagedWrite *writes, int writesNumber, const StorageFile *file, long offset, void *data, size_t length, size_t *read) {
+    for (int i = 0; i < writesNumber; i++) {
+        const StagedWrite *write = &writes[i];
+        long start = offset > write->offset ? offset : write->offset;
+        long end = offset + (long) length < write->offset + (long) write->length ? offset + (long) length : write->offset + (long) write->length;
+        if (write->file != file || start >= end) continue;
+
+        memcpy((char*) data + (start - offset), write->data + (start - write->offset), end - start);
+        if (start <= offset + (long) *read && end > offset + (long) *read) *read = (size_t) (end - offset);
+    }
+}
+
+/**
+ * Lê um trecho de um arquivo de dados considerando as escritas ainda não aplicadas: primeiro as já confirmadas no log,
+ * que aguardam o fsync do seu grupo, e depois as preparadas, de modo que uma transação enxergue as suas próprias
+ * escritas
+ * 
+ * @param const StorageFile *file
+ * @param long offset: Posição em bytes
+ * @param void *data: Destino da leitura
+ * @param size_t length: Quantidade de bytes
+ * 
+ * @return bool: Retorna false se o trecho não existir no arquivo nem nas escritas preparadas
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static bool readStoredData(const StorageFile *file, long offset, void *data, size_t length) {
+    size_t read = 0;
+
+    FILE *fp = fopen(file->filename, "rb");
+    if (fp != NULL) {
+        if (fseek(fp, offset, SEEK_SET) == 0) read = fread(data, 1, length, fp);
+        fclose(fp);
+    }
+    memset((char*) data + read, 0, length - read);
+
+    overlayWrites(committedWrites, committedWritesNumber, file, offset, data, length, &read);
+    overlayWrites(stagedWrites, stagedWritesNumber, file, offset, data, length, &read);
+
+    return read == length;
+}
+
+/**
+ * Confirma as escritas preparadas pela operação atual: registra todas no log, seguidas de uma entrada de commit, e as
+ * passa para a lista de escritas confirmadas, que só são aplicadas aos arquivos de dados depois que o log que as cobre
+ * for gravado em disco (em syncLog). Dentro de uma transação, a confirmação é adiada até commitTransaction.
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static bool commitWrites(void) {
+    // Dentro de uma transação, as escritas continuam preparadas até commitTransaction
+    if (transactionDepth > 0) return true;
+
+    // O espaço na lista de escritas confirmadas é reservado antes do log, para que uma falha de memória não deixe no
+    // log um grupo que não pode ser aplicado
+    if (committedWritesNumber + stagedWritesNumber > committedWritesCapacity) {
+        int capacity = committedWritesCapacity ? committedWritesCapacity : 8;
+        while (capacity < committedWritesNumber + stagedWritesNumber) capacity *= 2;
+        StagedWrite *writes = (StagedWrite*) realloc(committedWrites, capacity * sizeof(StagedWrite));
+        if (writes == NULL) {
+            discardWrites();
+            return false;
+        }
+        committedWrites = writes;
+        committedWritesCapacity = capacity;
+    }
+
+    bool status = true;
+    long groupStart = logSize;
+
+    for (int i = 0; i < stagedWritesNumber && status; i++) {
+        StagedWrite *write = &stagedWrites[i];
+        status = appendLogEntry(LOG_WRITE, write->file->filename, write->offset, write->data, write->length);
+    }
+    // O grupo só é considerado registrado depois de sair do buffer; se falhar no meio, o que chegou ao log é descartado
+    status = status && appendLogEntry(LOG_COMMIT, "", 0, NULL, 0) && fflush(logFile) == 0;
+    if (!status) {
+        discardWrites();
+        rewindLog(groupStart);
+        return false;
+    }
+
+    for (int i = 0; i < stagedWritesNumber; i++) {
+        stagedWrites[i].file->version = ++lastVersion;
+        committedWrites[committedWritesNumber++] = stagedWrites[i];
+    }
+    stagedWritesNumber = 0;
+
+    status = syncLog(false);
+
+    if (status && logSize >= STORAGE_CHECKPOINT_SIZE) status = checkpointFiles();
+
+    return status;
+}
+
+/**
+ * Aplica diretamente a um arquivo de dados uma escrita lida do log
+ * 
+ * @param const LogEntry *entry
+ * @param const char *data
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static bool replayLogEntry(const LogEntry *entry, const char *data) {
+    FILE *fp = fopen(entry->filename, "r+b");
+    if (fp == NULL) fp = fopen(entry->filename, "w+b");
+    if (fp == NULL) return false;
+
+    bool status = fseek(fp, entry->offset, SEEK_SET) == 0 && fwrite(data, 1, entry->length, fp) == entry->length;
+    status = syncFile(fp) && status;
+    fclose(fp);
+
+    return status;
+}
+
+/**
+ * Reaplica as operações confirmadas no log aos arquivos de dados. Como as entradas guardam o conteúdo final de cada
+ * trecho escrito, reaplicá-las mais de uma vez não altera o resultado. Um grupo de escritas sem a entrada de commit,
+ * ou com checksum inválido, indica uma operação interrompida e é descartado.
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static bool recoverFromLog(void) {
+    FILE *fp = fopen(STORAGE_LOG_FILE, "rb");
+    if (fp != NULL) {
+        LogEntry *entries = NULL;
+        char **datas = NULL;
+        int entriesNumber = 0, capacity = 0;
+        bool status = true;
+        LogEntry entry;
+
+        while (status && fread(&entry, sizeof(LogEntry), 1, fp) == 1 && entry.magic == LOG_ENTRY_MAGIC) {
+            char *data = (char*) malloc(entry.length ? entry.length : 1);
+            if (data == NULL || fread(data, 1, entry.length, fp) != entry.length || logChecksum(&entry, data) != entry.checksum) {
+                free(data);
+                break;
+            }
+
+            if (entry.type == LOG_COMMIT) {
+                for (int i = 0; i < entriesNumber && status; i++) status = replayLogEntry(&entries[i], datas[i]);
+                for (int i = 0; i < entriesNumber; i++) free(datas[i]);
+                entriesNumber = 0;
+                free(data);
+                continue;
+            }
+
+            if (entriesNumber == capacity) {
+                int newCapacity = capacity ? capacity * 2 : 8;
+                LogEntry *newEntries = (LogEntry*) realloc(entries, newCapacity * sizeof(LogEntry));
+                if (newEntries != NULL) entries = newEntries;
+                char **newDatas = newEntries != NULL ? (char**) realloc(datas, newCapacity * sizeof(char*)) : NULL;
+                if (newDatas != NULL) datas = newDatas;
+                if (newEntries == NULL || newDatas == NULL) {
+                    free(data);
+                    status = false;
+                    break;
+                }
+                capacity = newCapacity;
+            }
+            entries[entriesNumber] = entry;
+            datas[entriesNumber] = data;
+            entriesNumber++;
+        }
+
+        for (int i = 0; i < entriesNumber; i++) free(datas[i]);
+        free(entries);
+        free(datas);
+        fclose(fp);
+        if (!status) return false;
+
+        // Com os arquivos de dados atualizados e gravados em disco, o log é esvaziado
+        if (logFile != NULL) fclose(logFile);
+        logFile = fopen(STORAGE_LOG_FILE, "wb");
+        if (logFile == NULL || !syncFile(logFile)) return false;
+    }
+
+    logSize = 0;
+    isRecovered = true;
+    return true;
+}
+
+/**
+ * Salva um conteúdo em um arquivo
+ * 
+ * @param const void *ptr: Conteúdo a ser salvo
+ * @param const size_t size: Tamanho do tipo do conteúdo
+ * @param int elementsNumber: Número de elementos
+ * @param const char *filename: Caminho completo do arquivo
+ * 
+ * @return bool: Retorna false se houver alguma falha ao salvar o arquivo, true se salvar com sucesso
+ */
+bool saveFile(const void *ptr, const size_t size, int elementsNumber, const char *filename) {
+    // A reescrita completa não passa pelo log e, por isso, não pode fazer parte de uma transação
+    if (transactionDepth > 0) return false;
+
+    StorageFile *file = getStorageFile(filename, size);
+    if (file == NULL) return false;
+
+    FileHeader header = file->header;
+    header.liveCount = 0;
+    header.deletedCount = 0;
+    for (int i = 0; i < elementsNumber; i++) {
+        if (isElementDeleted(file, (const char*) ptr + (size_t) i * size)) header.deletedCount++;
+        else header.liveCount++;
+    }
+    if (header.nextId <= elementsNumber) header.nextId = elementsNumber + 1;
+
+    // O log não pode conter escritas antigas deste arquivo, pois elas seriam reaplicadas sobre o novo conteúdo
+    if (!checkpointFiles()) return false;
+
+    // As posições livres deixam de valer com o novo conteúdo. A lista é esvaziada antes da reescrita: se houver uma
+    // falha entre as duas etapas, apenas deixam de ser reaproveitadas algumas posições, sem sobrescrever registros ativos
+    // O índice de posições também é removido antes da reescrita e só volta a existir depois dela. Se a reescrita for
+    // interrompida, o índice ausente é reconstruído a partir dos registros na próxima abertura.
+    if (file->idOffset >= 0) {
+        StorageFile *freeList = getFreeList(file), *slotIndex = getSlotIndexFile(file);
+        if (freeList == NULL || slotIndex == NULL || !saveFile(NULL, sizeof(int), 0, freeList->filename)) return false;
+        closeWritableFile(slotIndex);
+        remove(slotIndex->filename);
+    }
+
+    closeWritableFile(file);
+    releaseMappedFile(file);
+    file->isStale = true;
+    file->version = ++lastVersion;
+    if (!writeWholeFile(filename, &header, ptr, size, elementsNumber)) return false;
+
+    file->header = header;
+    if (file->idOffset >= 0) {
+        resetSlotIndex(file);
+        if (!indexElements(file, (const char*) ptr, elementsNumber, 0) || !saveSlotIndex(file)) return false;
+    }
+    return true;
+}
+
+/**
+ * Reescreve por completo o índice de posições de um arquivo a partir da associação em memória
+ * 
+ * @param StorageFile *file
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static bool saveSlotIndex(StorageFile *file) {
+    StorageFile *slotIndex = getSlotIndexFile(file);
+    if (slotIndex == NULL) return false;
+
+    int idsNumber = file->header.nextId - 1;
+    int *slots = (int*) malloc(idsNumber > 0 ? idsNumber * sizeof(int) : 1);
+    if (slots == NULL) return false;
+    for (int i = 0; i < idsNumber; i++) slots[i] = getElementSlot(file, i + 1);
+
+    bool status = saveFile(slots, sizeof(int), idsNumber, slotIndex->filename);
+    free(slots);
+
+    return status;
+}
+
+/**
+ * Ler o conteúdo de um arquivo
+ * 
+ * @param void *ptr: Destino da leitura do arquivo
+ * @param const size_t: Tamanho do tipo do conteúdo
+ * @param int elementsNumber: Número de elementos
+ * @param const char *filename: Nome do arquivo
+ * 
+ * @return bool: False se houver alguma falha na leitura do arquivo, true se ler com sucesso
+ */
+bool readFile(void *ptr, const size_t size, int elementsNumber, const char *filename) {
+    StorageFile *file = getStorageFile(filename, size);
+    if (file == NULL || !syncPendingCommits()) return false;
+
+    FILE *fp;
+    fp = fopen(filename, "rb");
+    if (fp == NULL) return false;
+    fseek(fp, sizeof(FileHeader), SEEK_SET);
+    fread(ptr, size, elementsNumber, fp);
+    fclose(fp);
+    return true;
+}
+
+/**
+ * Retorna o número de elementos em um arquivo binário, a partir do cabeçalho em cache.
+ * 
+ * @param const char *filename: Caminho completo do arquivo
+ * @param const size_t structSize: Tamanho da struct armazenada
+ * 
+ * @return int: Número de elementos no arquivo (ativos e excluídos), 0 se o arquivo não existir ou -1 em caso de erro
+ * 
+ * Authors:
+ *  - ChatGPT
+ *  - https://github.com/akemi-adam
+ */
+int getNumberOfElements(const char *filename, const size_t structSize) {
+    StorageFile *file = getStorageFile(filename, structSize);
+    if (file == NULL) return -1;
+
+    return countRecords(file);
+}
+
+/**
+ * Copia o cabeçalho de um arquivo binário
+ * 
+ * @param const char *filename: Caminho completo do arquivo
+ * @param const size_t structSize: Tamanho da struct armazenada
+ * @param FileHeader *header: Destino da cópia
+ * 
+ * @return bool: Retorna false se o layout do arquivo não corresponder à struct
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool getFileHeader(const char *filename, const size_t structSize, FileHeader *header) {
+    StorageFile *file = getStorageFile(filename, structSize);
+    if (file == NULL) return false;
+
+    *header = file->header;
+    return true;
+}
+
+/**
+ * Adiciona uma nova struct a um arquivo binário.
+ * 
+ * Apenas o novo registro e o cabeçalho são escritos. O custo de cada inserção não depende do número de elementos
+ * já cadastrados. Em arquivos com ID estável (abertos com openFile), o registro recebe o próximo ID do cabeçalho e
+ * ocupa a posição de um registro excluído, se houver alguma na lista de posições livres.
+ * 
+ * @param const void *newElement: Ponteiro para a nova struct a ser adicionada
+ * @param const size_t structSize: Tamanho da struct
+ * @param const char *filename: Caminho completo do arquivo
+ * 
+ * @return int: ID atribuído ao registro (ou a sua posição, começando em 1, em arquivos sem ID estável) | 0, se houver
+ * alguma falha
+ * 
+ * Authors:
+ *  - ChatGPT
+ *  - https://github.com/akemi-adam
+ */
+int addElementToFile(const void *newElement, const size_t structSize, const char *filename) {
+    StorageFile *file = getStorageFile(filename, structSize);
+    if (file == NULL) return 0;
+
+    FileHeader header = file->header, freeHeader, indexHeader;
+    StorageFile *freeList = NULL, *slotIndex = NULL;
+    int index = countRecords(file);
+    bool isDeleted = isElementDeleted(file, newElement);
+
+    if (file->idOffset >= 0) {
+        freeList = getFreeList(file);
+        slotIndex = getSlotIndexFile(file);
+        if (freeList == NULL || slotIndex == NULL) return 0;
+        freeHeader = freeList->header;
+        indexHeader = slotIndex->header;
+    }
+
+    bool isReused = freeList != NULL && freeHeader.liveCount > 0 && !isDeleted;
+    if (isReused) {
+        if (!readElementFromFile(&index, sizeof(int), freeHeader.liveCount - 1, freeList->filename)) return 0;
+        if (index < 0 || index >= countRecords(file)) return 0;
+        freeHeader.liveCount--;
+        header.deletedCount--;
+    }
+
+    if (isDeleted) header.deletedCount++;
+    else header.liveCount++;
+    int id = header.nextId++;
+
+    char *element = (char*) malloc(structSize);
+    if (element == NULL) return 0;
+    memcpy(element, newElement, structSize);
+    setElementId(file, element, id);
+
+    bool status = stageWrite(file, recordOffset(file, index), element, structSize) && stageWrite(file, 0, &header, sizeof(FileHeader));
+    if (status && isReused) status = stageWrite(freeList, 0, &freeHeader, sizeof(FileHeader));
+    if (status && slotIndex != NULL) {
+        // A posição do novo ID entra no índice de posições na mesma operação
+        int slot = isDeleted ? -1 : index;
+        if (indexHeader.liveCount < id) indexHeader.liveCount = id;
+        status = stageWrite(slotIndex, recordOffset(slotIndex, id - 1), &slot, sizeof(int)) && stageWrite(slotIndex, 0, &indexHeader, sizeof(FileHeader));
+    }
+    free(element);
+    if (!status) {
+        discardWrites();
+        return 0;
+    }
+    if (!commitWrites()) return 0;
+
+    file->header = header;
+    if (isReused) freeList->header = freeHeader;
+    if (file->idOffset < 0) return index + 1;
+
+    slotIndex->header = indexHeader;
+
+    if (!isDeleted) setElementSlot(file, id, index);
+    return id;
+}
+
+/**
+ * Sobrescreve um único registro de um arquivo binário, a partir da sua posição.
+ * 
+ * Apenas o registro informado (e o cabeçalho, caso a contagem de excluídos mude) é escrito, sem ler ou reescrever o
+ * restante do arquivo. Em arquivos com ID estável, o ID do registro é preservado e a posição de um registro excluído
+ * entra na lista de posições livres; por isso, um registro excluído não pode voltar a ser ativo.
+ * 
+ * @param const void *element: Ponteiro para a struct com os novos dados
+ * @param const size_t structSize: Tamanho da struct
+ * @param int index: Posição do registro no arquivo (começando em 0)
+ * @param const char *filename: Caminho completo do arquivo
+ * 
+ * @return bool: Retorna true se a operação for bem-sucedida, false caso contrário
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool updateElementInFile(const void *element, const size_t structSize, int index, const char *filename) {
+    StorageFile *file = getStorageFile(filename, structSize);
+    if (file == NULL || index < 0 || index >= countRecords(file)) return false;
+
+    char *record = (char*) malloc(structSize);
+    if (record == NULL) return false;
+
+    bool status = true, wasDeleted = false;
+    if (file->deletedOffset >= 0 || file->idOffset >= 0) {
+        status = readStoredData(file, recordOffset(file, index), record, structSize);
+        wasDeleted = status && isElementDeleted(file, record);
+    }
+
+    int id = getElementId(file, record);
+    bool isDeleted = isElementDeleted(file, element);
+    if (file->idOffset >= 0 && wasDeleted && !isDeleted) status = false;
+    if (!status) {
+        free(record);
+        return false;
+    }
+
+    memcpy(record, element, structSize);
+    setElementId(file, record, id);
+
+    FileHeader header = file->header, freeHeader;
+    StorageFile *freeList = NULL;
+    if (isDeleted != wasDeleted) {
+        header.deletedCount += isDeleted ? 1 : -1;
+        header.liveCount += isDeleted ? -1 : 1;
+    }
+
+    status = stageWrite(file, recordOffset(file, index), record, structSize);
+    if (status && isDeleted != wasDeleted) status = stageWrite(file, 0, &header, sizeof(FileHeader));
+    if (status && isDeleted && !wasDeleted && file->idOffset >= 0) {
+        // A posição do registro excluído é empilhada na lista de posições livres, na mesma operação
+        freeList = getFreeList(file);
+        status = freeList != NULL;
+        if (status) {
+            freeHeader = freeList->header;
+            status = stageWrite(freeList, recordOffset(freeList, freeHeader.liveCount), &index, sizeof(int));
+            freeHeader.liveCount++;
+            status = status && stageWrite(freeList, 0, &freeHeader, sizeof(FileHeader));
+        }
+
+        StorageFile *slotIndex = getSlotIndexFile(file);
+        int slot = -1;
+        status = status && slotIndex != NULL;
+        if (status && id > 0 && id <= countRecords(slotIndex)) status = stageWrite(slotIndex, recordOffset(slotIndex, id - 1), &slot, sizeof(int));
+    }
+    free(record);
+    if (!status) {
+        discardWrites();
+        return false;
+    }
+    if (!commitWrites()) return false;
+
+    file->header = header;
+    if (freeList != NULL) {
+        freeList->header = freeHeader;
+        setElementSlot(file, id, -1);
+    }
+    return true;
+}
+
 /**
- * Salva um conteúdo em um arquivo
+ * Lê um único registro de um arquivo binário, a partir da sua posição.
  * 
- * @param const void *ptr: Conteúdo a ser salvo
- * @param const size_t size: Tamanho do tipo do conteúdo
- * @param int elementsNumber: Número de elementos
+ * @param void *element: Destino da leitura
+ * @param const size_t structSize: Tamanho da struct
+ * @param int index: Posição do registro no arquivo (começando em 0)
  * @param const char *filename: Caminho completo do arquivo
  * 
- * @return bool: Retorna false se houver alguma falha ao salvar o arquivo, true se salvar com sucesso
+ * @return bool: Retorna true se o registro existir e for lido com sucesso, false caso contrário
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
  */
-bool saveFile(const void *ptr, const size_t size, int elementsNumber, const char *filename) {
-    FILE *fp = fopen(filename, "wb");
-    if (fp == NULL) return false;
-    // size_t written = fwrite(ptr, size, sizeof(ptr), fp);
-    fwrite(ptr, size, elementsNumber, fp);
-    fclose(fp);
-    return true;
+bool readElementFromFile(void *element, const size_t structSize, int index, const char *filename) {
+    StorageFile *file = getStorageFile(filename, structSize);
+    if (file == NULL || index < 0 || index >= countRecords(file)) return false;
+
+    // Se o arquivo estiver mapeado e não houver escritas pendentes, o registro é copiado direto da memória
+    if (file->isMapped && stagedWritesNumber == 0 && committedWritesNumber == 0) {
+        int count;
+        const char *elements = getMappedElements(filename, structSize, &count);
+        if (index >= count) return false;
+        memcpy(element, elements + (size_t) index * structSize, structSize);
+        return true;
+    }
+
+    return readStoredData(file, recordOffset(file, index), element, structSize);
 }
 
 /**
- * Ler o conteúdo de um arquivo
+ * Lê um único registro ativo de um arquivo binário, a partir do seu ID estável
  * 
- * @param void *ptr: Destino da leitura do arquivo
- * @param const size_t: Tamanho do tipo do conteúdo
- * @param int elementsNumber: Número de elementos
- * @param const char *filename: Nome do arquivo
+ * @param void *element: Destino da leitura
+ * @param const size_t structSize: Tamanho da struct
+ * @param int id: ID do registro
+ * @param const char *filename: Caminho completo do arquivo
  * 
- * @return bool: False se houver alguma falha na leitura do arquivo, true se ler com sucesso
+ * @return bool: Retorna false se não houver um registro ativo com o ID ou se o arquivo não tiver sido aberto com openFile
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
  */
-bool readFile(void *ptr, const size_t size, int elementsNumber, const char *filename) {
-    FILE *fp;
-    fp = fopen(filename, "rb");
-    if (fp == NULL) return false;
-    fread(ptr, size, elementsNumber, fp);
+bool readElementById(void *element, const size_t structSize, int id, const char *filename) {
+    StorageFile *file = getStorageFile(filename, structSize);
+    if (file == NULL || file->idOffset < 0) return false;
+
+    int index = getElementSlot(file, id);
+    return index >= 0 && readElementFromFile(element, structSize, index, filename) && getElementId(file, element) == id;
+}
+
+/**
+ * Sobrescreve um único registro ativo de um arquivo binário, a partir do seu ID estável
+ * 
+ * @param const void *element: Ponteiro para a struct com os novos dados
+ * @param const size_t structSize: Tamanho da struct
+ * @param int id: ID do registro
+ * @param const char *filename: Caminho completo do arquivo
+ * 
+ * @return bool: Retorna false se não houver um registro ativo com o ID ou se houver alguma falha na escrita
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool updateElementById(const void *element, const size_t structSize, int id, const char *filename) {
+    StorageFile *file = getStorageFile(filename, structSize);
+    if (file == NULL || file->idOffset < 0) return false;
+
+    int index = getElementSlot(file, id);
+    return index >= 0 && updateElementInFile(element, structSize, index, filename);
+}
+
+/**
+ * Compacta um arquivo com ID estável, removendo os registros excluídos e esvaziando a lista de posições livres. Os IDs
+ * dos registros ativos não mudam, apenas as suas posições.
+ * 
+ * @param const char *filename: Caminho completo do arquivo
+ * @param const size_t structSize: Tamanho da struct
+ * 
+ * @return int: Número de registros removidos | -1, se houver alguma falha ou se o arquivo não tiver sido aberto com
+ * openFile
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+int compactFile(const char *filename, const size_t structSize) {
+    StorageFile *file = getStorageFile(filename, structSize);
+    if (file == NULL || file->idOffset < 0 || !syncPendingCommits()) return -1;
+
+    int elementsNumber = countRecords(file), liveNumber = 0;
+    char *buffer = (char*) malloc(elementsNumber > 0 ? (size_t) elementsNumber * structSize : 1);
+    if (buffer == NULL) return -1;
+
+    FILE *fp = fopen(filename, "rb");
+    bool status = elementsNumber == 0 || (fp != NULL && fseek(fp, sizeof(FileHeader), SEEK_SET) == 0 && fread(buffer, structSize, elementsNumber, fp) == (size_t) elementsNumber);
+    if (fp != NULL) fclose(fp);
+
+    for (int i = 0; status && i < elementsNumber; i++) {
+        const char *element = buffer + (size_t) i * structSize;
+        if (isElementDeleted(file, element)) continue;
+        if (liveNumber != i) memmove(buffer + (size_t) liveNumber * structSize, element, structSize);
+        liveNumber++;
+    }
+
+    status = status && saveFile(buffer, structSize, liveNumber, filename);
+    free(buffer);
+
+    return status ? elementsNumber - liveNumber : -1;
+}
+
+/**
+ * Desfaz o mapeamento de um arquivo, liberando a memória associada
+ * 
+ * @param StorageFile *file
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static void releaseMappedFile(StorageFile *file) {
+    #ifdef __unix__
+        if (file->isMmap && file->data != NULL) munmap(file->data, file->length);
+    #endif
+    if (!file->isMmap) free(file->data);
+    file->data = NULL;
+    file->length = 0;
+    file->isMmap = false;
+}
+
+/**
+ * Carrega o conteúdo de um arquivo para a memória. Em sistemas UNIX o arquivo é mapeado com mmap (somente leitura e
+ * compartilhado, de modo que as escritas feitas por fwrite ficam visíveis). Nos demais sistemas, ou se o mmap falhar,
+ * o arquivo é copiado para um buffer.
+ * 
+ * @param StorageFile *file
+ * 
+ * @return bool: Retorna false se houver alguma falha ao carregar o arquivo
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ * 
+ * References:
+ *  - https://man7.org/linux/man-pages/man2/mmap.2.html
+ */
+static bool loadMappedFile(StorageFile *file) {
+    #ifdef __unix__
+        struct stat info;
+        if (stat(file->filename, &info) == 0 && file->isMmap && (size_t) info.st_size == file->length) {
+            // Escritas no mesmo tamanho já são refletidas pelo mapeamento compartilhado
+            file->isStale = false;
+            return true;
+        }
+    #endif
+
+    releaseMappedFile(file);
+    file->isStale = false;
+
+    FILE *fp = fopen(file->filename, "rb");
+    if (fp == NULL) return true; // Arquivo inexistente equivale a uma tabela vazia
+
+    fseek(fp, 0, SEEK_END);
+    long fileSize = ftell(fp);
+    if (fileSize <= 0) {
+        fclose(fp);
+        return fileSize == 0;
+    }
+    file->length = (size_t) fileSize;
+
+    #ifdef __unix__
+        void *data = mmap(NULL, file->length, PROT_READ, MAP_SHARED, fileno(fp), 0);
+        if (data != MAP_FAILED) {
+            fclose(fp);
+            file->data = data;
+            file->isMmap = true;
+            return true;
+        }
+    #endif
+
+    file->data = malloc(file->length);
+    if (file->data == NULL) {
+        fclose(fp);
+        file->length = 0;
+        return false;
+    }
+    fseek(fp, 0, SEEK_SET);
+    size_t read = fread(file->data, 1, file->length, fp);
     fclose(fp);
+    file->length = read;
+
     return true;
 }
 
 /**
- * Retorna o número de elementos em um arquivo binário.
+ * Converte um arquivo gravado com um layout antigo da struct para o layout atual, registro a registro, mantendo o
+ * cabeçalho, os IDs e as posições. Arquivos sem cabeçalho são tratados como gravados no layout antigo. Deve ser chamada
+ * antes de openFile; arquivos inexistentes ou que não estejam no layout antigo não são alterados.
  * 
  * @param const char *filename: Caminho completo do arquivo
- * @param const size_t structSize: Tamanho da struct armazenada
+ * @param const size_t oldSize: Tamanho da struct no layout antigo
+ * @param const size_t newSize: Tamanho da struct no layout atual
+ * @param void (*convert)(const void*, void*): Converte um registro do layout antigo para o atual
  * 
- * @return int: Número de elementos no arquivo, 0 se o arquivo não existir ou -1 em caso de erro
+ * @return bool: Retorna false se houver falha na conversão
  * 
  * Authors:
- *  - ChatGPT
+ *  - https://github.com/akemi-adam
  */
-int getNumberOfElements(const char *filename, const size_t structSize) {
+bool migrateFile(const char *filename, const size_t oldSize, const size_t newSize, void (*convert)(const void*, void*)) {
+    // As escritas pendentes no log foram feitas no layout antigo e precisam ser reaplicadas antes da conversão
+    if (!isRecovered && !recoverFromLog()) return false;
+    if (oldSize == newSize || findStorageFile(filename) != NULL) return true;
+
     FILE *fp = fopen(filename, "rb");
-    if (fp == NULL) return 0; // Retorna 0 se o arquivo não existir
+    if (fp == NULL) return true;
 
     fseek(fp, 0, SEEK_END);
     long fileSize = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+
+    FileHeader header;
+    bool hasHeader = fileSize >= (long) sizeof(FileHeader) && fread(&header, sizeof(FileHeader), 1, fp) == 1 && header.magic == STORAGE_MAGIC;
+    long dataOffset = hasHeader ? (long) sizeof(FileHeader) : 0;
+
+    if ((hasHeader && header.recordSize != oldSize) || fileSize <= dataOffset || (fileSize - dataOffset) % (long) oldSize != 0) {
+        fclose(fp);
+        return true;
+    }
+
+    int elementsNumber = (int) ((fileSize - dataOffset) / (long) oldSize);
+    char *oldElements = (char*) malloc((size_t) elementsNumber * oldSize),
+        *newElements = (char*) calloc((size_t) elementsNumber, newSize);
+    bool status = oldElements != NULL && newElements != NULL && fseek(fp, dataOffset, SEEK_SET) == 0
+        && fread(oldElements, oldSize, elementsNumber, fp) == (size_t) elementsNumber;
     fclose(fp);
 
-    if (fileSize < 0) return -1;
+    if (status) {
+        for (int i = 0; i < elementsNumber; i++) convert(oldElements + (size_t) i * oldSize, newElements + (size_t) i * newSize);
+
+        if (!hasHeader) {
+            // Sem cabeçalho, o arquivo é gravado como versão 1, cujos IDs e contadores são recalculados ao abri-lo
+            initHeader(&header, newSize);
+            header.version = 1;
+            header.liveCount = elementsNumber;
+        }
+        header.recordSize = (unsigned int) newSize;
+        status = writeWholeFile(filename, &header, newElements, newSize, elementsNumber);
+    }
+    free(oldElements);
+    free(newElements);
 
-    return fileSize / structSize;
+    return status;
 }
 
 /**
- * Adiciona uma nova struct a um arquivo binário.
+ * Abre um arquivo de dados para a sessão: valida (ou cria) o seu cabeçalho, carrega o índice de posições dos IDs e
+ * mapeia o arquivo em memória até a chamada de closeFiles.
  * 
- * @param const void *newElement: Ponteiro para a nova struct a ser adicionada
- * @param const size_t structSize: Tamanho da struct
  * @param const char *filename: Caminho completo do arquivo
+ * @param const size_t structSize: Tamanho da struct armazenada
+ * @param const size_t idOffset: Posição do campo id dentro da struct, usada para atribuir IDs estáveis
+ * @param const size_t deletedOffset: Posição do campo isDeleted dentro da struct, usada para contar os excluídos
  * 
- * @return bool: Retorna true se a operação for bem-sucedida, false caso contrário
+ * @return bool: Retorna false se o layout do arquivo não corresponder à struct ou se houver falha ao mapeá-lo
  * 
  * Authors:
- *  - ChatGPT
+ *  - https://github.com/akemi-adam
  */
-bool addElementToFile(const void *newElement, const size_t structSize, const char *filename) {
-    int elementCount = getNumberOfElements(filename, structSize);
-    if (elementCount < 0) return false;
+bool openFile(const char *filename, const size_t structSize, const size_t idOffset, const size_t deletedOffset) {
+    // O índice de posições e o mapeamento são lidos diretamente do disco
+    if (!syncPendingCommits()) return false;
 
-    // Alocar memória para os elementos existentes e o novo elemento
-    void *buffer = malloc((elementCount + 1) * structSize);
-    if (buffer == NULL) return false;
+    StorageFile *file = registerStorageFile(filename, structSize, (long) idOffset, (long) deletedOffset);
+    if (file == NULL) return false;
 
-    // Ler os elementos existentes, se houver
-    if (elementCount > 0) {
-        FILE *fp = fopen(filename, "rb");
-        if (fp == NULL) {
-            free(buffer);
-            return false;
-        }
-        fread(buffer, structSize, elementCount, fp);
-        fclose(fp);
+    if (file->idOffset != (long) idOffset || !file->isIndexed) {
+        file->idOffset = (long) idOffset;
+        file->deletedOffset = (long) deletedOffset;
+        if (!loadSlotIndex(file)) return false;
+        file->isIndexed = true;
     }
+    if (file->isMapped) return true;
 
-    // Adicionar o novo elemento ao final
-    memcpy((char *)buffer + (elementCount * structSize), newElement, structSize);
+    if (!loadMappedFile(file)) return false;
+    file->isMapped = true;
 
-    // Salvar todos os elementos de volta no arquivo
-    FILE *fp = fopen(filename, "wb");
-    if (fp == NULL) {
-        free(buffer);
+    return true;
+}
+
+/**
+ * Retorna a versão do conteúdo de um arquivo, que muda a cada escrita aplicada a ele. As versões nunca se repetem
+ * durante a execução, nem entre arquivos diferentes, de modo que dados derivados de um arquivo (como caches) podem ser
+ * reaproveitados enquanto a versão for a mesma.
+ * 
+ * @param const char *filename: Caminho completo do arquivo
+ * @param const size_t structSize: Tamanho da struct armazenada
+ * 
+ * @return unsigned long: Versão do arquivo | 0, se o arquivo não puder ser aberto
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+unsigned long getFileVersion(const char *filename, const size_t structSize) {
+    StorageFile *file = getStorageFile(filename, structSize);
+    return file != NULL ? file->version : 0;
+}
+
+/**
+ * Retorna os registros de um arquivo mapeado, sem cópias. O arquivo é mapeado na primeira chamada, caso ainda não
+ * esteja, e remapeado quando o seu tamanho muda.
+ * 
+ * @param const char *filename: Caminho completo do arquivo
+ * @param const size_t structSize: Tamanho da struct armazenada
+ * @param int *elementsNumber: Número de registros disponíveis
+ * 
+ * @return const void*|NULL: Endereço do primeiro registro | NULL, caso o arquivo esteja vazio ou não possa ser mapeado
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+const void* getMappedElements(const char *filename, const size_t structSize, int *elementsNumber) {
+    *elementsNumber = 0;
+
+    StorageFile *file = getStorageFile(filename, structSize);
+    if (file == NULL || !syncPendingCommits()) return NULL;
+
+    if (!file->isMapped) {
+        if (!loadMappedFile(file)) return NULL;
+        file->isMapped = true;
+    } else if (file->isStale && !loadMappedFile(file)) {
+        return NULL;
+    }
+
+    if (file->length < sizeof(FileHeader)) return NULL;
+
+    int mappedNumber = (int) ((file->length - sizeof(FileHeader)) / file->structSize);
+    *elementsNumber = mappedNumber < countRecords(file) ? mappedNumber : countRecords(file);
+
+    return (const char*) file->data + sizeof(FileHeader);
+}
+
+/**
+ * Relê do disco os cabeçalhos e os índices de posições de todos os arquivos da sessão, desfazendo as alterações feitas
+ * em memória por operações cujas escritas não foram confirmadas
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static void reloadFileStates(void) {
+    // Os cabeçalhos e os índices são relidos do disco, onde precisam estar as operações já confirmadas
+    syncPendingCommits();
+    for (int i = 0; i < storageFilesNumber; i++) {
+        StorageFile *file = &storageFiles[i];
+        loadHeader(file);
+        if (file->isIndexed) loadSlotIndex(file);
+    }
+}
+
+/**
+ * Inicia uma transação: as escritas das operações seguintes ficam preparadas e só são registradas no log, como um
+ * único grupo, em commitTransaction. Transações podem ser aninhadas; apenas a mais externa confirma as escritas.
+ * Reescritas completas (saveFile e compactFile) não são permitidas dentro de uma transação.
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+void beginTransaction(void) {
+    transactionDepth++;
+}
+
+/**
+ * Confirma a transação atual. Se for a transação mais externa, as escritas de todas as operações são registradas no
+ * log e aplicadas aos arquivos de uma só vez: após uma falha, ou todas são recuperadas ou nenhuma.
+ * 
+ * @return bool: Retorna false se não houver transação aberta ou se houver falha ao confirmar as escritas; nesse caso, a
+ * transação é desfeita como em rollbackTransaction
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool commitTransaction(void) {
+    if (transactionDepth == 0) return false;
+    if (--transactionDepth > 0) return true;
+    if (commitWrites()) return true;
+
+    // Com a transação já encerrada, o rollbackTransaction de quem a abriu não tem efeito; por isso, o estado em memória
+    // alterado pelas operações da transação é desfeito aqui
+    reloadFileStates();
+    return false;
+}
+
+/**
+ * Desfaz a transação atual (e as transações que a envolvem), descartando as escritas preparadas e relendo do disco os
+ * cabeçalhos e os índices de posições alterados em memória pelas operações da transação
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+void rollbackTransaction(void) {
+    if (transactionDepth == 0) return;
+
+    transactionDepth = 0;
+    discardWrites();
+    reloadFileStates();
+}
+
+/**
+ * Abre um cursor para percorrer os registros de um arquivo do início ao fim. A memória usada pelo cursor é de um bloco
+ * de CURSOR_CHUNK_SIZE registros, independentemente do tamanho do arquivo.
+ * 
+ * @param Cursor *cursor
+ * @param const char *filename: Caminho completo do arquivo
+ * @param const size_t structSize: Tamanho da struct armazenada
+ * @param bool skipDeleted: Ignora os registros excluídos (apenas em arquivos abertos com openFile)
+ * 
+ * @return bool: Retorna false se o layout do arquivo não corresponder à struct ou se houver falha ao abri-lo
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool openCursor(Cursor *cursor, const char *filename, const size_t structSize, bool skipDeleted) {
+    memset(cursor, 0, sizeof(Cursor));
+    cursor->index = -1;
+
+    StorageFile *file = getStorageFile(filename, structSize);
+    if (file == NULL || !syncPendingCommits()) return false;
+
+    cursor->structSize = structSize;
+    cursor->deletedOffset = skipDeleted ? file->deletedOffset : -1;
+    cursor->remaining = countRecords(file);
+    if (cursor->remaining == 0) return true;
+
+    cursor->buffer = (char*) malloc(structSize * CURSOR_CHUNK_SIZE);
+    cursor->fp = fopen(filename, "rb");
+    if (cursor->buffer == NULL || cursor->fp == NULL || fseek(cursor->fp, sizeof(FileHeader), SEEK_SET) != 0) {
+        closeCursor(cursor);
         return false;
     }
-    fwrite(buffer, structSize, elementCount + 1, fp);
-    fclose(fp);
 
-    free(buffer);
     return true;
-}
\ No newline at end of file
+}
+
+/**
+ * Avança o cursor para o próximo registro, lendo um novo bloco do arquivo quando o atual termina
+ * 
+ * @param Cursor *cursor
+ * 
+ * @return const void*|NULL: Endereço do registro, válido até a próxima chamada | NULL, ao final do arquivo
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+const void* nextElement(Cursor *cursor) {
+    while (true) {
+        if (cursor->position == cursor->bufferedNumber) {
+            if (cursor->fp == NULL || cursor->remaining == 0) return NULL;
+
+            int count = cursor->remaining < CURSOR_CHUNK_SIZE ? cursor->remaining : CURSOR_CHUNK_SIZE;
+            int read = (int) fread(cursor->buffer, cursor->structSize, count, cursor->fp);
+            cursor->remaining = read == count ? cursor->remaining - read : 0;
+            cursor->bufferedNumber = read;
+            cursor->position = 0;
+            if (read == 0) return NULL;
+        }
+
+        const char *element = cursor->buffer + (size_t) cursor->position * cursor->structSize;
+        cursor->position++;
+        cursor->index++;
+
+        if (cursor->deletedOffset < 0 || !*((const bool*) (element + cursor->deletedOffset))) return element;
+    }
+}
+
+/**
+ * Fecha um cursor, liberando o bloco em memória
+ * 
+ * @param Cursor *cursor
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+void closeCursor(Cursor *cursor) {
+    if (cursor->fp != NULL) fclose(cursor->fp);
+    free(cursor->buffer);
+    cursor->fp = NULL;
+    cursor->buffer = NULL;
+    cursor->bufferedNumber = 0;
+    cursor->position = 0;
+    cursor->remaining = 0;
+}
+
+/**
+ * Fecha todos os arquivos abertos na sessão: grava em disco as escritas pendentes, esvazia o log, desfaz os
+ * mapeamentos, fecha os descritores e descarta os cabeçalhos e os índices de IDs em cache
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+void closeFiles(void) {
+    // Uma transação que não foi confirmada até aqui é descartada
+    rollbackTransaction();
+    bool isCheckpointed = checkpointFiles();
+    for (int i = 0; i < storageFilesNumber; i++) {
+        releaseMappedFile(&storageFiles[i]);
+        closeWritableFile(&storageFiles[i]);
+        resetSlotIndex(&storageFiles[i]);
+    }
+    storageFilesNumber = 0;
+
+    // Após o checkpoint o log não guarda nada que ainda precise ser reaplicado
+    if (logFile != NULL) {
+        fclose(logFile);
+        if (isCheckpointed) remove(STORAGE_LOG_FILE);
+    }
+    logFile = NULL;
+    isRecovered = false;
+}
+
+/**
+ * Define quando as escritas são gravadas em disco. O modo vale para todas as operações de escrita: o log das inserções
+ * e atualizações e a reescrita completa feita por saveFile.
+ * 
+ * @param DurabilityMode mode: DURABILITY_SYNC grava em disco a cada operação; DURABILITY_GROUP agrupa várias operações
+ * em um único fsync; DURABILITY_NONE deixa a gravação a cargo do sistema operacional, que pode perder as últimas
+ * operações em caso de queda de energia
+ * @param int interval: No modo de grupo, tempo máximo em milissegundos que uma operação espera pelo fsync
+ * @param int size: No modo de grupo, número máximo de operações por fsync
+ * 
+ * @return bool: Retorna false se as operações pendentes não puderem ser gravadas em disco
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool setDurabilityMode(DurabilityMode mode, int interval, int size) {
+    // As operações do grupo pendente são gravadas antes da troca, para não ficarem presas no modo anterior
+    bool status = syncLog(true);
+
+    durabilityMode = mode;
+    groupCommitInterval = interval > 0 ? interval : DEFAULT_GROUP_COMMIT_INTERVAL;
+    groupCommitSize = size > 0 ? size : DEFAULT_GROUP_COMMIT_SIZE;
+
+    return status;
+}
+
+/**
+ * Retorna o modo de durabilidade atual
+ * 
+ * @return DurabilityMode
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+DurabilityMode getDurabilityMode(void) {
+    return durabilityMode;
+}
+
+/**
+ * Configura o modo de durabilidade a partir de um texto no formato "none", "sync" ou "group[:intervalo[:operações]]",
+ * como em "group:20:256". Um texto nulo ou vazio mantém o modo atual.
+ * 
+ * @param const char *config
+ * 
+ * @return bool: Retorna false se o texto não estiver em um formato válido
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool configureDurability(const char *config) {
+    if (config == NULL || *config == '\0') return true;
+
+    if (strcmp(config, "none") == 0) return setDurabilityMode(DURABILITY_NONE, 0, 0);
+    if (strcmp(config, "sync") == 0) return setDurabilityMode(DURABILITY_SYNC, 0, 0);
+    if (strncmp(config, "group", 5) != 0 || (config[5] != '\0' && config[5] != ':')) return false;
+
+    int interval = 0, size = 0;
+    if (config[5] == ':' && sscanf(config + 6, "%d:%d", &interval, &size) < 1) return false;
+
+    return setDurabilityMode(DURABILITY_GROUP, interval, size);
+}
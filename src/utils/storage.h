@@ -1,15 +1,109 @@
 #ifndef STORAGE
 #define STORAGE
 
+#include <stdio.h>
 #include <stdbool.h>
 #include <stdlib.h>
 
+#define MAX_STORAGE_FILES 32
+#define STORAGE_MAGIC 0x57414C53
+#define STORAGE_VERSION 2
+#define STORAGE_FREE_LIST_SUFFIX ".free"
+#define STORAGE_SLOT_INDEX_SUFFIX ".idx"
+#define STORAGE_LOG_FILE "siglaw.wal"
+#define STORAGE_CHECKPOINT_SIZE (4L * 1024 * 1024)
+#define DEFAULT_GROUP_COMMIT_INTERVAL 10
+#define DEFAULT_GROUP_COMMIT_SIZE 64
+#define LOG_ENTRY_MAGIC 0x474F4C57
+#define LOG_WRITE 1
+#define LOG_COMMIT 2
+#define CURSOR_CHUNK_SIZE 256
+
+/**
+ * Modos de gravação em disco das escritas
+ */
+typedef enum DurabilityMode {
+    DURABILITY_NONE,
+    DURABILITY_SYNC,
+    DURABILITY_GROUP
+} DurabilityMode;
+
+/**
+ * Cabeçalho gravado no início de cada arquivo de dados
+ */
+typedef struct FileHeader {
+    unsigned int magic;
+    unsigned int version;
+    unsigned int recordSize;
+    int liveCount;
+    int deletedCount;
+    int nextId;
+} FileHeader;
+
+/**
+ * Percorre os registros de um arquivo em blocos de tamanho fixo, mantendo em memória apenas um bloco por vez
+ */
+typedef struct Cursor {
+    FILE *fp;
+    size_t structSize;
+    long deletedOffset;
+    char *buffer;
+    int bufferedNumber;
+    int position;
+    int remaining;
+    int index;
+} Cursor;
+
 bool saveFile(const void*, const size_t, int, const char*);
 
 bool readFile(void*, const size_t, int, const char*);
 
 int getNumberOfElements(const char*, const size_t);
 
-bool addElementToFile(const void*, const size_t, const char*);
+int addElementToFile(const void*, const size_t, const char*);
+
+bool updateElementInFile(const void*, const size_t, int, const char*);
+
+bool readElementFromFile(void*, const size_t, int, const char*);
+
+bool getFileHeader(const char*, const size_t, FileHeader*);
+
+bool readElementById(void*, const size_t, int, const char*);
+
+bool updateElementById(const void*, const size_t, int, const char*);
+
+int compactFile(const char*, const size_t);
+
+bool openFile(const char*, const size_t, const size_t, const size_t);
+
+bool migrateFile(const char*, const size_t, const size_t, void (*)(const void*, void*));
+
+const void* getMappedElements(const char*, const size_t, int*);
+
+unsigned long getFileVersion(const char*, const size_t);
+
+bool checkpointFiles(void);
+
+bool syncPendingCommits(void);
+
+void closeFiles(void);
+
+void beginTransaction(void);
+
+bool commitTransaction(void);
+
+void rollbackTransaction(void);
+
+bool openCursor(Cursor*, const char*, const size_t, bool);
+
+const void* nextElement(Cursor*);
+
+void closeCursor(Cursor*);
+
+bool setDurabilityMode(DurabilityMode, int, int);
+
+DurabilityMode getDurabilityMode(void);
+
+bool configureDurability(const char*);
 
 #endif
\ No newline at end of file
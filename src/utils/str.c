@@ -79,6 +79,41 @@ int countAccents(const char* str) {
     return count;
 }
 
+/**
+ * Normaliza um texto para buscas: letras minúsculas e sem acento, números mantidos e qualquer outro caractere
+ * convertido em um único espaço entre as palavras. As letras acentuadas (caracteres UTF-8 de 2 bytes iniciados em
+ * 0xC3, os mesmos contados por countAccents) são trocadas pela letra sem acento.
+ * 
+ * @param const char *text
+ * @param char *folded: Destino do texto normalizado
+ * @param int size: Tamanho do destino
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+void foldText(const char *text, char *folded, int size) {
+    // Letra sem acento de cada caractere de U+00C0 a U+00FF, com espaço nos que não são letras
+    const char accentless[] = "aaaaaaaceeeeiiiidnooooo ouuuuy saaaaaaaceeeeiiiidnooooo ouuuuy y";
+    int length = 0;
+
+    for (size_t i = 0; text[i] != '\0' && length < size - 1; i++) {
+        unsigned char byte = (unsigned char) text[i], next = (unsigned char) text[i + 1];
+        char c = ' ';
+
+        // Os bytes de continuação dos caracteres UTF-8 não geram outro caractere
+        if (!isStartOfUtf8Char(byte)) continue;
+        if (byte >= 'A' && byte <= 'Z') c = (char) (byte - 'A' + 'a');
+        else if ((byte >= 'a' && byte <= 'z') || (byte >= '0' && byte <= '9')) c = (char) byte;
+        else if (byte == 0xC3 && next >= 0x80 && next <= 0xBF) c = accentless[next - 0x80];
+
+        if (c == ' ' && (length == 0 || folded[length - 1] == ' ')) continue;
+        folded[length++] = c;
+    }
+    if (length > 0 && folded[length - 1] == ' ') length--;
+    folded[length] = '\0';
+}
 
 /**
  * Converte uma String para int
@@ -6,6 +6,7 @@
 bool isAccentedChar(const char);
 bool isStartOfUtf8Char(unsigned char);
 int countAccents(const char*);
+void foldText(const char*, char*, int);
 bool parseInt(const char*, int*);
 bool parseDouble(const char*, double*);
 bool hasInvalidSpaces(const char*);
@@ -0,0 +1,255 @@
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdlib.h>
+#include "./storage.h"
+#include "./str.h"
+#include "./bptree.h"
+#include "./textindex.h"
+
+/**
+ * Estado de uma busca no índice: a tabela consultada, as palavras da consulta e os registros já confirmados
+ */
+typedef struct TokenSearch {
+    const char *table;
+    size_t structSize;
+    size_t textOffset;
+    char **tokens;
+    int tokensNumber;
+    char *element;
+    int *ids;
+    int idsNumber;
+    int maxIds;
+    bool isTruncated;
+} TokenSearch;
+
+/**
+ * Normaliza um texto e o divide em palavras, sem repetições. As palavras apontam para dentro de folded.
+ * 
+ * @param const char *text
+ * @param char *folded: Destino do texto normalizado, com TEXTINDEX_TEXT_SIZE posições
+ * @param char **tokens: Destino das palavras, com espaço para TEXTINDEX_MAX_KEYS palavras
+ * 
+ * @return int: Número de palavras
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static int getTokens(const char *text, char *folded, char **tokens) {
+    int tokensNumber = 0;
+    foldText(text, folded, TEXTINDEX_TEXT_SIZE);
+
+    // O texto normalizado tem um único espaço entre as palavras e nenhum nas pontas
+    for (char *token = folded; *token != '\0' && tokensNumber < TEXTINDEX_MAX_KEYS;) {
+        char *end = strchr(token, ' ');
+        if (end != NULL) *end = '\0';
+
+        bool isRepeated = false;
+        for (int i = 0; i < tokensNumber && !isRepeated; i++) isRepeated = strcmp(tokens[i], token) == 0;
+        if (!isRepeated) tokens[tokensNumber++] = token;
+
+        if (end == NULL) break;
+        token = end + 1;
+    }
+
+    return tokensNumber;
+}
+
+/**
+ * Calcula o hash FNV-1a de uma palavra, usado como grupo das suas chaves no índice
+ * 
+ * @param const char *token
+ * 
+ * @return int
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ * 
+ * References:
+ *  - http://www.isthe.com/chongo/tech/comp/fnv/index.html
+ */
+static int hashToken(const char *token) {
+    unsigned int hash = 2166136261u;
+    for (const unsigned char *c = (const unsigned char*) token; *c != '\0'; c++) {
+        hash ^= *c;
+        hash *= 16777619u;
+    }
+
+    return (int) (hash & 0x7FFFFFFF);
+}
+
+/**
+ * Compara dois hashes, para o qsort
+ * 
+ * @param const void *a
+ * @param const void *b
+ * 
+ * @return int
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static int compareHashes(const void *a, const void *b) {
+    int first = *(const int*) a, second = *(const int*) b;
+    return (first > second) - (first < second);
+}
+
+/**
+ * Calcula, sem repetições e em ordem, os hashes das palavras de um texto. Palavras diferentes com o mesmo hash geram
+ * um único hash.
+ * 
+ * @param char **tokens
+ * @param int tokensNumber
+ * @param int *hashes: Destino dos hashes, com espaço para tokensNumber hashes
+ * 
+ * @return int: Número de hashes
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static int getTokenHashes(char **tokens, int tokensNumber, int *hashes) {
+    for (int i = 0; i < tokensNumber; i++) hashes[i] = hashToken(tokens[i]);
+    if (tokensNumber > 1) qsort(hashes, tokensNumber, sizeof(int), compareHashes);
+
+    int distinct = 0;
+    for (int i = 0; i < tokensNumber; i++) {
+        if (distinct == 0 || hashes[distinct - 1] != hashes[i]) hashes[distinct++] = hashes[i];
+    }
+
+    return distinct;
+}
+
+/**
+ * Monta as chaves de um texto em um índice invertido: o hash de cada palavra, 0 e o ID do registro. As chaves de uma
+ * palavra ficam juntas e ordenadas pelo ID, formando a lista de registros que a contêm.
+ * 
+ * @param const char *text
+ * @param int id: ID do registro
+ * @param BPlusKey *keys: Destino das chaves, com espaço para TEXTINDEX_MAX_KEYS chaves
+ * 
+ * @return int: Número de chaves
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+int getTokenKeys(const char *text, int id, BPlusKey *keys) {
+    char folded[TEXTINDEX_TEXT_SIZE], *tokens[TEXTINDEX_MAX_KEYS];
+    int hashes[TEXTINDEX_MAX_KEYS];
+
+    int hashesNumber = getTokenHashes(tokens, getTokens(text, folded, tokens), hashes);
+    for (int i = 0; i < hashesNumber; i++) {
+        keys[i].group = hashes[i];
+        keys[i].value = 0;
+        keys[i].id = id;
+    }
+
+    return hashesNumber;
+}
+
+/**
+ * Insere no índice as palavras do texto de um registro novo, em uma única transação
+ * 
+ * @param const char *filename: Caminho completo do índice
+ * @param const char *text
+ * @param int id: ID do registro
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool insertTokens(const char *filename, const char *text, int id) {
+    return replaceTextKeys(filename, NULL, text, id, false, getTokenKeys, TEXTINDEX_MAX_KEYS);
+}
+
+/**
+ * Substitui as palavras de um registro no índice, caso o texto tenha mudado ou o registro tenha sido excluído
+ * 
+ * @param const char *filename: Caminho completo do índice
+ * @param const char *currentText: Texto atual
+ * @param const char *newText: Novo texto
+ * @param int id: ID do registro
+ * @param bool isDeleted: Indica se o registro foi excluído
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool replaceTokens(const char *filename, const char *currentText, const char *newText, int id, bool isDeleted) {
+    return replaceTextKeys(filename, currentText, newText, id, isDeleted, getTokenKeys, TEXTINDEX_MAX_KEYS);
+}
+
+/**
+ * Lê um registro presente nas listas de todas as palavras da consulta e o guarda entre os resultados se o seu texto
+ * tiver todas elas, descartando os registros que só aparecem nas listas por colisões de hash. Com o número máximo de
+ * resultados já atingido, o próximo registro confirmado apenas indica que havia mais resultados.
+ * 
+ * @param int id: ID do registro
+ * @param void *context: TokenSearch*
+ * 
+ * @return bool: Retorna false quando um registro é confirmado além do número máximo de resultados
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static bool checkTokenCandidate(int id, void *context) {
+    TokenSearch *search = (TokenSearch*) context;
+    char folded[TEXTINDEX_TEXT_SIZE], *tokens[TEXTINDEX_MAX_KEYS];
+
+    if (!readElementById(search->element, search->structSize, id, search->table)) return true;
+    int tokensNumber = getTokens(search->element + search->textOffset, folded, tokens);
+
+    bool hasAllTokens = true;
+    for (int i = 0; i < search->tokensNumber && hasAllTokens; i++) {
+        hasAllTokens = false;
+        for (int j = 0; j < tokensNumber && !hasAllTokens; j++) hasAllTokens = strcmp(search->tokens[i], tokens[j]) == 0;
+    }
+    if (!hasAllTokens) return true;
+    if (search->idsNumber == search->maxIds) {
+        search->isTruncated = true;
+        return false;
+    }
+
+    search->ids[search->idsNumber++] = id;
+    return true;
+}
+
+/**
+ * Procura os registros cujo texto tem todas as palavras da consulta, em qualquer ordem, ignorando acentos, maiúsculas
+ * e pontuação. As listas das palavras da consulta são intersectadas com intersectBPlusGroups, e cada registro em
+ * comum é lido para confirmar que tem as palavras. Os resultados vêm em ordem de ID.
+ * 
+ * @param const char *filename: Caminho completo do índice
+ * @param const char *table: Caminho completo da tabela
+ * @param const size_t structSize: Tamanho da struct da tabela
+ * @param const size_t textOffset: Posição do texto indexado dentro da struct
+ * @param const char *query
+ * @param int *ids: Destino dos IDs encontrados
+ * @param int maxIds: Número máximo de IDs
+ * @param bool *isTruncated: Indica se havia mais registros com todas as palavras do que maxIds (opcional)
+ * 
+ * @return int: Número de IDs encontrados | -1, se a consulta não tiver palavras ou se houver alguma falha
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+int searchTokenIndex(const char *filename, const char *table, const size_t structSize, const size_t textOffset, const char *query, int *ids, int maxIds, bool *isTruncated) {
+    char folded[TEXTINDEX_TEXT_SIZE], *tokens[TEXTINDEX_MAX_KEYS];
+    int hashes[TEXTINDEX_MAX_KEYS];
+
+    if (isTruncated != NULL) *isTruncated = false;
+    int tokensNumber = getTokens(query, folded, tokens);
+    if (tokensNumber == 0) return -1;
+    if (maxIds <= 0) return 0;
+
+    int hashesNumber = getTokenHashes(tokens, tokensNumber, hashes);
+    TokenSearch search = {table, structSize, textOffset, tokens, tokensNumber, (char*) malloc(structSize), ids, 0, maxIds, false};
+    if (search.element == NULL) return -1;
+
+    bool status = intersectBPlusGroups(filename, hashes, hashesNumber, checkTokenCandidate, &search);
+    free(search.element);
+    if (isTruncated != NULL) *isTruncated = search.isTruncated;
+
+    return status ? search.idsNumber : -1;
+}
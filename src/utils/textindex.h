@@ -0,0 +1,19 @@
+#ifndef TEXTINDEX
+#define TEXTINDEX
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include "./bptree.h"
+
+#define TEXTINDEX_TEXT_SIZE 128
+#define TEXTINDEX_MAX_KEYS (TEXTINDEX_TEXT_SIZE / 2)
+
+int getTokenKeys(const char*, int, BPlusKey*);
+
+bool insertTokens(const char*, const char*, int);
+
+bool replaceTokens(const char*, const char*, const char*, int, bool);
+
+int searchTokenIndex(const char*, const char*, const size_t, const size_t, const char*, int*, int, bool*);
+
+#endif
@@ -0,0 +1,334 @@
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdlib.h>
+#include "./storage.h"
+#include "./str.h"
+#include "./bptree.h"
+#include "./trigram.h"
+
+#define TRIGRAM_ALPHABET 37
+
+/**
+ * Texto encontrado em uma busca, com a sua posição no ranking
+ */
+typedef struct TrigramMatch {
+    int id;
+    int rank;
+    char text[TRIGRAM_TEXT_SIZE];
+} TrigramMatch;
+
+/**
+ * Estado de uma busca no índice: a tabela consultada, a consulta normalizada (também precedida de um espaço), a
+ * passagem atual e os melhores textos já confirmados, em ordem
+ */
+typedef struct TrigramSearch {
+    const char *table;
+    size_t structSize;
+    size_t textOffset;
+    const char *query;
+    const char *wordQuery;
+    bool isMidWordPass;
+    char *element;
+    TrigramMatch candidate;
+    TrigramMatch *matches;
+    int matchesNumber;
+    int maxMatches;
+    int candidatesNumber;
+    bool isTruncated;
+} TrigramSearch;
+
+/**
+ * Retorna o código de um caractere de um texto normalizado: 0 para o espaço, de 1 a 26 para as letras e de 27 a 36
+ * para os números
+ * 
+ * @param char c
+ * 
+ * @return int
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static int getCharCode(char c) {
+    if (c >= 'a' && c <= 'z') return c - 'a' + 1;
+    if (c >= '0' && c <= '9') return c - '0' + 27;
+    return 0;
+}
+
+/**
+ * Compara dois trigramas, para o qsort
+ * 
+ * @param const void *a
+ * @param const void *b
+ * 
+ * @return int
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static int compareTrigrams(const void *a, const void *b) {
+    int first = *(const int*) a, second = *(const int*) b;
+    return (first > second) - (first < second);
+}
+
+/**
+ * Calcula, sem repetições e em ordem, os trigramas (sequências de 3 caracteres) de um texto já normalizado
+ * 
+ * @param const char *text
+ * @param int *trigrams: Destino dos trigramas, com espaço para strlen(text) códigos
+ * 
+ * @return int: Número de trigramas
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static int getTrigrams(const char *text, int *trigrams) {
+    int length = (int) strlen(text), trigramsNumber = 0;
+
+    for (int i = 0; i + 2 < length; i++) {
+        trigrams[trigramsNumber++] = (getCharCode(text[i]) * TRIGRAM_ALPHABET + getCharCode(text[i + 1])) * TRIGRAM_ALPHABET
+            + getCharCode(text[i + 2]);
+    }
+    if (trigramsNumber > 1) qsort(trigrams, trigramsNumber, sizeof(int), compareTrigrams);
+
+    int distinct = 0;
+    for (int i = 0; i < trigramsNumber; i++) {
+        if (distinct == 0 || trigrams[distinct - 1] != trigrams[i]) trigrams[distinct++] = trigrams[i];
+    }
+
+    return distinct;
+}
+
+/**
+ * Normaliza um texto e coloca um espaço antes dele, para que o início do texto também forme um trigrama de início de
+ * palavra
+ * 
+ * @param const char *text
+ * @param char *padded: Destino, com TRIGRAM_TEXT_SIZE posições
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static void padText(const char *text, char *padded) {
+    padded[0] = ' ';
+    foldText(text, padded + 1, TRIGRAM_TEXT_SIZE - 1);
+}
+
+/**
+ * Monta as chaves de um texto em um índice de trigramas: o trigrama, 0 e o ID do registro. As chaves de um trigrama
+ * ficam juntas e ordenadas pelo ID, formando a lista de registros que o contêm.
+ * 
+ * @param const char *text
+ * @param int id: ID do registro
+ * @param BPlusKey *keys: Destino das chaves, com espaço para TRIGRAM_MAX_KEYS chaves
+ * 
+ * @return int: Número de chaves
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+int getTrigramKeys(const char *text, int id, BPlusKey *keys) {
+    char padded[TRIGRAM_TEXT_SIZE];
+    int trigrams[TRIGRAM_MAX_KEYS];
+
+    padText(text, padded);
+    int trigramsNumber = getTrigrams(padded, trigrams);
+    for (int i = 0; i < trigramsNumber; i++) {
+        keys[i].group = trigrams[i];
+        keys[i].value = 0;
+        keys[i].id = id;
+    }
+
+    return trigramsNumber;
+}
+
+/**
+ * Insere no índice os trigramas do texto de um registro novo, em uma única transação
+ * 
+ * @param const char *filename: Caminho completo do índice
+ * @param const char *text
+ * @param int id: ID do registro
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool insertTrigrams(const char *filename, const char *text, int id) {
+    return replaceTextKeys(filename, NULL, text, id, false, getTrigramKeys, TRIGRAM_MAX_KEYS);
+}
+
+/**
+ * Substitui os trigramas de um registro no índice, caso o texto tenha mudado ou o registro tenha sido excluído
+ * 
+ * @param const char *filename: Caminho completo do índice
+ * @param const char *currentText: Texto atual
+ * @param const char *newText: Novo texto
+ * @param int id: ID do registro
+ * @param bool isDeleted: Indica se o registro foi excluído
+ * 
+ * @return bool
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+bool replaceTrigrams(const char *filename, const char *currentText, const char *newText, int id, bool isDeleted) {
+    return replaceTextKeys(filename, currentText, newText, id, isDeleted, getTrigramKeys, TRIGRAM_MAX_KEYS);
+}
+
+/**
+ * Compara duas ocorrências pelo ranking, pelo texto e pelo ID, para o qsort
+ * 
+ * @param const void *a
+ * @param const void *b
+ * 
+ * @return int
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static int compareMatches(const void *a, const void *b) {
+    const TrigramMatch *first = (const TrigramMatch*) a, *second = (const TrigramMatch*) b;
+    if (first->rank != second->rank) return first->rank - second->rank;
+
+    int comparison = strcmp(first->text, second->text);
+    if (comparison != 0) return comparison;
+    return (first->id > second->id) - (first->id < second->id);
+}
+
+/**
+ * Guarda o candidato entre os melhores resultados, mantidos em ordem e limitados a maxMatches. Quando a lista está
+ * cheia, o candidato só entra se vier antes do último, que é descartado.
+ * 
+ * @param TrigramSearch *search
+ * 
+ * @return void
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static void keepBestMatch(TrigramSearch *search) {
+    int position = search->matchesNumber;
+    if (position == search->maxMatches) {
+        if (compareMatches(&search->candidate, &search->matches[position - 1]) >= 0) return;
+        position--;
+    } else {
+        search->matchesNumber++;
+    }
+
+    while (position > 0 && compareMatches(&search->candidate, &search->matches[position - 1]) < 0) {
+        search->matches[position] = search->matches[position - 1];
+        position--;
+    }
+    search->matches[position] = search->candidate;
+}
+
+/**
+ * Lê um registro presente nas listas de todos os trigramas da consulta e o guarda entre os melhores resultados se o seu
+ * texto contiver a consulta com um ranking da passagem atual: no início de uma palavra (0 ou 1) ou no meio (2)
+ * 
+ * @param int id: ID do registro
+ * @param void *context: TrigramSearch*
+ * 
+ * @return bool: Retorna false quando TRIGRAM_MAX_CANDIDATES registros já foram lidos, marcando a busca como truncada
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+static bool checkTrigramCandidate(int id, void *context) {
+    TrigramSearch *search = (TrigramSearch*) context;
+    TrigramMatch *candidate = &search->candidate;
+
+    if (search->candidatesNumber == TRIGRAM_MAX_CANDIDATES) {
+        search->isTruncated = true;
+        return false;
+    }
+    search->candidatesNumber++;
+    if (!readElementById(search->element, search->structSize, id, search->table)) return true;
+
+    foldText(search->element + search->textOffset, candidate->text, TRIGRAM_TEXT_SIZE);
+    if (strncmp(candidate->text, search->query, strlen(search->query)) == 0) candidate->rank = 0;
+    else if (strstr(candidate->text, search->wordQuery) != NULL) candidate->rank = 1;
+    else if (strstr(candidate->text, search->query) != NULL) candidate->rank = 2;
+    else return true;
+
+    candidate->id = id;
+    if ((candidate->rank == 2) == search->isMidWordPass) keepBestMatch(search);
+
+    return true;
+}
+
+/**
+ * Procura os registros cujo texto contém a consulta, ignorando acentos, maiúsculas e pontuação. Nos resultados vêm
+ * primeiro os textos que começam com a consulta, depois os que têm uma palavra que começa com ela e, por fim, os demais,
+ * em ordem alfabética. Consultas de 2 caracteres encontram apenas palavras que começam com eles.
+ * 
+ * A busca é feita em duas passagens, intersectando as listas de trigramas com intersectBPlusGroups e lendo cada
+ * registro em comum para confirmar o ranking. A primeira usa os trigramas da consulta precedida de um espaço, que só
+ * aparecem nos inícios de palavra; a segunda, feita apenas se a primeira não preencher os resultados, procura a
+ * consulta no meio das palavras. Apenas os maxIds melhores resultados ficam em memória, de modo que o ranking considera
+ * todos os registros lidos, e não só os primeiros IDs.
+ * 
+ * Para manter o tempo de resposta em tabelas grandes, no máximo TRIGRAM_MAX_CANDIDATES registros são lidos. Se a busca
+ * parar antes de ler todos, isTruncated indica que os resultados podem não ser os melhores.
+ * 
+ * @param const char *filename: Caminho completo do índice
+ * @param const char *table: Caminho completo da tabela
+ * @param const size_t structSize: Tamanho da struct da tabela
+ * @param const size_t textOffset: Posição do texto indexado dentro da struct
+ * @param const char *query
+ * @param int *ids: Destino dos IDs encontrados
+ * @param int maxIds: Número máximo de IDs
+ * @param bool *isTruncated: Indica se a busca parou antes de ler todos os registros (opcional)
+ * 
+ * @return int: Número de IDs encontrados | -1, se a consulta tiver menos de TRIGRAM_MIN_QUERY caracteres ou se não
+ * houver memória disponível
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+int searchTrigramIndex(const char *filename, const char *table, const size_t structSize, const size_t textOffset, const char *query, int *ids, int maxIds, bool *isTruncated) {
+    char folded[TRIGRAM_TEXT_SIZE], padded[TRIGRAM_TEXT_SIZE];
+    int trigrams[TRIGRAM_MAX_KEYS], trigramsNumber;
+
+    if (isTruncated != NULL) *isTruncated = false;
+    padText(query, padded);
+    strcpy(folded, padded + 1);
+    int length = (int) strlen(folded);
+    if (length < TRIGRAM_MIN_QUERY) return -1;
+    if (maxIds <= 0) return 0;
+
+    TrigramSearch search;
+    memset(&search, 0, sizeof(TrigramSearch));
+    search.table = table;
+    search.structSize = structSize;
+    search.textOffset = textOffset;
+    search.query = folded;
+    search.wordQuery = padded;
+    search.maxMatches = maxIds;
+    search.element = (char*) malloc(structSize);
+    search.matches = (TrigramMatch*) malloc(maxIds * sizeof(TrigramMatch));
+    if (search.element == NULL || search.matches == NULL) {
+        free(search.element);
+        free(search.matches);
+        return -1;
+    }
+
+    // Inícios de palavra (rankings 0 e 1), que vêm antes de qualquer ocorrência no meio de uma palavra
+    trigramsNumber = getTrigrams(padded, trigrams);
+    intersectBPlusGroups(filename, trigrams, trigramsNumber, checkTrigramCandidate, &search);
+    if (length >= 3 && search.matchesNumber < maxIds && !search.isTruncated) {
+        search.isMidWordPass = true;
+        trigramsNumber = getTrigrams(folded, trigrams);
+        intersectBPlusGroups(filename, trigrams, trigramsNumber, checkTrigramCandidate, &search);
+    }
+    free(search.element);
+
+    for (int i = 0; i < search.matchesNumber; i++) ids[i] = search.matches[i].id;
+    free(search.matches);
+    if (isTruncated != NULL) *isTruncated = search.isTruncated;
+
+    return search.matchesNumber;
+}
@@ -0,0 +1,21 @@
+#ifndef TRIGRAM
+#define TRIGRAM
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include "./bptree.h"
+
+#define TRIGRAM_TEXT_SIZE 128
+#define TRIGRAM_MAX_KEYS TRIGRAM_TEXT_SIZE
+#define TRIGRAM_MIN_QUERY 2
+#define TRIGRAM_MAX_CANDIDATES 200000
+
+int getTrigramKeys(const char*, int, BPlusKey*);
+
+bool insertTrigrams(const char*, const char*, int);
+
+bool replaceTrigrams(const char*, const char*, const char*, int, bool);
+
+int searchTrigramIndex(const char*, const char*, const size_t, const size_t, const char*, int*, int, bool*);
+
+#endif
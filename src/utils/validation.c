@@ -4,6 +4,8 @@
 #include <stdbool.h>
 #include "./str.h"
 #include "./validation.h"
+#include "./date.h"
+#include "./calendar.h"
 
 /**
  * Verifica se a string conter apenas caracteres alpha
@@ -243,7 +245,7 @@ bool isCna(const char *cna) {
  *  - ChatGPT
  */
 bool isLeapYear(int year) {
-    return (year % 4 == 0 && year % 100 != 0) || (year % 400 == 0);
+    return getDaysInMonth(2, year) == 29;
 }
 
 /**
@@ -258,13 +260,8 @@ bool isLeapYear(int year) {
  *  - ChatGPT
  */
 int maxDaysInMonth(int month, int year) {
-    int daysInMonth[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
-
-    if (month == 2 && isLeapYear(year)) return 29;
-
-    return month >= 1 && month <= 12
-        ? daysInMonth[month - 1]
-        : 0;
+    // A tabela de dias de cada mês fica apenas em calendar.c
+    return getDaysInMonth(month, year);
 }
 
 /**
@@ -322,21 +319,8 @@ bool isYear(int year) {
  *  - ChatGPT
  */
 bool isDate(const char *dateStr) {
-    int day, month, year;
-    char dayStr[3], monthStr[3], yearStr[5];
-
-    if (strlen(dateStr) != 10 || dateStr[2] != '/' || dateStr[5] != '/') return false;
-
-    strncpy(dayStr, dateStr, 2);
-    dayStr[2] = '\0';
-    strncpy(monthStr, dateStr + 3, 2);
-    monthStr[2] = '\0';
-    strncpy(yearStr, dateStr + 6, 4);
-    yearStr[4] = '\0';
-
-    if (!parseInt(dayStr, &day) || !parseInt(monthStr, &month) || !parseInt(yearStr, &year)) return false;
-
-    return isDay(day, month, year) && isMonth(month) && isYear(year);
+    Datetime datetime;
+    return parseDate(dateStr, &datetime);
 }
 
 /**
@@ -350,16 +334,8 @@ bool isDate(const char *dateStr) {
  *  - ChatGPT
  */
 bool isHour(const char *time) {
-    if (time == NULL || time[2] != ':' || time[5] != '\0') return false;
-
-    if (!isdigit(time[0]) || !isdigit(time[1]) || !isdigit(time[3]) || !isdigit(time[4])) return false;
-
-    int hours = (time[0] - '0') * 10 + (time[1] - '0');
-    int minutes = (time[3] - '0') * 10 + (time[4] - '0');
-
-    if (hours < 0 || hours > 23 || minutes < 0 || minutes > 59) return false;
-
-    return true;
+    Datetime datetime;
+    return parseTime(time, &datetime);
 }
 
 /**
@@ -0,0 +1,141 @@
+#include "./../../unity/unity.h"
+#include "./../../unity/unity_internals.h"
+#include "./../../src/utils/storage.h"
+#include "./../../src/modules/appointment/appointment.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#ifdef __unix__
+    #include <unistd.h>
+    #include <sys/stat.h>
+#endif
+
+#define TEST_DIRECTORY "test_appointment_data"
+#define START 28000000
+
+static const char *TABLE_FILES[] = {
+    "appointments.dat", "appointments.dat" STORAGE_FREE_LIST_SUFFIX, "appointments.dat" STORAGE_SLOT_INDEX_SUFFIX,
+    APPOINTMENT_CLIENT_INDEX, APPOINTMENT_LAWYER_INDEX, APPOINTMENT_OFFICE_INDEX, APPOINTMENT_START_INDEX,
+    "series.dat", "series.dat" STORAGE_FREE_LIST_SUFFIX, "series.dat" STORAGE_SLOT_INDEX_SUFFIX, STORAGE_LOG_FILE
+};
+
+static int deletedRecords = 0;
+
+static void removeFiles(void) {
+    for (size_t i = 0; i < sizeof(TABLE_FILES) / sizeof(char*); i++) remove(TABLE_FILES[i]);
+}
+
+/**
+ * Simula a exclusão do cadastro, contando as chamadas
+ */
+static bool deleteRecord(int id) {
+    (void) id;
+    deletedRecords++;
+    return true;
+}
+
+/**
+ * Simula uma falha na exclusão do cadastro, depois que os agendamentos já foram resolvidos na mesma transação
+ */
+static bool failToDeleteRecord(int id) {
+    (void) id;
+    return false;
+}
+
+/**
+ * Cadastra um agendamento de uma hora a partir de START
+ */
+static int addAt(int clientId, int lawyerId, int officeId) {
+    Appointment appointment = {0, clientId, lawyerId, officeId, START, START + 60, false};
+    int id = addAppointment(&appointment);
+    TEST_ASSERT_TRUE(id > 0);
+    return id;
+}
+
+void setUp(void) {
+    closeFiles();
+    removeFiles();
+    setDurabilityMode(DURABILITY_NONE, 0, 0);
+    TEST_ASSERT_TRUE(configureRoomCapacity("2"));
+    TEST_ASSERT_TRUE(openAppointmentTable());
+    deletedRecords = 0;
+}
+
+void tearDown(void) {
+    closeAppointmentTable();
+    closeFiles();
+    removeFiles();
+}
+
+/**
+ * Verifica se a exclusão é impedida enquanto o cadastro tiver agendamentos ativos e permitida quando não tiver
+ */
+void test_deleteReferencedRecord_should_BlockWhileReferenced(void) {
+    addAt(1, 1, 1);
+
+    TEST_ASSERT_FALSE(deleteReferencedRecord(REFERENCE_OFFICE, 1, REFERENCE_BLOCK, 0, deleteRecord));
+    TEST_ASSERT_EQUAL_INT(0, deletedRecords);
+    TEST_ASSERT_TRUE(deleteReferencedRecord(REFERENCE_OFFICE, 2, REFERENCE_BLOCK, 0, deleteRecord));
+    TEST_ASSERT_EQUAL_INT(1, deletedRecords);
+}
+
+/**
+ * Verifica se os agendamentos excluídos junto com o cadastro saem da tabela e da agenda do advogado, e se nada muda
+ * quando a exclusão do cadastro falha na mesma transação
+ */
+void test_deleteReferencedRecord_should_CascadeAtomically(void) {
+    int id = addAt(1, 1, 1);
+
+    TEST_ASSERT_FALSE(deleteReferencedRecord(REFERENCE_CLIENT, 1, REFERENCE_CASCADE, 0, failToDeleteRecord));
+    TEST_ASSERT_EQUAL_INT(1, countAppointmentReferences(REFERENCE_CLIENT, 1));
+    TEST_ASSERT_EQUAL_INT(id, findLawyerConflict(1, START, START + 60, 0));
+
+    TEST_ASSERT_TRUE(deleteReferencedRecord(REFERENCE_CLIENT, 1, REFERENCE_CASCADE, 0, deleteRecord));
+    TEST_ASSERT_EQUAL_INT(0, countAppointmentReferences(REFERENCE_CLIENT, 1));
+    TEST_ASSERT_EQUAL_INT(0, findLawyerConflict(1, START, START + 60, 0));
+    TEST_ASSERT_NULL(findAppointment(id));
+}
+
+/**
+ * Verifica se a transferência confere os agendamentos transferidos entre si, se nada muda quando a exclusão do
+ * cadastro falha e se, quando ela é confirmada, as salas passam de um escritório para o outro
+ */
+void test_deleteReferencedRecord_should_ReassignAtomically(void) {
+    addAt(1, 1, 1);
+    addAt(2, 2, 1);
+    addAt(3, 3, 2);
+
+    // Cada agendamento caberia sozinho no escritório 2, mas os dois juntos passam das 2 salas
+    TEST_ASSERT_FALSE(deleteReferencedRecord(REFERENCE_OFFICE, 1, REFERENCE_REASSIGN, 2, deleteRecord));
+    TEST_ASSERT_FALSE(deleteReferencedRecord(REFERENCE_OFFICE, 1, REFERENCE_REASSIGN, 3, failToDeleteRecord));
+    TEST_ASSERT_EQUAL_INT(0, deletedRecords);
+    TEST_ASSERT_EQUAL_INT(2, countAppointmentReferences(REFERENCE_OFFICE, 1));
+    TEST_ASSERT_EQUAL_INT(0, getOfficeFreeRooms(1, START, START + 60));
+    TEST_ASSERT_EQUAL_INT(1, getOfficeFreeRooms(2, START, START + 60));
+    TEST_ASSERT_EQUAL_INT(2, getOfficeFreeRooms(3, START, START + 60));
+
+    TEST_ASSERT_TRUE(deleteReferencedRecord(REFERENCE_OFFICE, 1, REFERENCE_REASSIGN, 3, deleteRecord));
+    TEST_ASSERT_EQUAL_INT(0, countAppointmentReferences(REFERENCE_OFFICE, 1));
+    TEST_ASSERT_EQUAL_INT(2, countAppointmentReferences(REFERENCE_OFFICE, 3));
+    TEST_ASSERT_EQUAL_INT(2, getOfficeFreeRooms(1, START, START + 60));
+    TEST_ASSERT_EQUAL_INT(0, getOfficeFreeRooms(3, START, START + 60));
+}
+
+int main(void) {
+    // As tabelas de agendamentos têm nomes fixos; os testes rodam em um diretório próprio para não tocar nos dados
+    #ifdef __unix__
+        mkdir(TEST_DIRECTORY, 0755);
+        if (chdir(TEST_DIRECTORY) != 0) return 1;
+    #endif
+
+    UNITY_BEGIN();
+    RUN_TEST(test_deleteReferencedRecord_should_BlockWhileReferenced);
+    RUN_TEST(test_deleteReferencedRecord_should_CascadeAtomically);
+    RUN_TEST(test_deleteReferencedRecord_should_ReassignAtomically);
+    int failures = UNITY_END();
+
+    #ifdef __unix__
+        if (chdir("..") == 0) rmdir(TEST_DIRECTORY);
+    #endif
+    return failures;
+}
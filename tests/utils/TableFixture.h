@@ -0,0 +1,71 @@
+#ifndef TABLE_FIXTURE
+#define TABLE_FIXTURE
+
+#include "./../../unity/unity.h"
+#include "./../../unity/unity_internals.h"
+#include "./../../src/utils/storage.h"
+#include <stdio.h>
+#include <string.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/*
+ * Tabela usada pelos testes dos índices. Cada teste define TEST_TABLE e, se tiver um índice, TEST_INDEX antes de
+ * incluir este arquivo.
+ */
+
+/**
+ * Registro da tabela de testes: um texto, para os índices de texto, e um grupo e um valor, para as chaves da árvore B+
+ */
+typedef struct Record {
+    int id;
+    int group;
+    int value;
+    char name[100];
+    bool isDeleted;
+} Record;
+
+/**
+ * Remove a tabela, a sua lista de posições livres, o seu índice de posições e o índice do teste
+ */
+static inline void removeFiles(void) {
+    remove(TEST_TABLE);
+    remove(TEST_TABLE STORAGE_FREE_LIST_SUFFIX);
+    remove(TEST_TABLE STORAGE_SLOT_INDEX_SUFFIX);
+    #ifdef TEST_INDEX
+        remove(TEST_INDEX);
+    #endif
+}
+
+/**
+ * Fecha os arquivos do teste anterior e abre a tabela vazia, sem sincronizar as gravações com o disco
+ */
+static inline void openTestTable(void) {
+    closeFiles();
+    removeFiles();
+    setDurabilityMode(DURABILITY_NONE, 0, 0);
+    TEST_ASSERT_TRUE(openFile(TEST_TABLE, sizeof(Record), offsetof(Record, id), offsetof(Record, isDeleted)));
+}
+
+/**
+ * Fecha e remove os arquivos do teste
+ */
+static inline void closeTestTable(void) {
+    closeFiles();
+    removeFiles();
+}
+
+/**
+ * Cadastra um registro na tabela, sem passar pelo índice do teste
+ */
+static inline int addRecord(const char *name) {
+    Record record;
+    memset(&record, 0, sizeof(Record));
+    strncpy(record.name, name, sizeof(record.name) - 1);
+
+    int id = addElementToFile(&record, sizeof(Record), TEST_TABLE);
+    TEST_ASSERT_TRUE(id > 0);
+    return id;
+}
+
+#endif
@@ -0,0 +1,208 @@
+#define TEST_TABLE "test_bptree_table.dat"
+#define TEST_INDEX "test_bptree.idx"
+
+#include "./TableFixture.h"
+#include "./../../src/utils/bptree.h"
+
+static void getRecordKey(const void *element, BPlusKey *key) {
+    const Record *record = (const Record*) element;
+    key->group = record->group;
+    key->value = record->value;
+    key->id = record->id;
+}
+
+static int getRecordKeys(const void *element, BPlusKey *keys) {
+    getRecordKey(element, keys);
+    return 1;
+}
+
+/**
+ * Monta uma chave para cada caractere de um texto, como um índice de texto simplificado
+ */
+static int getCharKeys(const char *text, int id, BPlusKey *keys) {
+    int keysNumber = 0;
+    for (; text[keysNumber] != '\0'; keysNumber++) keys[keysNumber] = (BPlusKey) {text[keysNumber], 0, id};
+    return keysNumber;
+}
+
+/**
+ * Conta as chaves do intervalo [from, to) e verifica se elas vêm em ordem
+ */
+static int countRange(BPlusKey from, BPlusKey to) {
+    BPlusCursor cursor;
+    const BPlusKey *key;
+    BPlusKey previous = {0, 0, 0};
+    int count = 0;
+
+    TEST_ASSERT_TRUE(seekBPlusTree(&cursor, TEST_INDEX, &from, &to));
+    while ((key = nextBPlusKey(&cursor)) != NULL) {
+        if (count > 0) TEST_ASSERT_TRUE(previous.group < key->group || (previous.group == key->group && (previous.value < key->value || (previous.value == key->value && previous.id < key->id))));
+        previous = *key;
+        count++;
+    }
+
+    return count;
+}
+
+void setUp(void) {
+    openTestTable();
+    TEST_ASSERT_TRUE(openBPlusTree(TEST_INDEX, TEST_TABLE, sizeof(Record), getRecordKey));
+}
+
+void tearDown(void) {
+    closeTestTable();
+}
+
+/**
+ * Verifica se as inserções fora de ordem, que dividem folhas e nós internos, mantêm as chaves ordenadas e se a busca
+ * por intervalo retorna exatamente as chaves do intervalo
+ */
+void test_insertIntoBPlusTree_should_KeepKeysOrdered(void) {
+    for (int i = 0; i < 3000; i++) {
+        BPlusKey key = {i % 3, (i * 7919) % 3000, i + 1};
+        TEST_ASSERT_TRUE(insertIntoBPlusTree(TEST_INDEX, &key));
+    }
+
+    TEST_ASSERT_EQUAL_INT(3000, countRange((BPlusKey) {0, 0, 0}, (BPlusKey) {3, 0, 0}));
+    TEST_ASSERT_EQUAL_INT(1000, countRange((BPlusKey) {1, 0, 0}, (BPlusKey) {2, 0, 0}));
+    TEST_ASSERT_EQUAL_INT(100, countRange((BPlusKey) {2, 1000, 0}, (BPlusKey) {2, 1300, 0}));
+    TEST_ASSERT_EQUAL_INT(0, countRange((BPlusKey) {5, 0, 0}, (BPlusKey) {6, 0, 0}));
+}
+
+/**
+ * Verifica se chaves repetidas são recusadas e se as chaves removidas deixam de aparecer nas buscas
+ */
+void test_removeFromBPlusTree_should_HideRemovedKeys(void) {
+    for (int i = 0; i < 200; i++) {
+        BPlusKey key = {7, i, i + 1};
+        insertIntoBPlusTree(TEST_INDEX, &key);
+    }
+
+    BPlusKey duplicate = {7, 10, 11};
+    TEST_ASSERT_FALSE(insertIntoBPlusTree(TEST_INDEX, &duplicate));
+
+    for (int i = 0; i < 100; i++) {
+        BPlusKey key = {7, i, i + 1};
+        TEST_ASSERT_TRUE(removeFromBPlusTree(TEST_INDEX, &key));
+    }
+    TEST_ASSERT_TRUE(removeFromBPlusTree(TEST_INDEX, &duplicate));
+
+    TEST_ASSERT_EQUAL_INT(0, countRange((BPlusKey) {7, 0, 0}, (BPlusKey) {7, 100, 0}));
+    TEST_ASSERT_EQUAL_INT(100, countRange((BPlusKey) {7, 0, 0}, (BPlusKey) {8, 0, 0}));
+    TEST_ASSERT_TRUE(insertIntoBPlusTree(TEST_INDEX, &duplicate));
+    TEST_ASSERT_EQUAL_INT(101, countRange((BPlusKey) {7, 0, 0}, (BPlusKey) {8, 0, 0}));
+}
+
+/**
+ * Verifica se a árvore desatualizada é recriada a partir dos registros ativos da tabela
+ */
+void test_openBPlusTree_should_RebuildFromTable(void) {
+    for (int i = 0; i < 500; i++) {
+        Record record = {.group = i % 5, .value = 1000 - i};
+        addElementToFile(&record, sizeof(Record), TEST_TABLE);
+    }
+    Record deleted = {.group = 1, .isDeleted = true};
+    addElementToFile(&deleted, sizeof(Record), TEST_TABLE);
+
+    TEST_ASSERT_TRUE(openBPlusTree(TEST_INDEX, TEST_TABLE, sizeof(Record), getRecordKey));
+    TEST_ASSERT_EQUAL_INT(100, countRange((BPlusKey) {1, 0, 0}, (BPlusKey) {2, 0, 0}));
+    TEST_ASSERT_EQUAL_INT(10, countRange((BPlusKey) {3, 900, 0}, (BPlusKey) {3, 950, 0}));
+
+    BPlusKey key = {9, 0, 999};
+    TEST_ASSERT_TRUE(insertIntoBPlusTree(TEST_INDEX, &key));
+    TEST_ASSERT_EQUAL_INT(1, countRange((BPlusKey) {9, 0, 0}, (BPlusKey) {10, 0, 0}));
+}
+
+/**
+ * Verifica se a abertura confia no estado da tabela guardado no nó 0, sem percorrer a tabela, e se recria a árvore
+ * quando a tabela muda sem ela, mesmo que o número de chaves continue igual
+ */
+void test_openMultiKeyBPlusTree_should_CompareTableState(void) {
+    for (int i = 0; i < 3; i++) {
+        Record record = {.group = 1, .value = i};
+        int id = addElementToFile(&record, sizeof(Record), TEST_TABLE);
+        BPlusKey key = {1, i, id};
+        TEST_ASSERT_TRUE(insertIntoBPlusTree(TEST_INDEX, &key));
+    }
+
+    // Uma chave que a tabela não gera só continua na árvore se ela não for recriada
+    BPlusKey extra = {9, 0, 999};
+    TEST_ASSERT_TRUE(insertIntoBPlusTree(TEST_INDEX, &extra));
+    closeFiles();
+    TEST_ASSERT_TRUE(openFile(TEST_TABLE, sizeof(Record), offsetof(Record, id), offsetof(Record, isDeleted)));
+    TEST_ASSERT_TRUE(openMultiKeyBPlusTree(TEST_INDEX, TEST_TABLE, sizeof(Record), getRecordKeys, 1));
+    TEST_ASSERT_EQUAL_INT(1, countRange((BPlusKey) {9, 0, 0}, (BPlusKey) {10, 0, 0}));
+    TEST_ASSERT_TRUE(removeFromBPlusTree(TEST_INDEX, &extra));
+
+    // Um registro excluído e outro cadastrado sem passar pela árvore mantêm o número de chaves
+    Record record;
+    TEST_ASSERT_TRUE(readElementById(&record, sizeof(Record), 1, TEST_TABLE));
+    record.isDeleted = true;
+    TEST_ASSERT_TRUE(updateElementById(&record, sizeof(Record), 1, TEST_TABLE));
+    record = (Record) {.group = 2};
+    TEST_ASSERT_EQUAL_INT(4, addElementToFile(&record, sizeof(Record), TEST_TABLE));
+
+    closeFiles();
+    TEST_ASSERT_TRUE(openFile(TEST_TABLE, sizeof(Record), offsetof(Record, id), offsetof(Record, isDeleted)));
+    TEST_ASSERT_TRUE(openMultiKeyBPlusTree(TEST_INDEX, TEST_TABLE, sizeof(Record), getRecordKeys, 1));
+    TEST_ASSERT_EQUAL_INT(2, countRange((BPlusKey) {1, 0, 0}, (BPlusKey) {2, 0, 0}));
+    TEST_ASSERT_EQUAL_INT(1, countRange((BPlusKey) {2, 0, 0}, (BPlusKey) {3, 0, 0}));
+}
+
+/**
+ * Verifica se a recriação feita na compactação descarta as folhas esvaziadas pelas remoções
+ */
+void test_compactBPlusTree_should_DropEmptiedLeaves(void) {
+    for (int i = 0; i < 1000; i++) {
+        Record record = {.group = 4, .value = i};
+        int id = addElementToFile(&record, sizeof(Record), TEST_TABLE);
+        BPlusKey key = {4, i, id};
+        TEST_ASSERT_TRUE(insertIntoBPlusTree(TEST_INDEX, &key));
+    }
+    for (int id = 1; id <= 900; id++) {
+        Record record;
+        TEST_ASSERT_TRUE(readElementById(&record, sizeof(Record), id, TEST_TABLE));
+        BPlusKey key = {record.group, record.value, id};
+        record.isDeleted = true;
+        TEST_ASSERT_TRUE(updateElementById(&record, sizeof(Record), id, TEST_TABLE));
+        TEST_ASSERT_TRUE(removeFromBPlusTree(TEST_INDEX, &key));
+    }
+    int nodesNumber = getNumberOfElements(TEST_INDEX, sizeof(BPlusNode));
+
+    TEST_ASSERT_EQUAL_INT(900, compactFile(TEST_TABLE, sizeof(Record)));
+    TEST_ASSERT_TRUE(compactBPlusTree(TEST_INDEX, TEST_TABLE, sizeof(Record), getRecordKey));
+    TEST_ASSERT_TRUE(getNumberOfElements(TEST_INDEX, sizeof(BPlusNode)) * 4 < nodesNumber);
+    TEST_ASSERT_EQUAL_INT(100, countRange((BPlusKey) {4, 0, 0}, (BPlusKey) {5, 0, 0}));
+}
+
+/**
+ * Verifica se as chaves de um texto são inseridas, mantidas quando o texto não muda, trocadas quando ele muda e
+ * removidas quando o registro é excluído
+ */
+void test_replaceTextKeys_should_SwapKeysOfChangedText(void) {
+    BPlusKey from = {'a', 0, 0}, to = {'z', 0, 0};
+
+    TEST_ASSERT_TRUE(replaceTextKeys(TEST_INDEX, NULL, "abc", 1, false, getCharKeys, 8));
+    TEST_ASSERT_TRUE(replaceTextKeys(TEST_INDEX, NULL, "bx", 2, false, getCharKeys, 8));
+    TEST_ASSERT_TRUE(replaceTextKeys(TEST_INDEX, "abc", "abc", 1, false, getCharKeys, 8));
+    TEST_ASSERT_EQUAL_INT(5, countRange(from, to));
+
+    TEST_ASSERT_TRUE(replaceTextKeys(TEST_INDEX, "abc", "cd", 1, false, getCharKeys, 8));
+    TEST_ASSERT_EQUAL_INT(4, countRange(from, to));
+    TEST_ASSERT_EQUAL_INT(0, countRange(from, (BPlusKey) {'b', 0, 0}));
+    TEST_ASSERT_EQUAL_INT(1, countRange((BPlusKey) {'d', 0, 0}, (BPlusKey) {'e', 0, 0}));
+
+    TEST_ASSERT_TRUE(replaceTextKeys(TEST_INDEX, "cd", "cd", 1, true, getCharKeys, 8));
+    TEST_ASSERT_EQUAL_INT(2, countRange(from, to));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_insertIntoBPlusTree_should_KeepKeysOrdered);
+    RUN_TEST(test_removeFromBPlusTree_should_HideRemovedKeys);
+    RUN_TEST(test_openBPlusTree_should_RebuildFromTable);
+    RUN_TEST(test_openMultiKeyBPlusTree_should_CompareTableState);
+    RUN_TEST(test_compactBPlusTree_should_DropEmptiedLeaves);
+    RUN_TEST(test_replaceTextKeys_should_SwapKeysOfChangedText);
+    return UNITY_END();
+}
@@ -0,0 +1,88 @@
+#include "./../../unity/unity.h"
+#include "./../../unity/unity_internals.h"
+#include "./../../src/utils/calendar.h"
+#include "./../../src/utils/date.h"
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+/**
+ * Verifica se as funções daysFromCivil e civilFromDays são inversas, inclusive antes de 1970 e em anos bissextos
+ */
+void test_daysFromCivil_should_RoundTripWithCivilFromDays(void) {
+    int year, month, day;
+
+    TEST_ASSERT_EQUAL_INT(0, daysFromCivil(1970, 1, 1));
+    TEST_ASSERT_EQUAL_INT(19782, daysFromCivil(2024, 2, 29));
+    TEST_ASSERT_EQUAL_INT(-1, daysFromCivil(1969, 12, 31));
+    TEST_ASSERT_EQUAL_INT(11016, daysFromCivil(2000, 2, 29));
+
+    for (long days = -800000; days <= 800000; days += 997) {
+        civilFromDays(days, &year, &month, &day);
+        TEST_ASSERT_EQUAL_INT(days, daysFromCivil(year, month, day));
+    }
+
+    civilFromDays(-1, &year, &month, &day);
+    TEST_ASSERT_EQUAL_INT(1969, year);
+    TEST_ASSERT_EQUAL_INT(12, month);
+    TEST_ASSERT_EQUAL_INT(31, day);
+}
+
+/**
+ * Verifica se as funções getWeekday e getDaysInMonth seguem o calendário gregoriano
+ */
+void test_getWeekday_should_FollowGregorianCalendar(void) {
+    TEST_ASSERT_EQUAL_INT(THURSDAY, getWeekday(0));
+    TEST_ASSERT_EQUAL_INT(WEDNESDAY, getWeekday(-1));
+    TEST_ASSERT_EQUAL_INT(THURSDAY, getWeekday(daysFromCivil(2024, 2, 29)));
+    TEST_ASSERT_EQUAL_INT(SUNDAY, getWeekday(daysFromCivil(1900, 1, 7)));
+    TEST_ASSERT_EQUAL_STRING("domingo", getWeekdayName(SUNDAY));
+
+    TEST_ASSERT_EQUAL_INT(29, getDaysInMonth(2, 2000));
+    TEST_ASSERT_EQUAL_INT(28, getDaysInMonth(2, 1900));
+    TEST_ASSERT_EQUAL_INT(31, getDaysInMonth(12, 2023));
+    TEST_ASSERT_EQUAL_INT(0, getDaysInMonth(13, 2023));
+}
+
+/**
+ * Verifica se a soma de minutos e a duração atravessam a meia-noite, a virada do mês e a do ano
+ */
+void test_addMinutesToDatetime_should_CrossMidnight(void) {
+    Datetime start = {31, 12, 2023, 23, 30}, end = start;
+
+    addMinutesToDatetime(&end, 90);
+    TEST_ASSERT_EQUAL_INT(1, end.day);
+    TEST_ASSERT_EQUAL_INT(1, end.month);
+    TEST_ASSERT_EQUAL_INT(2024, end.year);
+    TEST_ASSERT_EQUAL_INT(1, end.hour);
+    TEST_ASSERT_EQUAL_INT(0, end.minute);
+    TEST_ASSERT_EQUAL_INT(90, getDuration(&start, &end));
+
+    addMinutesToDatetime(&end, -90);
+    TEST_ASSERT_EQUAL_INT(0, getDuration(&start, &end));
+
+    TEST_ASSERT_EQUAL_INT(-1, minutesToDays(-1));
+    TEST_ASSERT_EQUAL_INT(MINUTES_PER_DAY - 1, getMinuteOfDay(-1));
+}
+
+/**
+ * Verifica se a função rangesOverlap trata os intervalos como semiabertos
+ */
+void test_rangesOverlap_should_IgnoreTouchingRanges(void) {
+    long midnight = daysFromCivil(2024, 3, 1) * MINUTES_PER_DAY;
+
+    TEST_ASSERT_TRUE(rangesOverlap(midnight - 60, midnight + 60, midnight + 30, midnight + 90));
+    TEST_ASSERT_TRUE(rangesOverlap(midnight - 60, midnight + 60, midnight - 10, midnight + 10));
+    TEST_ASSERT_FALSE(rangesOverlap(midnight - 60, midnight, midnight, midnight + 60));
+    TEST_ASSERT_FALSE(rangesOverlap(midnight, midnight + 60, midnight - 60, midnight));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_daysFromCivil_should_RoundTripWithCivilFromDays);
+    RUN_TEST(test_getWeekday_should_FollowGregorianCalendar);
+    RUN_TEST(test_addMinutesToDatetime_should_CrossMidnight);
+    RUN_TEST(test_rangesOverlap_should_IgnoreTouchingRanges);
+    return UNITY_END();
+}
@@ -18,18 +18,119 @@ void test_loadDatetime_should_ParseDateAndTimeCorrectly(void) {
     const char *date = "25/12/2024";
     const char *time = "18:30";
 
-    loadDatetime(&datetime, date, time);
+    TEST_ASSERT_TRUE(loadDatetime(&datetime, date, time));
 
     TEST_ASSERT_EQUAL_INT(2024, datetime.year);
     TEST_ASSERT_EQUAL_INT(12, datetime.month);
     TEST_ASSERT_EQUAL_INT(25, datetime.day);
     TEST_ASSERT_EQUAL_INT(18, datetime.hour);
     TEST_ASSERT_EQUAL_INT(30, datetime.minute);
-    TEST_ASSERT_EQUAL_STRING("25/12/2024 18:30", datetime.date);
+}
+
+/**
+ * Verifica se a função datetimeToMinutes conta os minutos desde 01/01/1970, inclusive em anos bissextos
+ */
+void test_datetimeToMinutes_should_CountMinutesSinceEpoch(void) {
+    Datetime epoch, leapDay, nextDay;
+
+    loadDatetime(&epoch, "01/01/1970", "00:00");
+    loadDatetime(&leapDay, "29/02/2024", "23:59");
+    loadDatetime(&nextDay, "01/03/2024", "00:00");
+
+    TEST_ASSERT_EQUAL_INT(0, datetimeToMinutes(&epoch));
+    TEST_ASSERT_EQUAL_INT(28487519, datetimeToMinutes(&leapDay));
+    TEST_ASSERT_EQUAL_INT(1, datetimeToMinutes(&nextDay) - datetimeToMinutes(&leapDay));
+}
+
+/**
+ * Verifica se a função minutesToDatetime desfaz a conversão feita por datetimeToMinutes
+ */
+void test_minutesToDatetime_should_ConvertMinutesSinceEpoch(void) {
+    Datetime datetime, converted;
+
+    loadDatetime(&datetime, "29/02/2024", "23:59");
+    minutesToDatetime(datetimeToMinutes(&datetime), &converted);
+
+    TEST_ASSERT_EQUAL_INT(2024, converted.year);
+    TEST_ASSERT_EQUAL_INT(2, converted.month);
+    TEST_ASSERT_EQUAL_INT(29, converted.day);
+    TEST_ASSERT_EQUAL_INT(23, converted.hour);
+    TEST_ASSERT_EQUAL_INT(59, converted.minute);
+}
+
+/**
+ * Verifica se as funções parseDatetime e formatDatetime convertem os textos em minutos e de volta
+ */
+void test_parseDatetime_should_RoundTripWithFormatting(void) {
+    int minutes;
+    char datetime[DATETIME_SIZE], date[DATE_SIZE], time[TIME_SIZE];
+
+    TEST_ASSERT_TRUE(parseDatetime("29/02/2024", "23:59", &minutes));
+    TEST_ASSERT_EQUAL_INT(28487519, minutes);
+
+    formatDatetime(minutes, datetime);
+    TEST_ASSERT_EQUAL_STRING("29/02/2024 23:59", datetime);
+
+    formatDate(minutes + 1, date);
+    formatTime(minutes + 1, time);
+    TEST_ASSERT_EQUAL_STRING("01/03/2024", date);
+    TEST_ASSERT_EQUAL_STRING("00:00", time);
+
+    TEST_ASSERT_FALSE(parseDatetime("aa/02/2024", "23:59", &minutes));
+}
+
+/**
+ * Verifica se parseDatetime recusa, em vez de truncar, as datas que não cabem no int dos registros
+ */
+void test_parseDatetime_should_RejectDatesBeyondStoredRange(void) {
+    int minutes = 0;
+    char datetime[DATETIME_SIZE];
+
+    Datetime limit = {1, 1, DATE_MAX_YEAR + 1, 0, 0};
+
+    TEST_ASSERT_TRUE(parseDatetime("31/12/6052", "23:59", &minutes));
+    formatDatetime(minutes, datetime);
+    TEST_ASSERT_EQUAL_STRING("31/12/6052 23:59", datetime);
+
+    TEST_ASSERT_FALSE(parseDatetime("01/01/9999", "10:00", &minutes));
+    TEST_ASSERT_FALSE(parseDatetime("01/01/6053", "00:00", &minutes));
+    TEST_ASSERT_TRUE(datetimeToStoredMinutes(&limit, &minutes));
+    limit.year = 9999;
+    TEST_ASSERT_FALSE(datetimeToStoredMinutes(&limit, &minutes));
+}
+
+/**
+ * Verifica se as funções parseDate e parseTime recusam textos fora do formato e datas ou horários inexistentes
+ */
+void test_parseDate_should_ValidateFormatAndCalendar(void) {
+    Datetime datetime;
+
+    TEST_ASSERT_TRUE(parseDate("29/02/2024", &datetime));
+    TEST_ASSERT_EQUAL_INT(29, datetime.day);
+    TEST_ASSERT_FALSE(parseDate("29/02/2023", &datetime));
+    TEST_ASSERT_FALSE(parseDate("31/04/2024", &datetime));
+    TEST_ASSERT_FALSE(parseDate("01/13/2024", &datetime));
+    TEST_ASSERT_FALSE(parseDate("01/01/0000", &datetime));
+    TEST_ASSERT_FALSE(parseDate("+1/01/2024", &datetime));
+    TEST_ASSERT_FALSE(parseDate("01-01-2024", &datetime));
+    TEST_ASSERT_FALSE(parseDate("01/01/2024 ", &datetime));
+    TEST_ASSERT_FALSE(parseDate("01/01", &datetime));
+
+    TEST_ASSERT_TRUE(parseTime("23:59", &datetime));
+    TEST_ASSERT_EQUAL_INT(23, datetime.hour);
+    TEST_ASSERT_EQUAL_INT(59, datetime.minute);
+    TEST_ASSERT_FALSE(parseTime("24:00", &datetime));
+    TEST_ASSERT_FALSE(parseTime("12:60", &datetime));
+    TEST_ASSERT_FALSE(parseTime("1:00", &datetime));
 }
 
 int main(void) {
     UNITY_BEGIN();
     RUN_TEST(test_loadDatetime_should_ParseDateAndTimeCorrectly);
+    RUN_TEST(test_datetimeToMinutes_should_CountMinutesSinceEpoch);
+    RUN_TEST(test_minutesToDatetime_should_ConvertMinutesSinceEpoch);
+    RUN_TEST(test_parseDatetime_should_RoundTripWithFormatting);
+    RUN_TEST(test_parseDatetime_should_RejectDatesBeyondStoredRange);
+    RUN_TEST(test_parseDate_should_ValidateFormatAndCalendar);
     return UNITY_END();
 }
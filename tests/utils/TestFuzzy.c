@@ -0,0 +1,152 @@
+#define TEST_TABLE "test_fuzzy_table.dat"
+
+#include "./TableFixture.h"
+#include "./../../src/utils/fuzzy.h"
+#include "./../../src/utils/str.h"
+
+static int search(const char *query, FuzzyMatch *matches, int threadsNumber) {
+    return searchFuzzy(TEST_TABLE, sizeof(Record), offsetof(Record, id), offsetof(Record, isDeleted), offsetof(Record, name), query, matches, 10, threadsNumber);
+}
+
+static int getDistance(const char *query, const char *text, bool isSubstring) {
+    FuzzyPattern pattern;
+    TEST_ASSERT_TRUE(compileFuzzyPattern(query, &pattern));
+    return getEditDistance(&pattern, text, isSubstring);
+}
+
+void setUp(void) {
+    openTestTable();
+}
+
+void tearDown(void) {
+    closeTestTable();
+}
+
+/**
+ * Verifica a distância até o texto inteiro e até o trecho mais parecido do texto, com consultas acentuadas
+ */
+void test_getEditDistance_should_ComputeLevenshteinDistance(void) {
+    TEST_ASSERT_EQUAL_INT(3, getDistance("kitten", "sitting", false));
+    TEST_ASSERT_EQUAL_INT(0, getDistance("João", "joao", false));
+    TEST_ASSERT_EQUAL_INT(4, getDistance("abcd", "", false));
+    TEST_ASSERT_EQUAL_INT(2, getDistance("abc", "cab", false));
+    TEST_ASSERT_EQUAL_INT(1, getDistance("Souza", "maria sousa lima", true));
+    TEST_ASSERT_EQUAL_INT(12, getDistance("Souza", "maria sousa lima", false));
+    TEST_ASSERT_EQUAL_INT(0, getDistance("lima", "maria sousa lima", true));
+
+    char query[FUZZY_MAX_PATTERN + 2];
+    FuzzyPattern pattern;
+    memset(query, 'a', FUZZY_MAX_PATTERN);
+    query[FUZZY_MAX_PATTERN] = '\0';
+    TEST_ASSERT_EQUAL_INT(1, getDistance(query, query + 1, false));
+    strcat(query, "a");
+    TEST_ASSERT_FALSE(compileFuzzyPattern(query, &pattern));
+    TEST_ASSERT_FALSE(compileFuzzyPattern(" ?! ", &pattern));
+}
+
+/**
+ * Verifica se a busca encontra nomes com erros de digitação, ordenados pela distância, e ignora os excluídos
+ */
+void test_searchFuzzy_should_RankClosestNames(void) {
+    int souza = addRecord("Maria Souza"), sousa = addRecord("Ana Sousa"), deleted = addRecord("Pedro Souza");
+    int joao = addRecord("João Santos"), joana = addRecord("Joana Lima");
+    addRecord("Carlos Pereira");
+    FuzzyMatch matches[10];
+
+    Record record;
+    TEST_ASSERT_TRUE(readElementById(&record, sizeof(Record), deleted, TEST_TABLE));
+    record.isDeleted = true;
+    TEST_ASSERT_TRUE(updateElementById(&record, sizeof(Record), deleted, TEST_TABLE));
+
+    TEST_ASSERT_EQUAL_INT(2, search("sousa", matches, 1));
+    TEST_ASSERT_EQUAL_INT(sousa, matches[0].id);
+    TEST_ASSERT_EQUAL_INT(0, matches[0].distance);
+    TEST_ASSERT_EQUAL_INT(souza, matches[1].id);
+    TEST_ASSERT_EQUAL_INT(1, matches[1].distance);
+
+    TEST_ASSERT_EQUAL_INT(2, search("Joao", matches, 1));
+    TEST_ASSERT_EQUAL_INT(joao, matches[0].id);
+    TEST_ASSERT_EQUAL_INT(joana, matches[1].id);
+    TEST_ASSERT_EQUAL_INT(0, search("xyzw", matches, 1));
+    TEST_ASSERT_EQUAL_INT(-1, search("", matches, 1));
+
+    // Os nomes normalizados em memória são lidos novamente depois de uma escrita na tabela
+    TEST_ASSERT_TRUE(readElementById(&record, sizeof(Record), joana, TEST_TABLE));
+    strcpy(record.name, "Xavier Zwicky");
+    TEST_ASSERT_TRUE(updateElementById(&record, sizeof(Record), joana, TEST_TABLE));
+    TEST_ASSERT_EQUAL_INT(1, search("Joao", matches, 1));
+    TEST_ASSERT_EQUAL_INT(1, search("xavier zwiky", matches, 1));
+    TEST_ASSERT_EQUAL_INT(joana, matches[0].id);
+}
+
+/**
+ * Verifica se a busca com várias threads retorna os mesmos registros, na mesma ordem, que a busca com uma thread
+ */
+void test_searchFuzzy_should_MatchSingleThreadResults(void) {
+    const char *names[] = {"Silva", "Silvia", "Sylvia", "Salva", "Selva", "Sílvio", "Silveira", "Souza"};
+    FuzzyMatch single[10], parallel[10];
+
+    for (int i = 0; i < 200; i++) {
+        char name[55];
+        snprintf(name, sizeof(name), "%s %d", names[i % 8], i);
+        addRecord(name);
+    }
+
+    int found = search("silvia", single, 1);
+    TEST_ASSERT_EQUAL_INT(10, found);
+    TEST_ASSERT_EQUAL_INT(0, single[0].distance);
+    for (int threadsNumber = 2; threadsNumber <= 8; threadsNumber *= 2) {
+        TEST_ASSERT_EQUAL_INT(found, search("silvia", parallel, threadsNumber));
+        for (int i = 0; i < found; i++) TEST_ASSERT_EQUAL_INT(single[i].id, parallel[i].id);
+    }
+}
+
+/**
+ * Verifica se o filtro que descarta textos antes do cálculo da distância não muda os registros encontrados, comparando a
+ * busca com o cálculo da distância em todos os registros
+ */
+void test_searchFuzzy_should_MatchExhaustiveSearch(void) {
+    const char *firstNames[] = {"Maria", "Mário", "Marta", "Ana", "Joana", "João", "Patrícia", "Beatriz"};
+    const char *lastNames[] = {"Souza", "Sousa", "Conceição", "Brandão", "Oliveira", "Olivera", "Rocha", "Xavier"};
+    const char *queries[] = {"sousa", "joao", "conseicao", "patricia brandao", "ana olivera rocha", "xyz", "a"};
+    char names[320][55];
+
+    for (int i = 0; i < 320; i++) {
+        snprintf(names[i], sizeof(names[i]), "%s %s %s", firstNames[i % 8], lastNames[(i / 8) % 8], lastNames[(i / 5) % 8]);
+        TEST_ASSERT_EQUAL_INT(i + 1, addRecord(names[i]));
+    }
+
+    for (size_t q = 0; q < sizeof(queries) / sizeof(char*); q++) {
+        int length = (int) strlen(queries[q]), maxDistance = length / FUZZY_ERROR_RATIO > 0 ? length / FUZZY_ERROR_RATIO : 1;
+        FuzzyMatch expected[10], found[10];
+        int expectedNumber = 0;
+
+        // Seleção dos 10 melhores registros, na ordem da busca: trecho mais próximo, texto inteiro mais próximo e ID
+        for (int i = 0; i < 320; i++) {
+            char folded[FUZZY_TEXT_SIZE];
+            foldText(names[i], folded, FUZZY_TEXT_SIZE);
+            FuzzyMatch match = {i + 1, getDistance(queries[q], folded, true), getDistance(queries[q], folded, false)};
+            if (match.distance > maxDistance) continue;
+
+            int position = expectedNumber < 10 ? expectedNumber++ : 10;
+            for (; position > 0; position--) {
+                const FuzzyMatch *previous = &expected[position - 1];
+                if (previous->distance < match.distance || (previous->distance == match.distance && previous->editDistance <= match.editDistance)) break;
+                if (position < 10) expected[position] = *previous;
+            }
+            if (position < 10) expected[position] = match;
+        }
+
+        TEST_ASSERT_EQUAL_INT(expectedNumber, search(queries[q], found, 1));
+        for (int i = 0; i < expectedNumber; i++) TEST_ASSERT_EQUAL_INT(expected[i].id, found[i].id);
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_getEditDistance_should_ComputeLevenshteinDistance);
+    RUN_TEST(test_searchFuzzy_should_RankClosestNames);
+    RUN_TEST(test_searchFuzzy_should_MatchSingleThreadResults);
+    RUN_TEST(test_searchFuzzy_should_MatchExhaustiveSearch);
+    return UNITY_END();
+}
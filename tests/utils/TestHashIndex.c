@@ -0,0 +1,136 @@
+#define TEST_TABLE "test_hash_table.dat"
+#define TEST_INDEX "test_hash.idx"
+
+#include "./TableFixture.h"
+#include "./../../src/utils/hashindex.h"
+
+void setUp(void) {
+    openTestTable();
+}
+
+void tearDown(void) {
+    closeTestTable();
+}
+
+/**
+ * Verifica se as chaves inseridas são encontradas e se chaves repetidas são recusadas
+ */
+void test_insertIntoHashIndex_should_RejectDuplicates(void) {
+    TEST_ASSERT_TRUE(reserveHashIndex(TEST_INDEX, 2));
+    TEST_ASSERT_TRUE(insertIntoHashIndex(TEST_INDEX, "12345678909", 1));
+    TEST_ASSERT_TRUE(insertIntoHashIndex(TEST_INDEX, "98765432100", 2));
+    TEST_ASSERT_FALSE(insertIntoHashIndex(TEST_INDEX, "12345678909", 3));
+
+    TEST_ASSERT_EQUAL_INT(1, findInHashIndex(TEST_INDEX, "12345678909"));
+    TEST_ASSERT_EQUAL_INT(2, findInHashIndex(TEST_INDEX, "98765432100"));
+    TEST_ASSERT_EQUAL_INT(0, findInHashIndex(TEST_INDEX, "11111111111"));
+}
+
+/**
+ * Verifica se uma chave removida deixa de ser encontrada e pode ser inserida novamente
+ */
+void test_removeFromHashIndex_should_AllowReinsert(void) {
+    reserveHashIndex(TEST_INDEX, 2);
+    insertIntoHashIndex(TEST_INDEX, "12345678909", 1);
+
+    TEST_ASSERT_TRUE(removeFromHashIndex(TEST_INDEX, "12345678909", 1));
+    TEST_ASSERT_EQUAL_INT(0, findInHashIndex(TEST_INDEX, "12345678909"));
+    TEST_ASSERT_TRUE(removeFromHashIndex(TEST_INDEX, "12345678909", 1));
+
+    TEST_ASSERT_TRUE(insertIntoHashIndex(TEST_INDEX, "12345678909", 2));
+    TEST_ASSERT_EQUAL_INT(2, findInHashIndex(TEST_INDEX, "12345678909"));
+}
+
+/**
+ * Verifica se a troca de chave libera a chave antiga, mantém a chave que não mudou e apenas remove a chave de um
+ * registro excluído
+ */
+void test_replaceInHashIndex_should_MoveKey(void) {
+    reserveHashIndex(TEST_INDEX, 2);
+    insertIntoHashIndex(TEST_INDEX, "12345678909", 1);
+
+    TEST_ASSERT_TRUE(replaceInHashIndex(TEST_INDEX, "12345678909", "12345678909", 1, false));
+    TEST_ASSERT_EQUAL_INT(1, findInHashIndex(TEST_INDEX, "12345678909"));
+    TEST_ASSERT_TRUE(replaceInHashIndex(TEST_INDEX, "12345678909", "98765432100", 1, false));
+    TEST_ASSERT_EQUAL_INT(0, findInHashIndex(TEST_INDEX, "12345678909"));
+    TEST_ASSERT_EQUAL_INT(1, findInHashIndex(TEST_INDEX, "98765432100"));
+
+    TEST_ASSERT_TRUE(replaceInHashIndex(TEST_INDEX, "98765432100", "98765432100", 1, true));
+    TEST_ASSERT_EQUAL_INT(0, findInHashIndex(TEST_INDEX, "98765432100"));
+}
+
+/**
+ * Verifica se o índice cresce ao reservar espaço, mantendo todas as chaves
+ */
+void test_reserveHashIndex_should_GrowIndex(void) {
+    char key[12];
+
+    for (int i = 1; i <= 300; i++) {
+        snprintf(key, sizeof(key), "%011d", i * 7919);
+        TEST_ASSERT_TRUE(reserveHashIndex(TEST_INDEX, 1));
+        TEST_ASSERT_TRUE(insertIntoHashIndex(TEST_INDEX, key, i));
+    }
+
+    TEST_ASSERT_TRUE(getNumberOfElements(TEST_INDEX, sizeof(HashBucket)) > 300);
+    for (int i = 1; i <= 300; i++) {
+        snprintf(key, sizeof(key), "%011d", i * 7919);
+        TEST_ASSERT_EQUAL_INT(i, findInHashIndex(TEST_INDEX, key));
+    }
+}
+
+/**
+ * Verifica se o índice é recriado a partir da tabela quando está ausente ou desatualizado
+ */
+void test_openHashIndex_should_RebuildFromTable(void) {
+    Record first = {.name = "12345678909"}, second = {.name = "98765432100"};
+
+    addElementToFile(&first, sizeof(Record), TEST_TABLE);
+    addElementToFile(&second, sizeof(Record), TEST_TABLE);
+
+    TEST_ASSERT_TRUE(openHashIndex(TEST_INDEX, TEST_TABLE, sizeof(Record), offsetof(Record, id), offsetof(Record, name)));
+    TEST_ASSERT_EQUAL_INT(1, findInHashIndex(TEST_INDEX, "12345678909"));
+    TEST_ASSERT_EQUAL_INT(2, findInHashIndex(TEST_INDEX, "98765432100"));
+
+    second.isDeleted = true;
+    updateElementById(&second, sizeof(Record), 2, TEST_TABLE);
+    TEST_ASSERT_TRUE(openHashIndex(TEST_INDEX, TEST_TABLE, sizeof(Record), offsetof(Record, id), offsetof(Record, name)));
+    TEST_ASSERT_EQUAL_INT(0, findInHashIndex(TEST_INDEX, "98765432100"));
+}
+
+/**
+ * Verifica se a inserção na tabela e no índice feitas na mesma transação são desfeitas juntas
+ */
+void test_transaction_should_RollbackTableAndIndex(void) {
+    Record record = {.name = "12345678909"};
+
+    reserveHashIndex(TEST_INDEX, 1);
+
+    beginTransaction();
+    int id = addElementToFile(&record, sizeof(Record), TEST_TABLE);
+    TEST_ASSERT_TRUE(insertIntoHashIndex(TEST_INDEX, record.name, id));
+    TEST_ASSERT_EQUAL_INT(id, findInHashIndex(TEST_INDEX, record.name));
+    rollbackTransaction();
+
+    TEST_ASSERT_EQUAL_INT(0, findInHashIndex(TEST_INDEX, record.name));
+    TEST_ASSERT_EQUAL_INT(0, getNumberOfElements(TEST_TABLE, sizeof(Record)));
+
+    beginTransaction();
+    id = addElementToFile(&record, sizeof(Record), TEST_TABLE);
+    TEST_ASSERT_TRUE(insertIntoHashIndex(TEST_INDEX, record.name, id));
+    TEST_ASSERT_TRUE(commitTransaction());
+
+    closeFiles();
+    TEST_ASSERT_EQUAL_INT(1, findInHashIndex(TEST_INDEX, record.name));
+    TEST_ASSERT_EQUAL_INT(1, getNumberOfElements(TEST_TABLE, sizeof(Record)));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_insertIntoHashIndex_should_RejectDuplicates);
+    RUN_TEST(test_removeFromHashIndex_should_AllowReinsert);
+    RUN_TEST(test_replaceInHashIndex_should_MoveKey);
+    RUN_TEST(test_reserveHashIndex_should_GrowIndex);
+    RUN_TEST(test_openHashIndex_should_RebuildFromTable);
+    RUN_TEST(test_transaction_should_RollbackTableAndIndex);
+    return UNITY_END();
+}
@@ -0,0 +1,90 @@
+#include <stdlib.h>
+#include "./../../unity/unity.h"
+#include "./../../unity/unity_internals.h"
+#include "./../../src/utils/intervaltree.h"
+
+IntervalTree tree;
+
+void setUp(void) {
+    tree.root = NULL;
+    tree.size = 0;
+}
+
+void tearDown(void) {
+    freeIntervalTree(&tree);
+}
+
+/**
+ * Verifica a altura de uma subárvore e se os campos height e maxEnd de cada nó estão corretos
+ */
+static int checkNode(const IntervalNode *node, long *maxEnd) {
+    if (node == NULL) return 0;
+
+    long leftMaxEnd = 0, rightMaxEnd = 0;
+    int leftHeight = checkNode(node->left, &leftMaxEnd), rightHeight = checkNode(node->right, &rightMaxEnd);
+
+    TEST_ASSERT_TRUE(abs(leftHeight - rightHeight) <= 1);
+    TEST_ASSERT_EQUAL_INT(1 + (leftHeight > rightHeight ? leftHeight : rightHeight), node->height);
+
+    *maxEnd = node->end;
+    if (node->left != NULL && leftMaxEnd > *maxEnd) *maxEnd = leftMaxEnd;
+    if (node->right != NULL && rightMaxEnd > *maxEnd) *maxEnd = rightMaxEnd;
+    TEST_ASSERT_EQUAL_INT(*maxEnd, node->maxEnd);
+
+    return node->height;
+}
+
+/**
+ * Verifica se a função findOverlap encontra intervalos sobrepostos e aceita intervalos que apenas se encostam
+ */
+void test_findOverlap_should_DetectOverlappingIntervals(void) {
+    insertInterval(&tree, 600, 660, 1);
+    insertInterval(&tree, 720, 780, 2);
+
+    TEST_ASSERT_EQUAL_INT(1, findOverlap(&tree, 630, 700, 0));
+    TEST_ASSERT_EQUAL_INT(2, findOverlap(&tree, 700, 730, 0));
+    TEST_ASSERT_EQUAL_INT(1, findOverlap(&tree, 500, 900, 0));
+    TEST_ASSERT_EQUAL_INT(0, findOverlap(&tree, 660, 720, 0));
+    TEST_ASSERT_EQUAL_INT(0, findOverlap(&tree, 540, 600, 0));
+    TEST_ASSERT_EQUAL_INT(0, findOverlap(&tree, 630, 700, 1));
+}
+
+/**
+ * Verifica se a função removeInterval remove apenas o intervalo do registro informado
+ */
+void test_removeInterval_should_RemoveOnlyTheGivenRecord(void) {
+    insertInterval(&tree, 600, 660, 1);
+    insertInterval(&tree, 600, 630, 2);
+
+    TEST_ASSERT_FALSE(removeInterval(&tree, 600, 3));
+    TEST_ASSERT_TRUE(removeInterval(&tree, 600, 1));
+    TEST_ASSERT_EQUAL_INT(1, tree.size);
+    TEST_ASSERT_EQUAL_INT(0, findOverlap(&tree, 630, 660, 0));
+    TEST_ASSERT_EQUAL_INT(2, findOverlap(&tree, 600, 610, 0));
+}
+
+/**
+ * Verifica se a árvore continua balanceada e com os maiores fins corretos após muitas inserções e remoções
+ */
+void test_insertInterval_should_KeepTreeBalanced(void) {
+    long maxEnd;
+
+    for (int i = 1; i <= 1000; i++) insertInterval(&tree, i * 10L, i * 10L + (i % 7) * 5, i);
+    TEST_ASSERT_EQUAL_INT(1000, tree.size);
+    TEST_ASSERT_TRUE(checkNode(tree.root, &maxEnd) <= 15);
+
+    for (int i = 1; i <= 1000; i += 2) TEST_ASSERT_TRUE(removeInterval(&tree, i * 10L, i));
+    TEST_ASSERT_EQUAL_INT(500, tree.size);
+    TEST_ASSERT_TRUE(checkNode(tree.root, &maxEnd) <= 14);
+
+    TEST_ASSERT_EQUAL_INT(0, findOverlap(&tree, 5015, 5020, 0));
+    TEST_ASSERT_EQUAL_INT(502, findOverlap(&tree, 5025, 5030, 0));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_findOverlap_should_DetectOverlappingIntervals);
+    RUN_TEST(test_removeInterval_should_RemoveOnlyTheGivenRecord);
+    RUN_TEST(test_insertInterval_should_KeepTreeBalanced);
+    return UNITY_END();
+}
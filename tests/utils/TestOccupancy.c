@@ -0,0 +1,98 @@
+#include "./../../unity/unity.h"
+#include "./../../unity/unity_internals.h"
+#include "./../../src/utils/occupancy.h"
+
+#define DAY (24 * 60L)
+
+Occupancy occupancy;
+
+void setUp(void) {
+    occupancy.days = NULL;
+    occupancy.daysNumber = 0;
+    occupancy.daysCapacity = 0;
+}
+
+void tearDown(void) {
+    freeOccupancy(&occupancy);
+}
+
+/**
+ * Verifica se a função getFreeCapacity conta as reservas sobrepostas e ignora as que apenas se encostam
+ */
+void test_getFreeCapacity_should_CountOverlappingReservations(void) {
+    long start = 20000 * DAY + 10 * 60;
+
+    occupySlots(&occupancy, start, start + 60);
+    occupySlots(&occupancy, start + 30, start + 90);
+
+    TEST_ASSERT_EQUAL_INT(3, getFreeCapacity(&occupancy, start - 60, start, 3));
+    TEST_ASSERT_EQUAL_INT(2, getFreeCapacity(&occupancy, start, start + 30, 3));
+    TEST_ASSERT_EQUAL_INT(1, getFreeCapacity(&occupancy, start + 45, start + 50, 3));
+    TEST_ASSERT_EQUAL_INT(1, getFreeCapacity(&occupancy, start - 10, start + 120, 3));
+    TEST_ASSERT_EQUAL_INT(0, getFreeCapacity(&occupancy, start + 45, start + 50, 2));
+    TEST_ASSERT_EQUAL_INT(3, getFreeCapacity(&occupancy, start + DAY, start + DAY + 60, 3));
+}
+
+/**
+ * Verifica se a função releaseSlots devolve apenas as faixas da reserva retirada
+ */
+void test_releaseSlots_should_FreeOnlyTheReleasedReservation(void) {
+    long start = 20000 * DAY + 10 * 60;
+
+    occupySlots(&occupancy, start, start + 60);
+    occupySlots(&occupancy, start + 30, start + 90);
+    releaseSlots(&occupancy, start, start + 60);
+
+    TEST_ASSERT_EQUAL_INT(1, getFreeCapacity(&occupancy, start, start + 30, 1));
+    TEST_ASSERT_EQUAL_INT(0, getFreeCapacity(&occupancy, start + 30, start + 35, 1));
+    TEST_ASSERT_EQUAL_INT(1, getFreeCapacity(&occupancy, start + 45, start + 50, 2));
+}
+
+/**
+ * Verifica se uma reserva que cruza as palavras do mapa de bits ou atravessa a meia-noite ocupa todas as suas faixas
+ */
+void test_occupySlots_should_SpanWordsAndDays(void) {
+    long wordBoundary = 20000 * DAY + 64 * OCCUPANCY_SLOT_MINUTES, midnight = 20001 * DAY;
+
+    occupySlots(&occupancy, wordBoundary - 10, wordBoundary + 10);
+    occupySlots(&occupancy, midnight - 60, midnight + 60);
+
+    TEST_ASSERT_EQUAL_INT(2, occupancy.daysNumber);
+    TEST_ASSERT_EQUAL_INT(0, getFreeCapacity(&occupancy, wordBoundary - 5, wordBoundary, 1));
+    TEST_ASSERT_EQUAL_INT(0, getFreeCapacity(&occupancy, wordBoundary, wordBoundary + 5, 1));
+    TEST_ASSERT_EQUAL_INT(1, getFreeCapacity(&occupancy, wordBoundary + 10, wordBoundary + 15, 1));
+    TEST_ASSERT_EQUAL_INT(0, getFreeCapacity(&occupancy, midnight - 5, midnight, 1));
+    TEST_ASSERT_EQUAL_INT(0, getFreeCapacity(&occupancy, midnight + 55, midnight + 60, 1));
+    TEST_ASSERT_EQUAL_INT(1, getFreeCapacity(&occupancy, midnight + 60, midnight + 65, 1));
+}
+
+/**
+ * Verifica se a função findFreeRuns retorna as primeiras sequências livres, sem sobreposição, dentro da janela
+ */
+void test_findFreeRuns_should_FindEarliestFreeRuns(void) {
+    long day = 20000;
+    int starts[4];
+    uint64_t busy[OCCUPANCY_WORDS];
+
+    occupySlots(&occupancy, day * DAY + 9 * 60, day * DAY + 10 * 60);
+    occupySlots(&occupancy, day * DAY + 10 * 60 + 30, day * DAY + 11 * 60 + 30);
+    getFullSlots(&occupancy, day, 1, busy);
+
+    int found = findFreeRuns(busy, 8 * 12, 12 * 12, 6, starts, 4);
+
+    TEST_ASSERT_EQUAL_INT(4, found);
+    TEST_ASSERT_EQUAL_INT(8 * 12, starts[0]);
+    TEST_ASSERT_EQUAL_INT(8 * 12 + 6, starts[1]);
+    TEST_ASSERT_EQUAL_INT(10 * 12, starts[2]);
+    TEST_ASSERT_EQUAL_INT(11 * 12 + 6, starts[3]);
+    TEST_ASSERT_EQUAL_INT(0, findFreeRuns(busy, 9 * 12, 11 * 12, 7, starts, 4));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_getFreeCapacity_should_CountOverlappingReservations);
+    RUN_TEST(test_releaseSlots_should_FreeOnlyTheReleasedReservation);
+    RUN_TEST(test_occupySlots_should_SpanWordsAndDays);
+    RUN_TEST(test_findFreeRuns_should_FindEarliestFreeRuns);
+    return UNITY_END();
+}
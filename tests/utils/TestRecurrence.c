@@ -0,0 +1,79 @@
+#include "./../../unity/unity.h"
+#include "./../../unity/unity_internals.h"
+#include "./../../src/utils/recurrence.h"
+#include "./../../src/utils/calendar.h"
+
+#define AT(year, month, day, hour, minute) (daysFromCivil(year, month, day) * MINUTES_PER_DAY + (hour) * 60 + (minute))
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+/**
+ * Verifica se uma repetição semanal calcula apenas as ocorrências que se sobrepõem à janela, até a data final
+ */
+void test_expandRecurrence_should_ExpandOnlyTheWindow(void) {
+    Recurrence recurrence = {AT(2024, 1, 1, 9, 0), 60, RECURRENCE_WEEKLY, 2, AT(2024, 12, 31, 9, 0), 0, {0}};
+    long starts[10];
+
+    int found = expandRecurrence(&recurrence, AT(2024, 3, 1, 0, 0), AT(2024, 4, 1, 0, 0), starts, 10);
+    TEST_ASSERT_EQUAL_INT(2, found);
+    TEST_ASSERT_EQUAL_INT(AT(2024, 3, 11, 9, 0), starts[0]);
+    TEST_ASSERT_EQUAL_INT(AT(2024, 3, 25, 9, 0), starts[1]);
+
+    // A ocorrência que começou antes da janela e ainda não terminou também é retornada
+    found = expandRecurrence(&recurrence, AT(2024, 3, 11, 9, 30), AT(2024, 3, 11, 9, 31), starts, 10);
+    TEST_ASSERT_EQUAL_INT(1, found);
+    TEST_ASSERT_EQUAL_INT(AT(2024, 3, 11, 9, 0), starts[0]);
+
+    TEST_ASSERT_EQUAL_INT(0, expandRecurrence(&recurrence, AT(2024, 3, 11, 10, 0), AT(2024, 3, 18, 0, 0), starts, 10));
+    TEST_ASSERT_EQUAL_INT(0, expandRecurrence(&recurrence, AT(2025, 1, 1, 0, 0), AT(2026, 1, 1, 0, 0), starts, 10));
+    TEST_ASSERT_EQUAL_INT(1, expandRecurrence(&recurrence, AT(2024, 12, 30, 0, 0), AT(2025, 1, 1, 0, 0), starts, 10));
+    TEST_ASSERT_EQUAL_INT(3, expandRecurrence(&recurrence, AT(2023, 1, 1, 0, 0), AT(2025, 1, 1, 0, 0), starts, 3));
+}
+
+/**
+ * Verifica se uma repetição mensal pula os meses que não têm o dia da primeira ocorrência
+ */
+void test_expandRecurrence_should_SkipMissingDaysOfMonth(void) {
+    Recurrence recurrence = {AT(2024, 1, 31, 14, 0), 30, RECURRENCE_MONTHLY, 1, AT(2024, 8, 31, 14, 0), 0, {0}};
+    long starts[10];
+
+    int found = expandRecurrence(&recurrence, AT(2024, 1, 1, 0, 0), AT(2025, 1, 1, 0, 0), starts, 10);
+    TEST_ASSERT_EQUAL_INT(5, found);
+    TEST_ASSERT_EQUAL_INT(AT(2024, 1, 31, 14, 0), starts[0]);
+    TEST_ASSERT_EQUAL_INT(AT(2024, 3, 31, 14, 0), starts[1]);
+    TEST_ASSERT_EQUAL_INT(AT(2024, 5, 31, 14, 0), starts[2]);
+    TEST_ASSERT_EQUAL_INT(AT(2024, 7, 31, 14, 0), starts[3]);
+    TEST_ASSERT_EQUAL_INT(AT(2024, 8, 31, 14, 0), starts[4]);
+
+    found = expandRecurrence(&recurrence, AT(2024, 6, 1, 0, 0), AT(2024, 8, 1, 0, 0), starts, 10);
+    TEST_ASSERT_EQUAL_INT(1, found);
+    TEST_ASSERT_EQUAL_INT(AT(2024, 7, 31, 14, 0), starts[0]);
+}
+
+/**
+ * Verifica se as ocorrências canceladas deixam de ser retornadas e se apenas ocorrências podem ser canceladas
+ */
+void test_addRecurrenceException_should_CancelOnlyOccurrences(void) {
+    Recurrence recurrence = {AT(2024, 1, 1, 9, 0), 60, RECURRENCE_WEEKLY, 1, AT(2024, 1, 29, 9, 0), 0, {0}};
+    long starts[10];
+
+    TEST_ASSERT_TRUE(addRecurrenceException(&recurrence, AT(2024, 1, 15, 9, 0)));
+    TEST_ASSERT_FALSE(addRecurrenceException(&recurrence, AT(2024, 1, 15, 9, 0)));
+    TEST_ASSERT_FALSE(addRecurrenceException(&recurrence, AT(2024, 1, 16, 9, 0)));
+    TEST_ASSERT_FALSE(addRecurrenceException(&recurrence, AT(2024, 2, 5, 9, 0)));
+
+    TEST_ASSERT_FALSE(isOccurrence(&recurrence, AT(2024, 1, 15, 9, 0)));
+    TEST_ASSERT_TRUE(isOccurrence(&recurrence, AT(2024, 1, 22, 9, 0)));
+    TEST_ASSERT_EQUAL_INT(4, expandRecurrence(&recurrence, AT(2024, 1, 1, 0, 0), AT(2024, 2, 1, 0, 0), starts, 10));
+    TEST_ASSERT_EQUAL_INT(AT(2024, 1, 22, 9, 0), starts[2]);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_expandRecurrence_should_ExpandOnlyTheWindow);
+    RUN_TEST(test_expandRecurrence_should_SkipMissingDaysOfMonth);
+    RUN_TEST(test_addRecurrenceException_should_CancelOnlyOccurrences);
+    return UNITY_END();
+}
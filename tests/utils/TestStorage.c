@@ -0,0 +1,580 @@
+#include "./../../unity/unity.h"
+#include "./../../unity/unity_internals.h"
+#include "./../../src/utils/storage.h"
+#include <stdio.h>
+#include <string.h>
+#include <stddef.h>
+#include <stdbool.h>
+#ifdef __unix__
+    #include <unistd.h>
+    #include <signal.h>
+    #include <sys/wait.h>
+    #include <sys/resource.h>
+#endif
+
+#define TEST_FILE "test_storage.dat"
+
+typedef struct Record {
+    int id;
+    char name[20];
+    bool isDeleted;
+} Record;
+
+typedef struct WideRecord {
+    int id;
+    char name[40];
+    char notes[40];
+    bool isDeleted;
+} WideRecord;
+
+/**
+ * Converte um WideRecord (layout antigo) em um Record
+ */
+static void convertWideRecord(const void *oldElement, void *newElement) {
+    const WideRecord *wide = (const WideRecord*) oldElement;
+    Record *record = (Record*) newElement;
+
+    record->id = wide->id;
+    memcpy(record->name, wide->name, sizeof(record->name) - 1);
+    record->name[sizeof(record->name) - 1] = '\0';
+    record->isDeleted = wide->isDeleted;
+}
+
+void setUp(void) {
+    closeFiles();
+    remove(TEST_FILE);
+    remove(TEST_FILE STORAGE_FREE_LIST_SUFFIX);
+    remove(TEST_FILE STORAGE_SLOT_INDEX_SUFFIX);
+}
+
+void tearDown(void) {
+    closeFiles();
+    remove(TEST_FILE);
+    remove(TEST_FILE STORAGE_FREE_LIST_SUFFIX);
+    remove(TEST_FILE STORAGE_SLOT_INDEX_SUFFIX);
+}
+
+/**
+ * Verifica se addElementToFile adiciona os registros ao final do arquivo, preservando os anteriores
+ */
+void test_addElementToFile_should_AppendRecords(void) {
+    Record first = {1, "Primeiro", false}, second = {2, "Segundo", false}, records[2];
+
+    TEST_ASSERT_TRUE(addElementToFile(&first, sizeof(Record), TEST_FILE));
+    TEST_ASSERT_TRUE(addElementToFile(&second, sizeof(Record), TEST_FILE));
+    TEST_ASSERT_EQUAL_INT(2, getNumberOfElements(TEST_FILE, sizeof(Record)));
+
+    TEST_ASSERT_TRUE(readFile(records, sizeof(Record), 2, TEST_FILE));
+    TEST_ASSERT_EQUAL_INT(1, records[0].id);
+    TEST_ASSERT_EQUAL_STRING("Primeiro", records[0].name);
+    TEST_ASSERT_EQUAL_INT(2, records[1].id);
+    TEST_ASSERT_EQUAL_STRING("Segundo", records[1].name);
+}
+
+/**
+ * Verifica se updateElementInFile sobrescreve apenas o registro informado
+ */
+void test_updateElementInFile_should_OverwriteOnlyOneRecord(void) {
+    Record first = {1, "Primeiro", false}, second = {2, "Segundo", false}, edited = {2, "Editado", false}, records[2];
+
+    addElementToFile(&first, sizeof(Record), TEST_FILE);
+    addElementToFile(&second, sizeof(Record), TEST_FILE);
+
+    TEST_ASSERT_TRUE(updateElementInFile(&edited, sizeof(Record), 1, TEST_FILE));
+    TEST_ASSERT_EQUAL_INT(2, getNumberOfElements(TEST_FILE, sizeof(Record)));
+
+    readFile(records, sizeof(Record), 2, TEST_FILE);
+    TEST_ASSERT_EQUAL_STRING("Primeiro", records[0].name);
+    TEST_ASSERT_EQUAL_STRING("Editado", records[1].name);
+}
+
+/**
+ * Verifica se updateElementInFile recusa posições fora do arquivo
+ */
+void test_updateElementInFile_should_RejectInvalidIndex(void) {
+    Record first = {1, "Primeiro", false};
+
+    addElementToFile(&first, sizeof(Record), TEST_FILE);
+
+    TEST_ASSERT_FALSE(updateElementInFile(&first, sizeof(Record), 1, TEST_FILE));
+    TEST_ASSERT_FALSE(updateElementInFile(&first, sizeof(Record), -1, TEST_FILE));
+    TEST_ASSERT_EQUAL_INT(1, getNumberOfElements(TEST_FILE, sizeof(Record)));
+}
+
+/**
+ * Verifica se readElementFromFile lê apenas o registro da posição informada
+ */
+void test_readElementFromFile_should_ReadRecordByIndex(void) {
+    Record first = {1, "Primeiro", false}, second = {2, "Segundo", false}, record;
+
+    addElementToFile(&first, sizeof(Record), TEST_FILE);
+    addElementToFile(&second, sizeof(Record), TEST_FILE);
+
+    TEST_ASSERT_TRUE(readElementFromFile(&record, sizeof(Record), 1, TEST_FILE));
+    TEST_ASSERT_EQUAL_INT(2, record.id);
+    TEST_ASSERT_EQUAL_STRING("Segundo", record.name);
+
+    TEST_ASSERT_FALSE(readElementFromFile(&record, sizeof(Record), 2, TEST_FILE));
+    TEST_ASSERT_FALSE(readElementFromFile(&record, sizeof(Record), -1, TEST_FILE));
+}
+
+/**
+ * Verifica se o arquivo mapeado reflete inserções e atualizações feitas depois do mapeamento
+ */
+void test_getMappedElements_should_ReflectWrites(void) {
+    Record first = {1, "Primeiro", false}, second = {2, "Segundo", false}, edited = {1, "Editado", false};
+    int count;
+
+    TEST_ASSERT_TRUE(openFile(TEST_FILE, sizeof(Record), offsetof(Record, id), offsetof(Record, isDeleted)));
+    TEST_ASSERT_NULL(getMappedElements(TEST_FILE, sizeof(Record), &count));
+    TEST_ASSERT_EQUAL_INT(0, count);
+
+    addElementToFile(&first, sizeof(Record), TEST_FILE);
+    addElementToFile(&second, sizeof(Record), TEST_FILE);
+    const Record *records = getMappedElements(TEST_FILE, sizeof(Record), &count);
+    TEST_ASSERT_EQUAL_INT(2, count);
+    TEST_ASSERT_EQUAL_STRING("Segundo", records[1].name);
+
+    updateElementInFile(&edited, sizeof(Record), 0, TEST_FILE);
+    records = getMappedElements(TEST_FILE, sizeof(Record), &count);
+    TEST_ASSERT_EQUAL_STRING("Editado", records[0].name);
+}
+
+/**
+ * Verifica se o cabeçalho mantém a contagem de ativos, excluídos e o próximo ID
+ */
+void test_getFileHeader_should_TrackCounts(void) {
+    Record first = {1, "Primeiro", false}, second = {2, "Segundo", false};
+    FileHeader header;
+
+    openFile(TEST_FILE, sizeof(Record), offsetof(Record, id), offsetof(Record, isDeleted));
+    addElementToFile(&first, sizeof(Record), TEST_FILE);
+    addElementToFile(&second, sizeof(Record), TEST_FILE);
+    second.isDeleted = true;
+    updateElementInFile(&second, sizeof(Record), 1, TEST_FILE);
+
+    TEST_ASSERT_TRUE(getFileHeader(TEST_FILE, sizeof(Record), &header));
+    TEST_ASSERT_EQUAL_UINT(STORAGE_MAGIC, header.magic);
+    TEST_ASSERT_EQUAL_UINT(sizeof(Record), header.recordSize);
+    TEST_ASSERT_EQUAL_INT(1, header.liveCount);
+    TEST_ASSERT_EQUAL_INT(1, header.deletedCount);
+    TEST_ASSERT_EQUAL_INT(3, header.nextId);
+
+    // O cabeçalho persistido deve ser relido igual após fechar a sessão
+    closeFiles();
+    TEST_ASSERT_TRUE(getFileHeader(TEST_FILE, sizeof(Record), &header));
+    TEST_ASSERT_EQUAL_INT(1, header.liveCount);
+    TEST_ASSERT_EQUAL_INT(2, getNumberOfElements(TEST_FILE, sizeof(Record)));
+}
+
+/**
+ * Verifica se um arquivo antigo, sem cabeçalho, é convertido ao ser aberto
+ */
+void test_openFile_should_UpgradeLegacyFile(void) {
+    Record legacy[2] = {{1, "Primeiro", false}, {2, "Segundo", true}}, record;
+    FileHeader header;
+
+    FILE *fp = fopen(TEST_FILE, "wb");
+    fwrite(legacy, sizeof(Record), 2, fp);
+    fclose(fp);
+
+    TEST_ASSERT_TRUE(openFile(TEST_FILE, sizeof(Record), offsetof(Record, id), offsetof(Record, isDeleted)));
+    getFileHeader(TEST_FILE, sizeof(Record), &header);
+    TEST_ASSERT_EQUAL_INT(1, header.liveCount);
+    TEST_ASSERT_EQUAL_INT(1, header.deletedCount);
+
+    TEST_ASSERT_TRUE(readElementFromFile(&record, sizeof(Record), 1, TEST_FILE));
+    TEST_ASSERT_EQUAL_STRING("Segundo", record.name);
+    TEST_ASSERT_TRUE(readElementById(&record, sizeof(Record), 1, TEST_FILE));
+    TEST_ASSERT_EQUAL_STRING("Primeiro", record.name);
+}
+
+/**
+ * Verifica se migrateFile converte os registros de um layout antigo mantendo os IDs e os registros excluídos
+ */
+void test_migrateFile_should_ConvertRecordLayout(void) {
+    WideRecord first = {0, "Primeiro", "Notas", false}, second = {0, "Segundo", "Notas", false};
+    Record record;
+    FileHeader header;
+
+    openFile(TEST_FILE, sizeof(WideRecord), offsetof(WideRecord, id), offsetof(WideRecord, isDeleted));
+    addElementToFile(&first, sizeof(WideRecord), TEST_FILE);
+    addElementToFile(&second, sizeof(WideRecord), TEST_FILE);
+    second.isDeleted = true;
+    updateElementById(&second, sizeof(WideRecord), 2, TEST_FILE);
+    closeFiles();
+
+    TEST_ASSERT_TRUE(migrateFile(TEST_FILE, sizeof(WideRecord), sizeof(Record), convertWideRecord));
+    TEST_ASSERT_TRUE(openFile(TEST_FILE, sizeof(Record), offsetof(Record, id), offsetof(Record, isDeleted)));
+    getFileHeader(TEST_FILE, sizeof(Record), &header);
+    TEST_ASSERT_EQUAL_INT(1, header.liveCount);
+    TEST_ASSERT_EQUAL_INT(1, header.deletedCount);
+    TEST_ASSERT_EQUAL_INT(3, header.nextId);
+
+    TEST_ASSERT_TRUE(readElementById(&record, sizeof(Record), 1, TEST_FILE));
+    TEST_ASSERT_EQUAL_STRING("Primeiro", record.name);
+    TEST_ASSERT_FALSE(readElementById(&record, sizeof(Record), 2, TEST_FILE));
+
+    // Um arquivo já convertido não é alterado novamente
+    closeFiles();
+    TEST_ASSERT_TRUE(migrateFile(TEST_FILE, sizeof(WideRecord), sizeof(Record), convertWideRecord));
+    TEST_ASSERT_TRUE(openFile(TEST_FILE, sizeof(Record), offsetof(Record, id), offsetof(Record, isDeleted)));
+}
+
+/**
+ * Verifica se um arquivo gravado com outro tamanho de registro é recusado
+ */
+void test_openFile_should_RejectLayoutMismatch(void) {
+    Record first = {1, "Primeiro", false};
+
+    addElementToFile(&first, sizeof(Record), TEST_FILE);
+    closeFiles();
+
+    TEST_ASSERT_FALSE(openFile(TEST_FILE, sizeof(Record) + 4, offsetof(Record, id), offsetof(Record, isDeleted)));
+    TEST_ASSERT_EQUAL_INT(-1, getNumberOfElements(TEST_FILE, sizeof(Record) + 4));
+}
+
+/**
+ * Verifica se saveFile substitui o conteúdo do arquivo sem deixar o arquivo temporário para trás
+ */
+void test_saveFile_should_ReplaceContentAtomically(void) {
+    Record first = {1, "Primeiro", false}, records[2] = {{1, "Novo", false}, {2, "Outro", true}}, record;
+    FileHeader header;
+
+    addElementToFile(&first, sizeof(Record), TEST_FILE);
+    openFile(TEST_FILE, sizeof(Record), offsetof(Record, id), offsetof(Record, isDeleted));
+    TEST_ASSERT_TRUE(saveFile(records, sizeof(Record), 2, TEST_FILE));
+
+    getFileHeader(TEST_FILE, sizeof(Record), &header);
+    TEST_ASSERT_EQUAL_INT(1, header.liveCount);
+    TEST_ASSERT_EQUAL_INT(1, header.deletedCount);
+    TEST_ASSERT_TRUE(readElementFromFile(&record, sizeof(Record), 0, TEST_FILE));
+    TEST_ASSERT_EQUAL_STRING("Novo", record.name);
+    TEST_ASSERT_NULL(fopen(TEST_FILE ".tmp", "rb"));
+}
+
+/**
+ * Verifica se os registros recebem IDs estáveis e se a posição de um registro excluído é reaproveitada
+ */
+void test_addElementToFile_should_ReuseDeletedSlot(void) {
+    Record first = {0, "Primeiro", false}, second = {0, "Segundo", false}, third = {0, "Terceiro", false}, record;
+
+    openFile(TEST_FILE, sizeof(Record), offsetof(Record, id), offsetof(Record, isDeleted));
+    TEST_ASSERT_EQUAL_INT(1, addElementToFile(&first, sizeof(Record), TEST_FILE));
+    TEST_ASSERT_EQUAL_INT(2, addElementToFile(&second, sizeof(Record), TEST_FILE));
+
+    TEST_ASSERT_TRUE(readElementById(&record, sizeof(Record), 1, TEST_FILE));
+    record.isDeleted = true;
+    TEST_ASSERT_TRUE(updateElementById(&record, sizeof(Record), 1, TEST_FILE));
+    TEST_ASSERT_FALSE(readElementById(&record, sizeof(Record), 1, TEST_FILE));
+
+    TEST_ASSERT_EQUAL_INT(3, addElementToFile(&third, sizeof(Record), TEST_FILE));
+    TEST_ASSERT_EQUAL_INT(2, getNumberOfElements(TEST_FILE, sizeof(Record)));
+    TEST_ASSERT_TRUE(readElementFromFile(&record, sizeof(Record), 0, TEST_FILE));
+    TEST_ASSERT_EQUAL_INT(3, record.id);
+    TEST_ASSERT_EQUAL_STRING("Terceiro", record.name);
+
+    // A lista de posições livres e os IDs sobrevivem ao fechamento da sessão
+    second.isDeleted = true;
+    closeFiles();
+    openFile(TEST_FILE, sizeof(Record), offsetof(Record, id), offsetof(Record, isDeleted));
+    TEST_ASSERT_TRUE(updateElementById(&second, sizeof(Record), 2, TEST_FILE));
+    closeFiles();
+    openFile(TEST_FILE, sizeof(Record), offsetof(Record, id), offsetof(Record, isDeleted));
+    TEST_ASSERT_EQUAL_INT(4, addElementToFile(&first, sizeof(Record), TEST_FILE));
+    TEST_ASSERT_EQUAL_INT(2, getNumberOfElements(TEST_FILE, sizeof(Record)));
+    TEST_ASSERT_TRUE(readElementById(&record, sizeof(Record), 3, TEST_FILE));
+    TEST_ASSERT_EQUAL_STRING("Terceiro", record.name);
+}
+
+/**
+ * Verifica se a compactação remove os registros excluídos sem alterar os IDs dos demais
+ */
+void test_compactFile_should_KeepIds(void) {
+    Record record = {0, "Registro", false};
+    FileHeader header;
+
+    openFile(TEST_FILE, sizeof(Record), offsetof(Record, id), offsetof(Record, isDeleted));
+    for (int i = 0; i < 5; i++) addElementToFile(&record, sizeof(Record), TEST_FILE);
+    for (int id = 1; id <= 3; id++) {
+        readElementById(&record, sizeof(Record), id, TEST_FILE);
+        record.isDeleted = true;
+        updateElementById(&record, sizeof(Record), id, TEST_FILE);
+    }
+
+    TEST_ASSERT_EQUAL_INT(3, compactFile(TEST_FILE, sizeof(Record)));
+    getFileHeader(TEST_FILE, sizeof(Record), &header);
+    TEST_ASSERT_EQUAL_INT(2, header.liveCount);
+    TEST_ASSERT_EQUAL_INT(0, header.deletedCount);
+    TEST_ASSERT_EQUAL_INT(6, header.nextId);
+    TEST_ASSERT_EQUAL_INT(0, getNumberOfElements(TEST_FILE STORAGE_FREE_LIST_SUFFIX, sizeof(int)));
+
+    TEST_ASSERT_TRUE(readElementById(&record, sizeof(Record), 5, TEST_FILE));
+    TEST_ASSERT_EQUAL_INT(5, record.id);
+    TEST_ASSERT_FALSE(readElementById(&record, sizeof(Record), 2, TEST_FILE));
+
+    record.isDeleted = false;
+    TEST_ASSERT_EQUAL_INT(6, addElementToFile(&record, sizeof(Record), TEST_FILE));
+    TEST_ASSERT_EQUAL_INT(3, getNumberOfElements(TEST_FILE, sizeof(Record)));
+}
+
+/**
+ * Verifica se o índice de posições é persistido entre sessões e reconstruído quando está ausente
+ */
+void test_openFile_should_LoadSlotIndex(void) {
+    Record record = {0, "Registro", false};
+
+    openFile(TEST_FILE, sizeof(Record), offsetof(Record, id), offsetof(Record, isDeleted));
+    for (int i = 0; i < 3; i++) addElementToFile(&record, sizeof(Record), TEST_FILE);
+    record.isDeleted = true;
+    updateElementById(&record, sizeof(Record), 2, TEST_FILE);
+    compactFile(TEST_FILE, sizeof(Record));
+    closeFiles();
+
+    TEST_ASSERT_EQUAL_INT(3, getNumberOfElements(TEST_FILE STORAGE_SLOT_INDEX_SUFFIX, sizeof(int)));
+    closeFiles();
+
+    openFile(TEST_FILE, sizeof(Record), offsetof(Record, id), offsetof(Record, isDeleted));
+    TEST_ASSERT_TRUE(readElementById(&record, sizeof(Record), 3, TEST_FILE));
+    TEST_ASSERT_EQUAL_INT(3, record.id);
+    TEST_ASSERT_FALSE(readElementById(&record, sizeof(Record), 2, TEST_FILE));
+    closeFiles();
+
+    remove(TEST_FILE STORAGE_SLOT_INDEX_SUFFIX);
+    openFile(TEST_FILE, sizeof(Record), offsetof(Record, id), offsetof(Record, isDeleted));
+    TEST_ASSERT_TRUE(readElementById(&record, sizeof(Record), 3, TEST_FILE));
+    TEST_ASSERT_EQUAL_INT(3, getNumberOfElements(TEST_FILE STORAGE_SLOT_INDEX_SUFFIX, sizeof(int)));
+}
+
+/**
+ * Verifica se o cursor percorre, em vários blocos, todos os registros ativos na ordem do arquivo
+ */
+void test_cursor_should_WalkLiveRecordsInChunks(void) {
+    Record record = {0, "Registro", false};
+    const Record *element;
+    Cursor cursor;
+    int count = 0, lastId = 0;
+
+    setDurabilityMode(DURABILITY_NONE, 0, 0);
+    openFile(TEST_FILE, sizeof(Record), offsetof(Record, id), offsetof(Record, isDeleted));
+    for (int i = 0; i < CURSOR_CHUNK_SIZE * 2 + 10; i++) {
+        record.isDeleted = i % 3 == 0;
+        addElementToFile(&record, sizeof(Record), TEST_FILE);
+    }
+    setDurabilityMode(DURABILITY_SYNC, 0, 0);
+
+    TEST_ASSERT_TRUE(openCursor(&cursor, TEST_FILE, sizeof(Record), true));
+    while ((element = nextElement(&cursor)) != NULL) {
+        TEST_ASSERT_FALSE(element->isDeleted);
+        TEST_ASSERT_TRUE(element->id > lastId);
+        TEST_ASSERT_EQUAL_INT(element->id - 1, cursor.index);
+        lastId = element->id;
+        count++;
+    }
+    closeCursor(&cursor);
+    TEST_ASSERT_EQUAL_INT((CURSOR_CHUNK_SIZE * 2 + 10) * 2 / 3, count);
+
+    TEST_ASSERT_TRUE(openCursor(&cursor, TEST_FILE, sizeof(Record), false));
+    for (count = 0; nextElement(&cursor) != NULL; count++);
+    closeCursor(&cursor);
+    TEST_ASSERT_EQUAL_INT(CURSOR_CHUNK_SIZE * 2 + 10, count);
+}
+
+/**
+ * Verifica se o modo de durabilidade é lido corretamente a partir do texto de configuração
+ */
+void test_configureDurability_should_ParseModes(void) {
+    TEST_ASSERT_TRUE(configureDurability("none"));
+    TEST_ASSERT_EQUAL_INT(DURABILITY_NONE, getDurabilityMode());
+    TEST_ASSERT_TRUE(configureDurability("group:20:128"));
+    TEST_ASSERT_EQUAL_INT(DURABILITY_GROUP, getDurabilityMode());
+    TEST_ASSERT_TRUE(configureDurability("group"));
+    TEST_ASSERT_EQUAL_INT(DURABILITY_GROUP, getDurabilityMode());
+    TEST_ASSERT_TRUE(configureDurability(NULL));
+    TEST_ASSERT_EQUAL_INT(DURABILITY_GROUP, getDurabilityMode());
+    TEST_ASSERT_FALSE(configureDurability("grouping"));
+    TEST_ASSERT_FALSE(configureDurability("always"));
+    TEST_ASSERT_TRUE(configureDurability("sync"));
+    TEST_ASSERT_EQUAL_INT(DURABILITY_SYNC, getDurabilityMode());
+}
+
+/**
+ * Verifica se as escritas feitas no modo de commit em grupo são aplicadas normalmente
+ */
+void test_groupCommit_should_KeepWritesVisible(void) {
+    Record record = {0, "Registro", false};
+
+    setDurabilityMode(DURABILITY_GROUP, 1000, 16);
+    for (int i = 0; i < 40; i++) {
+        record.id = i + 1;
+        TEST_ASSERT_TRUE(addElementToFile(&record, sizeof(Record), TEST_FILE));
+    }
+    setDurabilityMode(DURABILITY_SYNC, 0, 0);
+
+    TEST_ASSERT_EQUAL_INT(40, getNumberOfElements(TEST_FILE, sizeof(Record)));
+    TEST_ASSERT_TRUE(readElementFromFile(&record, sizeof(Record), 39, TEST_FILE));
+    TEST_ASSERT_EQUAL_INT(40, record.id);
+}
+
+/**
+ * Retorna o tamanho em disco de um arquivo
+ */
+static long getFileSize(const char *filename) {
+    FILE *fp = fopen(filename, "rb");
+    if (fp == NULL) return 0;
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    fclose(fp);
+    return size;
+}
+
+/**
+ * Verifica se, no modo de commit em grupo, as escritas só chegam ao arquivo de dados depois do fsync do log que as
+ * cobre, continuando visíveis para as leituras enquanto esperam
+ */
+void test_groupCommit_should_HoldDataWritesUntilLogSync(void) {
+    Record record = {0, "Registro", false};
+    long expectedSize = (long) (sizeof(FileHeader) + 3 * sizeof(Record));
+
+    TEST_ASSERT_TRUE(openFile(TEST_FILE, sizeof(Record), offsetof(Record, id), offsetof(Record, isDeleted)));
+    setDurabilityMode(DURABILITY_GROUP, 60000, 1000);
+    for (int i = 0; i < 3; i++) TEST_ASSERT_TRUE(addElementToFile(&record, sizeof(Record), TEST_FILE) > 0);
+
+    TEST_ASSERT_TRUE(getFileSize(TEST_FILE) < expectedSize);
+    TEST_ASSERT_TRUE(readElementById(&record, sizeof(Record), 3, TEST_FILE));
+    TEST_ASSERT_EQUAL_STRING("Registro", record.name);
+
+    TEST_ASSERT_TRUE(syncPendingCommits());
+    TEST_ASSERT_EQUAL_INT(expectedSize, getFileSize(TEST_FILE));
+    setDurabilityMode(DURABILITY_SYNC, 0, 0);
+}
+
+#ifdef __unix__
+
+/**
+ * Verifica se as operações confirmadas no log são reaplicadas após uma falha
+ * 
+ * Um processo filho insere registros e termina sem fechar os arquivos, simulando uma queda do sistema. Em seguida, o
+ * arquivo de dados é truncado, simulando escritas que não chegaram ao disco, e o log deve reconstruí-lo.
+ */
+void test_recoverFromLog_should_ReplayCommittedWrites(void) {
+    Record first = {1, "Primeiro", false}, second = {2, "Segundo", false}, record;
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        addElementToFile(&first, sizeof(Record), TEST_FILE);
+        addElementToFile(&second, sizeof(Record), TEST_FILE);
+        _exit(0);
+    }
+    waitpid(pid, NULL, 0);
+
+    fclose(fopen(TEST_FILE, "wb"));
+
+    TEST_ASSERT_EQUAL_INT(2, getNumberOfElements(TEST_FILE, sizeof(Record)));
+    TEST_ASSERT_TRUE(readElementFromFile(&record, sizeof(Record), 1, TEST_FILE));
+    TEST_ASSERT_EQUAL_STRING("Segundo", record.name);
+}
+
+/**
+ * Verifica se as entradas de um grupo cuja gravação no log falhou no meio são descartadas, em vez de serem reaplicadas
+ * pela recuperação junto com o grupo seguinte
+ * 
+ * Um processo filho limita o tamanho dos arquivos que pode gravar, de modo que apenas a primeira entrada da segunda
+ * inserção caiba no log. Depois de restaurar o limite, ele edita o primeiro registro e termina sem fechar os arquivos.
+ */
+void test_commitWrites_should_DiscardPartialGroupFromLog(void) {
+    Record first = {1, "Primeiro", false}, second = {2, "Segundo", false}, edited = {1, "Editado", false}, record;
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        struct rlimit limit, original;
+        bool status = addElementToFile(&first, sizeof(Record), TEST_FILE) > 0;
+
+        signal(SIGXFSZ, SIG_IGN);
+        getrlimit(RLIMIT_FSIZE, &original);
+        limit = original;
+        limit.rlim_cur = (rlim_t) (getFileSize(STORAGE_LOG_FILE) + 200 + sizeof(Record));
+        status = status && setrlimit(RLIMIT_FSIZE, &limit) == 0;
+        status = status && addElementToFile(&second, sizeof(Record), TEST_FILE) == 0;
+        status = status && setrlimit(RLIMIT_FSIZE, &original) == 0;
+        status = status && updateElementInFile(&edited, sizeof(Record), 0, TEST_FILE);
+        _exit(status ? 0 : 1);
+    }
+    int childStatus = 0;
+    waitpid(pid, &childStatus, 0);
+    TEST_ASSERT_TRUE(WIFEXITED(childStatus) && WEXITSTATUS(childStatus) == 0);
+
+    TEST_ASSERT_EQUAL_INT(1, getNumberOfElements(TEST_FILE, sizeof(Record)));
+    TEST_ASSERT_EQUAL_INT((long) (sizeof(FileHeader) + sizeof(Record)), getFileSize(TEST_FILE));
+    TEST_ASSERT_TRUE(readElementFromFile(&record, sizeof(Record), 0, TEST_FILE));
+    TEST_ASSERT_EQUAL_STRING("Editado", record.name);
+}
+
+/**
+ * Verifica se uma transação cuja confirmação falhou desfaz o cabeçalho alterado em memória, de modo que a inserção
+ * seguinte receba o ID e a posição que a inserção descartada teria recebido
+ * 
+ * Um processo filho limita o tamanho dos arquivos que pode gravar para que o log não aceite a transação.
+ */
+void test_commitTransaction_should_RestoreStateOnFailure(void) {
+    Record first = {0, "Primeiro", false}, second = {0, "Segundo", false}, third = {0, "Terceiro", false}, record;
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        struct rlimit limit, original;
+        bool status = openFile(TEST_FILE, sizeof(Record), offsetof(Record, id), offsetof(Record, isDeleted))
+            && addElementToFile(&first, sizeof(Record), TEST_FILE) == 1;
+
+        signal(SIGXFSZ, SIG_IGN);
+        getrlimit(RLIMIT_FSIZE, &original);
+        limit = original;
+        limit.rlim_cur = (rlim_t) getFileSize(STORAGE_LOG_FILE) + 16;
+        beginTransaction();
+        status = status && addElementToFile(&second, sizeof(Record), TEST_FILE) == 2;
+        status = status && setrlimit(RLIMIT_FSIZE, &limit) == 0 && !commitTransaction();
+        rollbackTransaction();
+        status = status && setrlimit(RLIMIT_FSIZE, &original) == 0;
+
+        status = status && addElementToFile(&third, sizeof(Record), TEST_FILE) == 2;
+        status = status && getNumberOfElements(TEST_FILE, sizeof(Record)) == 2;
+        closeFiles();
+        _exit(status ? 0 : 1);
+    }
+    int childStatus = 0;
+    waitpid(pid, &childStatus, 0);
+    TEST_ASSERT_TRUE(WIFEXITED(childStatus) && WEXITSTATUS(childStatus) == 0);
+
+    TEST_ASSERT_TRUE(openFile(TEST_FILE, sizeof(Record), offsetof(Record, id), offsetof(Record, isDeleted)));
+    TEST_ASSERT_EQUAL_INT(2, getNumberOfElements(TEST_FILE, sizeof(Record)));
+    TEST_ASSERT_TRUE(readElementById(&record, sizeof(Record), 2, TEST_FILE));
+    TEST_ASSERT_EQUAL_STRING("Terceiro", record.name);
+}
+
+#endif
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_addElementToFile_should_AppendRecords);
+    RUN_TEST(test_updateElementInFile_should_OverwriteOnlyOneRecord);
+    RUN_TEST(test_updateElementInFile_should_RejectInvalidIndex);
+    RUN_TEST(test_readElementFromFile_should_ReadRecordByIndex);
+    RUN_TEST(test_getMappedElements_should_ReflectWrites);
+    RUN_TEST(test_getFileHeader_should_TrackCounts);
+    RUN_TEST(test_openFile_should_UpgradeLegacyFile);
+    RUN_TEST(test_openFile_should_RejectLayoutMismatch);
+    RUN_TEST(test_migrateFile_should_ConvertRecordLayout);
+    RUN_TEST(test_saveFile_should_ReplaceContentAtomically);
+    RUN_TEST(test_addElementToFile_should_ReuseDeletedSlot);
+    RUN_TEST(test_compactFile_should_KeepIds);
+    RUN_TEST(test_openFile_should_LoadSlotIndex);
+    RUN_TEST(test_cursor_should_WalkLiveRecordsInChunks);
+    RUN_TEST(test_configureDurability_should_ParseModes);
+    RUN_TEST(test_groupCommit_should_KeepWritesVisible);
+    RUN_TEST(test_groupCommit_should_HoldDataWritesUntilLogSync);
+    #ifdef __unix__
+        RUN_TEST(test_recoverFromLog_should_ReplayCommittedWrites);
+        RUN_TEST(test_commitWrites_should_DiscardPartialGroupFromLog);
+        RUN_TEST(test_commitTransaction_should_RestoreStateOnFailure);
+    #endif
+    return UNITY_END();
+}
@@ -125,6 +125,23 @@ void test_hasInvalidSpaces_function(void) {
     TEST_ASSERT_FALSE(hasInvalidSpaces("Teste"));
 }
 
+/**
+ * Testa a normalização de textos para busca, sem acentos, em minúsculas e com um único espaço entre as palavras
+ * 
+ * Authors:
+ *  - https://github.com/akemi-adam
+ */
+void test_foldText_function(void) {
+    char folded[64];
+
+    foldText("  João  da Conceição-Araújo ", folded, 64);
+    TEST_ASSERT_EQUAL_STRING("joao da conceicao araujo", folded);
+    foldText("ÂNGELA MÜLLER nº 42", folded, 64);
+    TEST_ASSERT_EQUAL_STRING("angela muller n 42", folded);
+    foldText("Sebastião", folded, 6);
+    TEST_ASSERT_EQUAL_STRING("sebas", folded);
+}
+
 
 int main(void) {
     UNITY_BEGIN();
@@ -138,6 +155,7 @@ int main(void) {
     RUN_TEST(test_parseDouble_should_convert_valid_string_to_double);
     RUN_TEST(test_parseDouble_should_return_false_for_invalid_string);
     RUN_TEST(test_hasInvalidSpaces_function);
+    RUN_TEST(test_foldText_function);
     
     return UNITY_END();
 }
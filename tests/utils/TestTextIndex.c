@@ -0,0 +1,91 @@
+#define TEST_TABLE "test_textindex_table.dat"
+#define TEST_INDEX "test_textindex.idx"
+
+#include "./TableFixture.h"
+#include "./../../src/utils/bptree.h"
+#include "./../../src/utils/textindex.h"
+
+static int getRecordKeys(const void *element, BPlusKey *keys) {
+    const Record *record = (const Record*) element;
+    return getTokenKeys(record->name, record->id, keys);
+}
+
+static int search(const char *query, int *ids) {
+    return searchTokenIndex(TEST_INDEX, TEST_TABLE, sizeof(Record), offsetof(Record, name), query, ids, 10, NULL);
+}
+
+/**
+ * Cadastra os endereços na tabela e monta o índice a partir dela
+ */
+void setUp(void) {
+    openTestTable();
+    addRecord("Rua São José, 120 - Tirol, Natal/RN");
+    addRecord("Av. Rio Branco, 45 - Centro, Natal/RN");
+    addRecord("Rua Jose de Alencar, 12 - Centro, Mossoró/RN");
+    TEST_ASSERT_TRUE(openMultiKeyBPlusTree(TEST_INDEX, TEST_TABLE, sizeof(Record), getRecordKeys, TEXTINDEX_MAX_KEYS));
+}
+
+void tearDown(void) {
+    closeTestTable();
+}
+
+/**
+ * Verifica se a busca retorna apenas os endereços com todas as palavras, em qualquer ordem, ignorando acentos,
+ * maiúsculas, pontuação e palavras repetidas na consulta
+ */
+void test_searchTokenIndex_should_MatchAllTerms(void) {
+    int ids[10];
+
+    TEST_ASSERT_EQUAL_INT(2, search("natal", ids));
+    TEST_ASSERT_EQUAL_INT(1, ids[0]);
+    TEST_ASSERT_EQUAL_INT(2, ids[1]);
+
+    TEST_ASSERT_EQUAL_INT(1, search("CENTRO natal", ids));
+    TEST_ASSERT_EQUAL_INT(2, ids[0]);
+    TEST_ASSERT_EQUAL_INT(2, search("josé rua", ids));
+    TEST_ASSERT_EQUAL_INT(1, search("mossoro, centro, centro", ids));
+    TEST_ASSERT_EQUAL_INT(3, ids[0]);
+
+    TEST_ASSERT_EQUAL_INT(0, search("natal mossoro", ids));
+    TEST_ASSERT_EQUAL_INT(0, search("nat", ids));
+    TEST_ASSERT_EQUAL_INT(-1, search(" - ", ids));
+}
+
+/**
+ * Verifica se, após a troca de endereço, as palavras que saíram deixam de encontrar o registro e as que continuaram
+ * no endereço ainda o encontram
+ */
+void test_replaceTokens_should_KeepSharedWords(void) {
+    Record record = {.id = 2, .name = "Av. Hermes da Fonseca, 45 - Tirol, Natal/RN"};
+    int ids[10];
+
+    TEST_ASSERT_TRUE(updateElementById(&record, sizeof(Record), 2, TEST_TABLE));
+    TEST_ASSERT_TRUE(replaceTokens(TEST_INDEX, "Av. Rio Branco, 45 - Centro, Natal/RN", record.name, 2, false));
+    TEST_ASSERT_EQUAL_INT(0, search("branco", ids));
+    TEST_ASSERT_EQUAL_INT(1, search("centro", ids));
+    TEST_ASSERT_EQUAL_INT(2, search("tirol natal", ids));
+    TEST_ASSERT_EQUAL_INT(1, search("45 fonseca", ids));
+}
+
+/**
+ * Verifica se a busca indica que havia mais resultados apenas quando algum ficou de fora, e não quando o número de
+ * resultados é exatamente o máximo
+ */
+void test_searchTokenIndex_should_ReportTruncation(void) {
+    int ids[10];
+    bool isTruncated = false;
+
+    TEST_ASSERT_EQUAL_INT(1, searchTokenIndex(TEST_INDEX, TEST_TABLE, sizeof(Record), offsetof(Record, name), "natal", ids, 1, &isTruncated));
+    TEST_ASSERT_TRUE(isTruncated);
+    TEST_ASSERT_EQUAL_INT(1, ids[0]);
+    TEST_ASSERT_EQUAL_INT(2, searchTokenIndex(TEST_INDEX, TEST_TABLE, sizeof(Record), offsetof(Record, name), "natal", ids, 2, &isTruncated));
+    TEST_ASSERT_FALSE(isTruncated);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_searchTokenIndex_should_MatchAllTerms);
+    RUN_TEST(test_replaceTokens_should_KeepSharedWords);
+    RUN_TEST(test_searchTokenIndex_should_ReportTruncation);
+    return UNITY_END();
+}
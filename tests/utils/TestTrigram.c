@@ -0,0 +1,120 @@
+#define TEST_TABLE "test_trigram_table.dat"
+#define TEST_INDEX "test_trigram.idx"
+
+#include "./TableFixture.h"
+#include "./../../src/utils/bptree.h"
+#include "./../../src/utils/trigram.h"
+
+static int getRecordKeys(const void *element, BPlusKey *keys) {
+    const Record *record = (const Record*) element;
+    return getTrigramKeys(record->name, record->id, keys);
+}
+
+/**
+ * Cadastra um registro na tabela e o seu nome no índice
+ */
+static int addIndexedRecord(const char *name) {
+    int id = addRecord(name);
+    TEST_ASSERT_TRUE(insertTrigrams(TEST_INDEX, name, id));
+    return id;
+}
+
+static int search(const char *query, int *ids) {
+    return searchTrigramIndex(TEST_INDEX, TEST_TABLE, sizeof(Record), offsetof(Record, name), query, ids, 10, NULL);
+}
+
+void setUp(void) {
+    openTestTable();
+    TEST_ASSERT_TRUE(openMultiKeyBPlusTree(TEST_INDEX, TEST_TABLE, sizeof(Record), getRecordKeys, TRIGRAM_MAX_KEYS));
+}
+
+void tearDown(void) {
+    closeTestTable();
+}
+
+/**
+ * Verifica se a busca ignora acentos e maiúsculas e se os nomes que começam com a consulta vêm antes dos que apenas
+ * têm uma palavra que começa com ela
+ */
+void test_searchTrigramIndex_should_FoldAccentsAndRankPrefixes(void) {
+    int ana = addIndexedRecord("Ana Maria Souza"), mariana = addIndexedRecord("Mariana Lima"), jose = addIndexedRecord("José Mário"),
+        joao = addIndexedRecord("João Rosário"), ids[10];
+
+    TEST_ASSERT_EQUAL_INT(3, search("MARI", ids));
+    TEST_ASSERT_EQUAL_INT(mariana, ids[0]);
+    TEST_ASSERT_EQUAL_INT(ana, ids[1]);
+    TEST_ASSERT_EQUAL_INT(jose, ids[2]);
+
+    TEST_ASSERT_EQUAL_INT(1, search("rosario", ids));
+    TEST_ASSERT_EQUAL_INT(joao, ids[0]);
+    TEST_ASSERT_EQUAL_INT(2, search("ário", ids));
+    TEST_ASSERT_EQUAL_INT(0, search("souza lima", ids));
+}
+
+/**
+ * Verifica se consultas de 2 letras encontram apenas inícios de palavra e se consultas menores são recusadas
+ */
+void test_searchTrigramIndex_should_MatchWordStartsForShortQueries(void) {
+    int joao = addIndexedRecord("João Rosário"), jose = addIndexedRecord("José Mário"), ids[10];
+    addIndexedRecord("Ana Maria Souza");
+
+    TEST_ASSERT_EQUAL_INT(2, search("Jo", ids));
+    TEST_ASSERT_EQUAL_INT(joao, ids[0]);
+    TEST_ASSERT_EQUAL_INT(jose, ids[1]);
+    TEST_ASSERT_EQUAL_INT(0, search("ar", ids));
+    TEST_ASSERT_EQUAL_INT(-1, search("J", ids));
+}
+
+/**
+ * Verifica se nomes que começam com a consulta, cadastrados depois de mais de mil nomes que só a contêm no meio de uma
+ * palavra, ainda vêm primeiro nos resultados
+ */
+void test_searchTrigramIndex_should_RankWordStartsAfterManyMidWordMatches(void) {
+    int ids[10];
+    bool isTruncated = true;
+
+    for (int i = 0; i < 1100; i++) addIndexedRecord("Rosa Amaria");
+    int maria = addIndexedRecord("Maria Souza"), ana = addIndexedRecord("Ana Mariana");
+
+    TEST_ASSERT_EQUAL_INT(10, searchTrigramIndex(TEST_INDEX, TEST_TABLE, sizeof(Record), offsetof(Record, name), "mari",
+        ids, 10, &isTruncated));
+    TEST_ASSERT_FALSE(isTruncated);
+    TEST_ASSERT_EQUAL_INT(maria, ids[0]);
+    TEST_ASSERT_EQUAL_INT(ana, ids[1]);
+    TEST_ASSERT_EQUAL_INT(1, ids[2]);
+}
+
+/**
+ * Verifica se a troca de nome e a exclusão atualizam o índice e se o índice é recriado a partir da tabela
+ */
+void test_replaceTrigrams_should_UpdateIndex(void) {
+    int id = addIndexedRecord("Carlos Pereira"), ids[10];
+    Record record;
+
+    TEST_ASSERT_TRUE(readElementById(&record, sizeof(Record), id, TEST_TABLE));
+    strcpy(record.name, "Carla Pereira");
+    TEST_ASSERT_TRUE(updateElementById(&record, sizeof(Record), id, TEST_TABLE));
+    TEST_ASSERT_TRUE(replaceTrigrams(TEST_INDEX, "Carlos Pereira", record.name, id, false));
+    TEST_ASSERT_EQUAL_INT(0, search("carlos", ids));
+    TEST_ASSERT_EQUAL_INT(1, search("carla", ids));
+
+    for (int i = 0; i < 200; i++) addIndexedRecord(i % 2 == 0 ? "Pedro Pereira" : "Paula Ferreira");
+    closeFiles();
+    remove(TEST_INDEX);
+    TEST_ASSERT_TRUE(openFile(TEST_TABLE, sizeof(Record), offsetof(Record, id), offsetof(Record, isDeleted)));
+    TEST_ASSERT_TRUE(openMultiKeyBPlusTree(TEST_INDEX, TEST_TABLE, sizeof(Record), getRecordKeys, TRIGRAM_MAX_KEYS));
+    TEST_ASSERT_EQUAL_INT(10, search("pereira", ids));
+    TEST_ASSERT_EQUAL_INT(id, ids[0]);
+
+    TEST_ASSERT_TRUE(replaceTrigrams(TEST_INDEX, record.name, record.name, id, true));
+    TEST_ASSERT_EQUAL_INT(0, search("carla", ids));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_searchTrigramIndex_should_FoldAccentsAndRankPrefixes);
+    RUN_TEST(test_searchTrigramIndex_should_MatchWordStartsForShortQueries);
+    RUN_TEST(test_searchTrigramIndex_should_RankWordStartsAfterManyMidWordMatches);
+    RUN_TEST(test_replaceTrigrams_should_UpdateIndex);
+    return UNITY_END();
+}